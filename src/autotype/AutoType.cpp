@@ -20,6 +20,7 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QPluginLoader>
 #include <QRegularExpression>
 #include <QUrl>
@@ -318,40 +319,62 @@ void AutoType::executeAutoTypeActions(const Entry* entry,
         window = m_plugin->activeWindow();
     }
 
+    m_executor->prepareSequence(actions);
+
+    // The target window is checked before every action. Only the wait for the
+    // platform to process queued key events is batched, for at most MaxChunkMs.
+    constexpr qint64 MaxChunkMs = 50;
+    QElapsedTimer chunkTimer;
+    m_executor->beginChunk();
+    chunkTimer.start();
+
+    bool failed = false;
     for (const auto& action : asConst(actions)) {
+        if (!action.dynamicCast<AutoTypeKey>() || chunkTimer.hasExpired(MaxChunkMs)) {
+            m_executor->endChunk();
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            m_executor->beginChunk();
+            chunkTimer.restart();
+        }
+
         // Cancel Auto-Type if the active window changed
         if (m_plugin->activeWindow() != window) {
             qWarning("Active window changed, interrupting auto-type.");
             break;
         }
 
-        bool failed = false;
         constexpr int max_retries = 5;
         for (int i = 1; i <= max_retries; i++) {
             auto result = action->exec(m_executor);
-
-            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
-
             if (result.isOk()) {
                 break;
             }
 
             if (!result.canRetry() || i == max_retries) {
-                if (getMainWindow()) {
-                    MessageBox::critical(getMainWindow(), tr("Auto-Type Error"), result.errorString());
-                }
+                error = result.errorString();
                 failed = true;
                 break;
             }
 
+            // Let the platform pick up the current keyboard state before retrying
+            m_executor->endChunk();
             Tools::wait(delay);
+            m_executor->beginChunk();
+            chunkTimer.restart();
         }
 
-        // Last action failed to complete, cancel the rest of the sequence
         if (failed) {
             break;
         }
     }
+    m_executor->endChunk();
+
+    // Last action failed to complete, the rest of the sequence was cancelled
+    if (failed && getMainWindow()) {
+        MessageBox::critical(getMainWindow(), tr("Auto-Type Error"), error);
+    }
+
+    m_executor->finishSequence();
 
     resetAutoTypeState();
     m_inAutoType.unlock();
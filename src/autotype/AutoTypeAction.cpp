@@ -66,6 +66,35 @@ AutoTypeAction::Result AutoTypeBegin::exec(AutoTypeExecutor* executor) const
     return executor->execBegin(this);
 }
 
+/**
+ * Called with the complete sequence before its first action is executed.
+ * Platforms can use this to prepare keyboard state once for all actions.
+ */
+void AutoTypeExecutor::prepareSequence(const QList<QSharedPointer<AutoTypeAction>>& actions)
+{
+    Q_UNUSED(actions);
+}
+
+/**
+ * Called after the last action of a sequence, even if the sequence was interrupted.
+ */
+void AutoTypeExecutor::finishSequence()
+{
+}
+
+/**
+ * Called before a short run of consecutive actions. The target window is
+ * still checked before every action, but platforms may queue the events of
+ * the chunk and only wait for them to be processed in endChunk().
+ */
+void AutoTypeExecutor::beginChunk()
+{
+}
+
+void AutoTypeExecutor::endChunk()
+{
+}
+
 AutoTypeMode::AutoTypeMode(AutoTypeExecutor::Mode mode)
     : mode(mode)
 {
@@ -19,6 +19,9 @@
 #ifndef KEEPASSX_AUTOTYPEACTION_H
 #define KEEPASSX_AUTOTYPEACTION_H
 
+#include <QList>
+#include <QSharedPointer>
+
 #include "core/Global.h"
 
 class AutoTypeExecutor;
@@ -131,6 +134,10 @@ public:
     virtual AutoTypeAction::Result execBegin(const AutoTypeBegin* action) = 0;
     virtual AutoTypeAction::Result execType(const AutoTypeKey* action) = 0;
     virtual AutoTypeAction::Result execClearField(const AutoTypeClearField* action) = 0;
+    virtual void prepareSequence(const QList<QSharedPointer<AutoTypeAction>>& actions);
+    virtual void finishSequence();
+    virtual void beginChunk();
+    virtual void endChunk();
 
     int execDelayMs = 25;
     Mode mode = Mode::NORMAL;
@@ -34,7 +34,7 @@ QStringList AutoTypePlatformTest::windowTitles()
 
 WId AutoTypePlatformTest::activeWindow()
 {
-    return 0;
+    return m_activeWindowChangeAfter >= 0 && m_actionCount >= m_activeWindowChangeAfter ? 1 : 0;
 }
 
 QString AutoTypePlatformTest::activeWindowTitle()
@@ -52,6 +52,11 @@ void AutoTypePlatformTest::setActiveWindowTitle(const QString& title)
     m_activeWindowTitle = title;
 }
 
+void AutoTypePlatformTest::setActiveWindowChangeAfter(int actionCount)
+{
+    m_activeWindowChangeAfter = actionCount;
+}
+
 QString AutoTypePlatformTest::actionChars()
 {
     return m_actionChars;
@@ -66,6 +71,7 @@ void AutoTypePlatformTest::clearActions()
 {
     m_actionChars.clear();
     m_actionCount = 0;
+    m_activeWindowChangeAfter = -1;
 }
 
 void AutoTypePlatformTest::addAction(const AutoTypeKey* action)
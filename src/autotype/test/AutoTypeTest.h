@@ -45,6 +45,7 @@ public:
 #endif
 
     void setActiveWindowTitle(const QString& title) override;
+    void setActiveWindowChangeAfter(int actionCount) override;
 
     QString actionChars() override;
     int actionCount() override;
@@ -54,6 +55,7 @@ public:
 
 private:
     QString m_activeWindowTitle;
+    int m_activeWindowChangeAfter = -1;
     int m_actionCount = 0;
     QString m_actionChars;
 };
@@ -25,6 +25,8 @@ class AutoTypeTestInterface
 public:
     virtual ~AutoTypeTestInterface() = default;
     virtual void setActiveWindowTitle(const QString& title) = 0;
+    // Another window becomes active once the given number of keys has been typed, negative for never
+    virtual void setActiveWindowChangeAfter(int actionCount) = 0;
 
     virtual QString actionChars() = 0;
     virtual int actionCount() = 0;
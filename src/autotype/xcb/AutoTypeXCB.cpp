@@ -35,6 +35,9 @@ static const QPair<KeySym, KeySym> deadMap[] = {
     {XK_asciitilde, XK_dead_perispomeni},
 };
 
+/* number of spare keycodes reserved for keysyms missing from the layout */
+static const int MaxRemapKeycodes = 10;
+
 AutoTypePlatformX11::AutoTypePlatformX11()
 {
     // Qt handles XCB slightly differently so we open our own connection
@@ -57,6 +60,12 @@ AutoTypePlatformX11::AutoTypePlatformX11()
     m_classBlacklist << "xfdesktop" << "xfce4-panel"; // Xfce 4
 
     m_xkb = nullptr;
+    m_nextRemapKeycode = 0;
+    m_batching = false;
+    m_batchStateValid = false;
+    m_batchGroup = 0;
+    m_batchMask = 0;
+    m_batchErrorHandler = nullptr;
 
     m_loaded = true;
 }
@@ -79,6 +88,8 @@ bool AutoTypePlatformX11::isAvailable()
 void AutoTypePlatformX11::unload()
 {
     m_keymap.clear();
+    m_remapKeycodes.clear();
+    m_remappedKeysyms.clear();
 
     if (m_xkb) {
         XkbFreeKeyboard(m_xkb, XkbAllComponentsMask, True);
@@ -307,14 +318,16 @@ void AutoTypePlatformX11::updateKeymap()
 
     /* Build updated keymap */
     m_keymap.clear();
-    m_remapKeycode = 0;
+    m_remapKeycodes.clear();
+    m_remappedKeysyms.clear();
+    m_nextRemapKeycode = 0;
 
     for (int ckeycode = m_xkb->min_key_code; ckeycode < m_xkb->max_key_code; ckeycode++) {
         int groups = XkbKeyNumGroups(m_xkb, ckeycode);
 
-        /* track highest remappable keycode, don't add to keymap */
+        /* track remappable keycodes, don't add to keymap */
         if (groups == 0) {
-            m_remapKeycode = ckeycode;
+            m_remapKeycodes.append(ckeycode);
             continue;
         }
 
@@ -343,6 +356,11 @@ void AutoTypePlatformX11::updateKeymap()
         }
     }
 
+    /* keep a pool of the highest remappable keycodes */
+    if (m_remapKeycodes.size() > MaxRemapKeycodes) {
+        m_remapKeycodes.remove(0, m_remapKeycodes.size() - MaxRemapKeycodes);
+    }
+
     /* determine the keycode to use for modifiers */
     XModifierKeymap* modifiers = XGetModifierMapping(m_dpy);
     for (int mod_index = ShiftMapIndex; mod_index <= Mod5MapIndex; mod_index++) {
@@ -358,6 +376,74 @@ void AutoTypePlatformX11::updateKeymap()
     XFreeModifiermap(modifiers);
 }
 
+/*
+ * Map keysyms of an upcoming sequence which are missing from the layout to
+ * spare keycodes, so the keyboard mapping is only changed once up front.
+ */
+void AutoTypePlatformX11::reserveKeysyms(const QList<KeySym>& keysyms)
+{
+    QList<KeySym> missing;
+    for (KeySym keysym : keysyms) {
+        bool isDead;
+        if (keysym != NoSymbol && !missing.contains(keysym) && !FindKeyDesc(keysym, 0, &isDead)) {
+            missing.append(keysym);
+            if (missing.size() == m_remapKeycodes.size()) {
+                break;
+            }
+        }
+    }
+
+    if (!missing.isEmpty()) {
+        RemapKeycodes(missing);
+    }
+}
+
+/*
+ * Restore all remapped keycodes to their unmapped state.
+ */
+void AutoTypePlatformX11::restoreKeymap()
+{
+    if (!m_xkb || m_remappedKeysyms.isEmpty()) {
+        return;
+    }
+
+    for (KeyCode keycode : asConst(m_remappedKeysyms)) {
+        XkbChangeTypesOfKey(m_xkb, keycode, 0, XkbGroup1Mask, NULL, NULL);
+    }
+    m_remappedKeysyms.clear();
+    m_nextRemapKeycode = 0;
+
+    XkbSetMap(m_dpy, XkbAllClientInfoMask, m_xkb);
+    XSync(m_dpy, False);
+}
+
+/*
+ * Start queueing key events. The keyboard state is queried once for the
+ * whole batch and the server is only waited for in endBatch().
+ */
+void AutoTypePlatformX11::beginBatch()
+{
+    if (m_batching) {
+        return;
+    }
+
+    m_batching = true;
+    m_batchStateValid = false;
+    m_batchErrorHandler = XSetErrorHandler(MyErrorHandler);
+}
+
+void AutoTypePlatformX11::endBatch()
+{
+    if (!m_batching) {
+        return;
+    }
+
+    XSync(m_dpy, False);
+    XSetErrorHandler(m_batchErrorHandler);
+    m_batchErrorHandler = nullptr;
+    m_batching = false;
+}
+
 // --------------------------------------------------------------------------
 // The following code is taken from xvkbd 3.0 and has been slightly modified.
 // --------------------------------------------------------------------------
@@ -369,14 +455,8 @@ void AutoTypePlatformX11::updateKeymap()
  */
 void AutoTypePlatformX11::SendKeyEvent(unsigned keycode, bool press)
 {
-    XSync(m_dpy, False);
-    int (*oldHandler)(Display*, XErrorEvent*) = XSetErrorHandler(MyErrorHandler);
-
+    /* events are only queued here, sendKey() syncs once per key */
     XTestFakeKeyEvent(m_dpy, keycode, press, 0);
-    XFlush(m_dpy);
-    XSync(m_dpy, False);
-
-    XSetErrorHandler(oldHandler);
 }
 
 /*
@@ -394,18 +474,18 @@ void AutoTypePlatformX11::SendModifiers(unsigned int mask, bool press)
 }
 
 /*
- * Determines the keycode and modifier mask for the given
- * keysym.
+ * Find the best key description for the given keysym in the
+ * current layout, preferring the given group.
  */
-bool AutoTypePlatformX11::GetKeycode(KeySym keysym, int* keycode, int* group, unsigned int* mask, bool* repeat)
+const AutoTypePlatformX11::KeyDesc* AutoTypePlatformX11::FindKeyDesc(KeySym keysym, int group, bool* isDead) const
 {
     const KeyDesc* desc = nullptr;
-    bool isDead = false;
+    *isDead = false;
 
     for (const auto& key : m_keymap) {
         if (key.sym == keysym) {
             // pick this description if we don't have any for this sym or this matches the current group
-            if (desc == nullptr || key.group == *group) {
+            if (desc == nullptr || key.group == group) {
                 desc = &key;
             }
         }
@@ -418,9 +498,9 @@ bool AutoTypePlatformX11::GetKeycode(KeySym keysym, int* keycode, int* group, un
                 for (const auto& key : m_keymap) {
                     if (key.sym == map.second) {
                         // same as above, we try to match the group so no breaking out
-                        if (desc == nullptr || key.group == *group) {
+                        if (desc == nullptr || key.group == group) {
                             desc = &key;
-                            isDead = true;
+                            *isDead = true;
                         }
                     }
                 }
@@ -428,6 +508,18 @@ bool AutoTypePlatformX11::GetKeycode(KeySym keysym, int* keycode, int* group, un
         }
     }
 
+    return desc;
+}
+
+/*
+ * Determines the keycode and modifier mask for the given
+ * keysym.
+ */
+bool AutoTypePlatformX11::GetKeycode(KeySym keysym, int* keycode, int* group, unsigned int* mask, bool* repeat)
+{
+    bool isDead;
+    const KeyDesc* desc = FindKeyDesc(keysym, *group, &isDead);
+
     if (desc) {
         *keycode = desc->code;
         *group = desc->group;
@@ -437,8 +529,8 @@ bool AutoTypePlatformX11::GetKeycode(KeySym keysym, int* keycode, int* group, un
     }
 
     /* if we can't find an existing key for this keysym, try remapping */
-    if (RemapKeycode(keysym)) {
-        *keycode = m_remapKeycode;
+    if (RemapKeycodes({keysym})) {
+        *keycode = m_remappedKeysyms.value(keysym);
         *group = 0;
         *mask = 0;
         *repeat = false;
@@ -449,28 +541,46 @@ bool AutoTypePlatformX11::GetKeycode(KeySym keysym, int* keycode, int* group, un
 }
 
 /*
- * Get remapped keycode for any keysym.
+ * Assign spare keycodes to the given keysyms, reusing existing
+ * assignments. Once all spare keycodes are in use the oldest
+ * assignment is recycled. All changes are sent at once.
  */
-bool AutoTypePlatformX11::RemapKeycode(KeySym keysym)
+bool AutoTypePlatformX11::RemapKeycodes(const QList<KeySym>& keysyms)
 {
-    if (!m_remapKeycode) {
+    if (m_remapKeycodes.isEmpty()) {
         return false;
     }
 
-    if (keysym != NoSymbol) {
+    bool changed = false;
+    for (KeySym keysym : keysyms) {
+        if (keysym == NoSymbol || m_remappedKeysyms.contains(keysym)) {
+            continue;
+        }
+
+        KeyCode keycode = m_remapKeycodes.at(m_nextRemapKeycode);
+        m_nextRemapKeycode = (m_nextRemapKeycode + 1) % m_remapKeycodes.size();
+
+        /* events typed with the old keysym may still be queued, let the server
+         * process them before the keycode changes its meaning */
+        const KeySym previous = m_remappedKeysyms.key(keycode, NoSymbol);
+        if (previous != NoSymbol) {
+            XSync(m_dpy, False);
+            m_remappedKeysyms.remove(previous);
+        }
+
         int type = XkbOneLevelIndex;
-        if (XkbChangeTypesOfKey(m_xkb, m_remapKeycode, 1, XkbGroup1Mask, &type, NULL) != Success) {
+        if (XkbChangeTypesOfKey(m_xkb, keycode, 1, XkbGroup1Mask, &type, NULL) != Success) {
             return false;
         }
-
-        XkbKeySymEntry(m_xkb, m_remapKeycode, 0, 0) = keysym;
-    } else {
-        XkbChangeTypesOfKey(m_xkb, m_remapKeycode, 0, XkbGroup1Mask, NULL, NULL);
+        XkbKeySymEntry(m_xkb, keycode, 0, 0) = keysym;
+        m_remappedKeysyms.insert(keysym, keycode);
+        changed = true;
     }
 
-    XkbSetMap(m_dpy, XkbAllClientInfoMask, m_xkb);
-    XFlush(m_dpy);
-    XSync(m_dpy, False);
+    if (changed) {
+        XkbSetMap(m_dpy, XkbAllClientInfoMask, m_xkb);
+        XSync(m_dpy, False);
+    }
     return true;
 }
 
@@ -491,20 +601,24 @@ AutoTypeAction::Result AutoTypePlatformX11::sendKey(KeySym keysym, unsigned int
     unsigned int wanted_mask;
     bool repeat;
 
-    /* pull current active layout group */
-    XkbStateRec state;
-    XkbGetState(m_dpy, XkbUseCoreKbd, &state);
-    group_active = state.group;
+    /* pull current active layout group and modifier state, only once per batch */
+    if (!m_batchStateValid) {
+        XkbStateRec state;
+        XkbGetState(m_dpy, XkbUseCoreKbd, &state);
+        m_batchGroup = state.group;
 
-    /* tell GetKeycode we would prefer a key from active group */
-    group = group_active;
+        Window root, child;
+        int root_x, root_y, x, y;
 
-    Window root, child;
-    int root_x, root_y, x, y;
-    unsigned int original_mask;
+        XSync(m_dpy, False);
+        XQueryPointer(m_dpy, m_rootWindow, &root, &child, &root_x, &root_y, &x, &y, &m_batchMask);
+        m_batchStateValid = m_batching;
+    }
+    group_active = m_batchGroup;
+    unsigned int original_mask = m_batchMask;
 
-    XSync(m_dpy, False);
-    XQueryPointer(m_dpy, m_rootWindow, &root, &child, &root_x, &root_y, &x, &y, &original_mask);
+    /* tell GetKeycode we would prefer a key from active group */
+    group = group_active;
 
     /* fail permanently if Caps Lock is on */
     if (original_mask & LockMask) {
@@ -527,10 +641,12 @@ AutoTypeAction::Result AutoTypePlatformX11::sendKey(KeySym keysym, unsigned int
     /* modifiers that need to be held but aren't */
     unsigned int press_mask = wanted_mask & ~original_mask;
 
+    /* queue all events of this key and sync once at the end, or once per batch */
+    int (*oldHandler)(Display*, XErrorEvent*) = m_batching ? nullptr : XSetErrorHandler(MyErrorHandler);
+
     /* change layout group if necessary */
     if (group_active != group) {
         XkbLockGroup(m_dpy, XkbUseCoreKbd, group);
-        XFlush(m_dpy);
     }
 
     /* hold modifiers */
@@ -548,12 +664,14 @@ AutoTypeAction::Result AutoTypePlatformX11::sendKey(KeySym keysym, unsigned int
     /* reset layout group if necessary */
     if (group_active != group) {
         XkbLockGroup(m_dpy, XkbUseCoreKbd, group_active);
-        XFlush(m_dpy);
     }
 
-    /* reset remap to prevent leaking remap keysyms longer than necessary */
-    if (keycode == m_remapKeycode) {
-        RemapKeycode(NoSymbol);
+    if (m_batching) {
+        /* hand the events to the server without waiting, endBatch() syncs */
+        XFlush(m_dpy);
+    } else {
+        XSync(m_dpy, False);
+        XSetErrorHandler(oldHandler);
     }
 
     return AutoTypeAction::Result::Ok();
@@ -580,9 +698,40 @@ AutoTypeAction::Result AutoTypeExecutorX11::execBegin(const AutoTypeBegin* actio
 {
     Q_UNUSED(action);
     m_platform->updateKeymap();
+    m_platform->reserveKeysyms(m_sequenceKeysyms);
     return AutoTypeAction::Result::Ok();
 }
 
+void AutoTypeExecutorX11::prepareSequence(const QList<QSharedPointer<AutoTypeAction>>& actions)
+{
+    m_sequenceKeysyms.clear();
+    for (const auto& action : actions) {
+        auto key = action.dynamicCast<AutoTypeKey>();
+        if (key) {
+            m_sequenceKeysyms.append(key->key != Qt::Key_unknown ? qtToNativeKeyCode(key->key)
+                                                                 : qcharToNativeKeyCode(key->character));
+        }
+    }
+}
+
+void AutoTypeExecutorX11::finishSequence()
+{
+    /* drop remapped keysyms as soon as the sequence is done */
+    m_platform->endBatch();
+    m_platform->restoreKeymap();
+    m_sequenceKeysyms.clear();
+}
+
+void AutoTypeExecutorX11::beginChunk()
+{
+    m_platform->beginBatch();
+}
+
+void AutoTypeExecutorX11::endChunk()
+{
+    m_platform->endBatch();
+}
+
 AutoTypeAction::Result AutoTypeExecutorX11::execType(const AutoTypeKey* action)
 {
     AutoTypeAction::Result result;
@@ -21,7 +21,9 @@
 #define KEEPASSX_AUTOTYPEXCB_H
 
 #include <QApplication>
+#include <QHash>
 #include <QSet>
+#include <QVector>
 #include <QWidget>
 #include <QtPlugin>
 
@@ -47,6 +49,10 @@ public:
     bool raiseWindow(WId window) override;
     AutoTypeExecutor* createExecutor() override;
     void updateKeymap();
+    void reserveKeysyms(const QList<KeySym>& keysyms);
+    void restoreKeymap();
+    void beginBatch();
+    void endBatch();
 
     AutoTypeAction::Result sendKey(KeySym keysym, unsigned int modifiers = 0);
 
@@ -58,7 +64,7 @@ private:
     bool isTopLevelWindow(Window window);
 
     XkbDescPtr getKeyboard();
-    bool RemapKeycode(KeySym keysym);
+    bool RemapKeycodes(const QList<KeySym>& keysyms);
     void SendKeyEvent(unsigned keycode, bool press);
     void SendModifiers(unsigned int mask, bool press);
     bool GetKeycode(KeySym keysym, int* keycode, int* group, unsigned int* mask, bool* repeat);
@@ -85,10 +91,21 @@ private:
         int mask;
     } KeyDesc;
 
+    const KeyDesc* FindKeyDesc(KeySym keysym, int group, bool* isDead) const;
+
     XkbDescPtr m_xkb;
     QList<KeyDesc> m_keymap;
     KeyCode m_modifier_keycode[N_MOD_INDICES];
-    KeyCode m_remapKeycode;
+    // Spare keycodes used for keysyms missing from the layout and their current assignment
+    QVector<KeyCode> m_remapKeycodes;
+    QHash<KeySym, KeyCode> m_remappedKeysyms;
+    int m_nextRemapKeycode;
+    // While batching, key events are only flushed and the keyboard state is queried once
+    bool m_batching;
+    bool m_batchStateValid;
+    int m_batchGroup;
+    unsigned int m_batchMask;
+    int (*m_batchErrorHandler)(Display*, XErrorEvent*);
     bool m_loaded;
 };
 
@@ -100,9 +117,14 @@ public:
     AutoTypeAction::Result execBegin(const AutoTypeBegin* action) override;
     AutoTypeAction::Result execType(const AutoTypeKey* action) override;
     AutoTypeAction::Result execClearField(const AutoTypeClearField* action) override;
+    void prepareSequence(const QList<QSharedPointer<AutoTypeAction>>& actions) override;
+    void finishSequence() override;
+    void beginChunk() override;
+    void endChunk() override;
 
 private:
     AutoTypePlatformX11* const m_platform;
+    QList<KeySym> m_sequenceKeysyms;
 };
 
 #endif // KEEPASSX_AUTOTYPEXCB_H
@@ -27,6 +27,7 @@
 
 #include <QJsonDocument>
 #include <QLocalSocket>
+#include <limits>
 
 const int BrowserAction::MaxUrlLength = 256;
 
@@ -140,6 +141,7 @@ QJsonObject BrowserAction::handleChangePublicKeys(const QJsonObject& json, const
     m_clientPublicKey = clientPublicKey;
     m_publicKey = keyPair.first;
     m_secretKey = keyPair.second;
+    m_sharedKey = browserMessageBuilder()->getSharedKey(m_clientPublicKey, m_secretKey);
 
     auto response = browserMessageBuilder()->buildMessage(browserMessageBuilder()->incrementNonce(nonce));
     response["action"] = action;
@@ -380,12 +382,15 @@ QJsonObject BrowserAction::handleGetDatabaseGroups(const QJsonObject& json, cons
         return getErrorReply(action, ERROR_KEEPASS_INCORRECT_ACTION);
     }
 
-    const auto groups = browserService()->getDatabaseGroups();
+    // With a known generation the groups are only sent again if the tree has changed since
+    const auto since = static_cast<quint64>(qMax<qint64>(0, browserRequest.getInteger("since")));
+    quint64 generation = 0;
+    const auto groups = browserService()->getDatabaseGroups(since, &generation);
     if (groups.isEmpty()) {
         return getErrorReply(action, ERROR_KEEPASS_NO_GROUPS_FOUND);
     }
 
-    const Parameters params{{"groups", groups}};
+    const Parameters params{{"groups", groups}, {"generation", generation}};
     return buildResponse(action, browserRequest.incrementedNonce, params);
 }
 
@@ -409,12 +414,27 @@ QJsonObject BrowserAction::handleGetDatabaseEntries(const QJsonObject& json, con
         return getErrorReply(action, ERROR_KEEPASS_ACCESS_TO_ALL_ENTRIES_DENIED);
     }
 
-    const QJsonArray entries = browserService()->getDatabaseEntries();
-    if (entries.isEmpty()) {
+    // Optional paging, filtering and "changes since generation" parameters
+    const qint64 maxInt = std::numeric_limits<int>::max();
+    BrowserDatabaseListing::EntryQuery query;
+    query.offset = static_cast<int>(qBound<qint64>(0, browserRequest.getInteger("offset"), maxInt));
+    query.limit = static_cast<int>(qBound<qint64>(0, browserRequest.getInteger("limit"), maxInt));
+    query.filter = browserRequest.getString("filter");
+    query.since = static_cast<quint64>(qMax<qint64>(0, browserRequest.getInteger("since")));
+
+    const auto result = browserService()->getDatabaseEntries(query);
+    const auto entries = result.value("entries").toArray();
+    const bool fullListing = query.offset == 0 && query.limit == 0 && query.filter.isEmpty() && query.since == 0;
+    if (result.isEmpty() || (fullListing && entries.isEmpty())) {
         return getErrorReply(action, ERROR_KEEPASS_NO_GROUPS_FOUND);
     }
 
-    const Parameters params{{"entries", entries}};
+    Parameters params{{"entries", entries},
+                      {"total", result.value("total").toInt()},
+                      {"generation", result.value("generation").toVariant()}};
+    if (result.contains("removed")) {
+        params.insert("removed", result.value("removed").toArray());
+    }
 
     return buildResponse(action, browserRequest.incrementedNonce, params);
 }
@@ -590,7 +610,7 @@ QJsonObject BrowserAction::handlePasskeysRegister(const QJsonObject& json, const
 
 QJsonObject BrowserAction::decryptMessage(const QString& message, const QString& nonce)
 {
-    return browserMessageBuilder()->decryptMessage(message, nonce, m_clientPublicKey, m_secretKey);
+    return browserMessageBuilder()->decryptMessage(message, nonce, m_sharedKey);
 }
 
 QJsonObject BrowserAction::getErrorReply(const QString& action, const int errorCode) const
@@ -600,7 +620,7 @@ QJsonObject BrowserAction::getErrorReply(const QString& action, const int errorC
 
 QJsonObject BrowserAction::buildResponse(const QString& action, const QString& nonce, const Parameters& params)
 {
-    return browserMessageBuilder()->buildResponse(action, nonce, params, m_clientPublicKey, m_secretKey);
+    return browserMessageBuilder()->buildResponse(action, nonce, params, m_sharedKey);
 }
 
 BrowserRequest BrowserAction::decodeRequest(const QJsonObject& json)
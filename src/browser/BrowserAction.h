@@ -54,6 +54,11 @@ struct BrowserRequest
         return decrypted.value(param).toObject();
     }
 
+    inline qint64 getInteger(const QString& param, qint64 defaultValue = 0) const
+    {
+        return static_cast<qint64>(decrypted.value(param).toDouble(static_cast<double>(defaultValue)));
+    }
+
     inline QString getString(const QString& param) const
     {
         return decrypted.value(param).toString();
@@ -102,6 +107,8 @@ private:
     QString m_clientPublicKey;
     QString m_publicKey;
     QString m_secretKey;
+    // Precomputed crypto_box shared key for m_clientPublicKey and m_secretKey
+    QByteArray m_sharedKey;
     bool m_associated = false;
 
     friend class TestBrowser;
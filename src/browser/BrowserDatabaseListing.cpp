@@ -0,0 +1,229 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrowserDatabaseListing.h"
+
+#include "core/Database.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "core/Tools.h"
+#include "crypto/Random.h"
+
+namespace
+{
+    // Generations are sent as JSON numbers, so epoch and counter must fit the 53 bits of a double
+    const int GenerationCounterBits = 32;
+    const quint32 GenerationEpochLimit = 1u << 21;
+} // namespace
+
+/**
+ * Bring the cached listings up to date with the given database.
+ * Does nothing if the database has not changed since the last call.
+ *
+ * Any change rebuilds the listing of every entry, including resolving its
+ * placeholders, because a reference can make an unchanged entry list
+ * differently. The work per change is therefore still linear in the number
+ * of entries; only the responses are limited to what changed.
+ */
+void BrowserDatabaseListing::update(Database* db)
+{
+    if (!db || !db->rootGroup()) {
+        clear();
+        return;
+    }
+
+    const bool sameDatabase = m_db == db && m_rootGroup == db->rootGroup();
+    if (sameDatabase && m_modificationCount == db->modificationCount()) {
+        return;
+    }
+
+    if (!sameDatabase) {
+        startEpoch();
+        m_entries.clear();
+        m_removedEntries.clear();
+        m_groups = {};
+    }
+    ++m_generation;
+    m_db = db;
+    m_rootGroup = db->rootGroup();
+    m_modificationCount = db->modificationCount();
+
+    // Entries whose listing did not change keep their generation, the ones left over were removed
+    QHash<QUuid, int> previous;
+    previous.reserve(m_entries.size());
+    for (int i = 0; i < m_entries.size(); ++i) {
+        previous.insert(m_entries.at(i).uuid, i);
+    }
+
+    QVector<ListedEntry> entries;
+    entries.reserve(m_entries.size());
+    const auto recycleBin = db->metadata()->recycleBin();
+    for (const auto group : m_rootGroup->groupsRecursive(true)) {
+        if (group == recycleBin) {
+            continue;
+        }
+
+        for (const auto entry : group->entries()) {
+            QJsonObject json;
+            json["title"] = entry->resolveMultiplePlaceholders(entry->title());
+            json["uuid"] = entry->resolveMultiplePlaceholders(entry->uuidToHex());
+            json["url"] = entry->resolveMultiplePlaceholders(entry->url());
+
+            auto generation = m_generation;
+            auto it = previous.find(entry->uuid());
+            if (it != previous.end()) {
+                const auto& listed = m_entries.at(it.value());
+                if (listed.json == json) {
+                    generation = listed.generation;
+                }
+                previous.erase(it);
+            }
+            m_removedEntries.remove(entry->uuid());
+            entries.append({entry->uuid(), json, generation});
+        }
+    }
+
+    for (auto it = previous.constBegin(); it != previous.constEnd(); ++it) {
+        m_removedEntries.insert(it.key(), m_generation);
+    }
+    m_entries.swap(entries);
+
+    QJsonObject root;
+    root["name"] = m_rootGroup->name();
+    root["uuid"] = Tools::uuidToHex(m_rootGroup->uuid());
+    root["children"] = buildGroupChildren(m_rootGroup);
+    if (root != m_groups) {
+        m_groups = root;
+        m_groupsGeneration = m_generation;
+    }
+}
+
+void BrowserDatabaseListing::clear()
+{
+    m_db = nullptr;
+    m_rootGroup = nullptr;
+    m_modificationCount = 0;
+    m_entries.clear();
+    m_removedEntries.clear();
+    m_groups = {};
+}
+
+quint64 BrowserDatabaseListing::generation() const
+{
+    return m_generation;
+}
+
+/**
+ * The group tree in the get-database-groups format. The groups array
+ * is empty if the tree has not changed since the given generation.
+ */
+QJsonObject BrowserDatabaseListing::groups(quint64 since) const
+{
+    if (m_groups.isEmpty()) {
+        return {};
+    }
+
+    QJsonArray groups;
+    if (!isDelta(since) || m_groupsGeneration > since) {
+        groups.push_back(m_groups);
+    }
+
+    QJsonObject result;
+    result["groups"] = groups;
+    return result;
+}
+
+/**
+ * One page of the filtered entry listing. The result holds the entries
+ * of the page, the total number of matching entries and the current
+ * generation. For a valid since generation only entries changed after it
+ * are listed and the UUIDs of entries removed since are added as well;
+ * otherwise the listing is complete and "removed" is absent.
+ */
+QJsonObject BrowserDatabaseListing::entries(const EntryQuery& query) const
+{
+    if (!m_db) {
+        return {};
+    }
+
+    const bool delta = isDelta(query.since);
+    QJsonArray entries;
+    int total = 0;
+    for (const auto& listed : m_entries) {
+        if (delta && listed.generation <= query.since) {
+            continue;
+        }
+        if (!query.filter.isEmpty() && !listed.json["title"].toString().contains(query.filter, Qt::CaseInsensitive)
+            && !listed.json["url"].toString().contains(query.filter, Qt::CaseInsensitive)) {
+            continue;
+        }
+        if (total >= query.offset && (query.limit <= 0 || entries.size() < query.limit)) {
+            entries.append(listed.json);
+        }
+        ++total;
+    }
+
+    QJsonObject result;
+    result["entries"] = entries;
+    result["total"] = total;
+    result["generation"] = static_cast<qint64>(m_generation);
+
+    if (delta) {
+        QJsonArray removed;
+        for (auto it = m_removedEntries.constBegin(); it != m_removedEntries.constEnd(); ++it) {
+            if (it.value() > query.since) {
+                removed.append(Tools::uuidToHex(it.key()));
+            }
+        }
+        result["removed"] = removed;
+    }
+
+    return result;
+}
+
+/**
+ * Restart the generations with a new random, non-zero epoch.
+ */
+void BrowserDatabaseListing::startEpoch()
+{
+    const quint64 epoch = randomGen()->randomUIntRange(1, GenerationEpochLimit);
+    m_generation = epoch << GenerationCounterBits;
+}
+
+bool BrowserDatabaseListing::isDelta(quint64 since) const
+{
+    return since > 0 && (since >> GenerationCounterBits) == (m_generation >> GenerationCounterBits)
+           && since <= m_generation;
+}
+
+QJsonArray BrowserDatabaseListing::buildGroupChildren(const Group* group) const
+{
+    QJsonArray groupList;
+    const auto recycleBin = group->database()->metadata()->recycleBin();
+    for (const auto& c : group->children()) {
+        if (c == recycleBin) {
+            continue;
+        }
+
+        QJsonObject jsonGroup;
+        jsonGroup["name"] = c->name();
+        jsonGroup["uuid"] = Tools::uuidToHex(c->uuid());
+        jsonGroup["children"] = buildGroupChildren(c);
+        groupList.push_back(jsonGroup);
+    }
+    return groupList;
+}
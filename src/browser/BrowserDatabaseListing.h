@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_BROWSERDATABASELISTING_H
+#define KEEPASSXC_BROWSERDATABASELISTING_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QPointer>
+#include <QUuid>
+#include <QVector>
+
+class Database;
+class Group;
+
+/**
+ * Cached entry and group listings of a database for the get-database-entries
+ * and get-database-groups browser requests.
+ *
+ * The listings are rebuilt at most once per database modification. Every
+ * rebuild starts a new generation; entries and the group tree remember the
+ * generation in which they last changed, so clients can ask for the changes
+ * since a generation they already know.
+ *
+ * Generations carry a random epoch in their upper bits that is chosen anew
+ * whenever a different database is listed, so a generation handed out for
+ * another database or by another process is not mistaken for a known one.
+ */
+class BrowserDatabaseListing
+{
+public:
+    struct EntryQuery
+    {
+        int offset = 0;
+        // Maximum number of entries to return, zero or less for all
+        int limit = 0;
+        // Case-insensitive match against the title or URL
+        QString filter;
+        // Only return entries changed after this generation, zero for all
+        quint64 since = 0;
+    };
+
+    void update(Database* db);
+    void clear();
+
+    quint64 generation() const;
+    QJsonObject groups(quint64 since = 0) const;
+    QJsonObject entries(const EntryQuery& query) const;
+
+private:
+    struct ListedEntry
+    {
+        QUuid uuid;
+        QJsonObject json;
+        quint64 generation;
+    };
+
+    void startEpoch();
+    bool isDelta(quint64 since) const;
+    QJsonArray buildGroupChildren(const Group* group) const;
+
+    QPointer<Database> m_db;
+    QPointer<Group> m_rootGroup;
+    quint64 m_modificationCount = 0;
+    quint64 m_generation = 0;
+
+    QVector<ListedEntry> m_entries;
+    QHash<QUuid, quint64> m_removedEntries;
+    QJsonObject m_groups;
+    quint64 m_groupsGeneration = 0;
+};
+
+#endif // KEEPASSXC_BROWSERDATABASELISTING_H
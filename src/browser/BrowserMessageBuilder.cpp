@@ -73,6 +73,14 @@ QJsonObject BrowserMessageBuilder::buildResponse(const QString& action,
                                                  const Parameters& params,
                                                  const QString& publicKey,
                                                  const QString& secretKey)
+{
+    return buildResponse(action, nonce, params, getSharedKey(publicKey, secretKey));
+}
+
+QJsonObject BrowserMessageBuilder::buildResponse(const QString& action,
+                                                 const QString& nonce,
+                                                 const Parameters& params,
+                                                 const QByteArray& sharedKey)
 {
     auto message = buildMessage(nonce);
 
@@ -81,7 +89,7 @@ QJsonObject BrowserMessageBuilder::buildResponse(const QString& action,
         message[i.key()] = QJsonValue::fromVariant(i.value());
     }
 
-    const auto encryptedMessage = encryptMessage(message, nonce, publicKey, secretKey);
+    const auto encryptedMessage = encryptMessage(message, nonce, sharedKey);
     if (encryptedMessage.isEmpty()) {
         return getErrorReply(action, ERROR_KEEPASS_CANNOT_ENCRYPT_MESSAGE);
     }
@@ -165,6 +173,12 @@ QString BrowserMessageBuilder::encryptMessage(const QJsonObject& message,
                                               const QString& nonce,
                                               const QString& publicKey,
                                               const QString& secretKey)
+{
+    return encryptMessage(message, nonce, getSharedKey(publicKey, secretKey));
+}
+
+QString
+BrowserMessageBuilder::encryptMessage(const QJsonObject& message, const QString& nonce, const QByteArray& sharedKey)
 {
     if (message.isEmpty() || nonce.isEmpty()) {
         return {};
@@ -172,7 +186,7 @@ QString BrowserMessageBuilder::encryptMessage(const QJsonObject& message,
 
     const QString reply(QJsonDocument(message).toJson());
     if (!reply.isEmpty()) {
-        return encrypt(reply, nonce, publicKey, secretKey);
+        return encrypt(reply, nonce, sharedKey);
     }
 
     return {};
@@ -182,12 +196,18 @@ QJsonObject BrowserMessageBuilder::decryptMessage(const QString& message,
                                                   const QString& nonce,
                                                   const QString& publicKey,
                                                   const QString& secretKey)
+{
+    return decryptMessage(message, nonce, getSharedKey(publicKey, secretKey));
+}
+
+QJsonObject
+BrowserMessageBuilder::decryptMessage(const QString& message, const QString& nonce, const QByteArray& sharedKey)
 {
     if (message.isEmpty() || nonce.isEmpty()) {
         return {};
     }
 
-    QByteArray ba = decrypt(message, nonce, publicKey, secretKey);
+    QByteArray ba = decrypt(message, nonce, sharedKey);
     if (ba.isEmpty()) {
         return {};
     }
@@ -200,26 +220,27 @@ QString BrowserMessageBuilder::encrypt(const QString& plaintext,
                                        const QString& publicKey,
                                        const QString& secretKey)
 {
-    const QByteArray ma = plaintext.toUtf8();
-    const QByteArray na = base64Decode(nonce);
-    const QByteArray ca = base64Decode(publicKey);
-    const QByteArray sa = base64Decode(secretKey);
-
-    std::vector<unsigned char> m(ma.cbegin(), ma.cend());
-    std::vector<unsigned char> n(na.cbegin(), na.cend());
-    std::vector<unsigned char> ck(ca.cbegin(), ca.cend());
-    std::vector<unsigned char> sk(sa.cbegin(), sa.cend());
+    return encrypt(plaintext, nonce, getSharedKey(publicKey, secretKey));
+}
 
-    std::vector<unsigned char> e;
-    e.resize(BrowserShared::NATIVEMSG_MAX_LENGTH);
+QString BrowserMessageBuilder::encrypt(const QString& plaintext, const QString& nonce, const QByteArray& sharedKey)
+{
+    const QByteArray m = plaintext.toUtf8();
+    const QByteArray n = base64Decode(nonce);
 
-    if (m.empty() || n.empty() || ck.empty() || sk.empty()) {
+    if (m.isEmpty() || n.size() != static_cast<int>(crypto_box_NONCEBYTES)
+        || sharedKey.size() != static_cast<int>(crypto_box_BEFORENMBYTES)) {
         return {};
     }
 
-    if (crypto_box_easy(e.data(), m.data(), m.size(), n.data(), ck.data(), sk.data()) == 0) {
-        QByteArray res = getQByteArray(e.data(), (crypto_box_MACBYTES + ma.length()));
-        return res.toBase64();
+    QByteArray e(static_cast<int>(crypto_box_MACBYTES) + m.size(), Qt::Uninitialized);
+    if (crypto_box_easy_afternm(reinterpret_cast<uint8_t*>(e.data()),
+                                reinterpret_cast<const uint8_t*>(m.constData()),
+                                m.size(),
+                                reinterpret_cast<const uint8_t*>(n.constData()),
+                                reinterpret_cast<const uint8_t*>(sharedKey.constData()))
+        == 0) {
+        return e.toBase64();
     }
 
     return {};
@@ -230,28 +251,62 @@ QByteArray BrowserMessageBuilder::decrypt(const QString& encrypted,
                                           const QString& publicKey,
                                           const QString& secretKey)
 {
-    const QByteArray ma = base64Decode(encrypted);
-    const QByteArray na = base64Decode(nonce);
-    const QByteArray ca = base64Decode(publicKey);
-    const QByteArray sa = base64Decode(secretKey);
+    return decrypt(encrypted, nonce, getSharedKey(publicKey, secretKey));
+}
 
-    std::vector<unsigned char> m(ma.cbegin(), ma.cend());
-    std::vector<unsigned char> n(na.cbegin(), na.cend());
-    std::vector<unsigned char> ck(ca.cbegin(), ca.cend());
-    std::vector<unsigned char> sk(sa.cbegin(), sa.cend());
+QByteArray BrowserMessageBuilder::decrypt(const QString& encrypted, const QString& nonce, const QByteArray& sharedKey)
+{
+    const QByteArray m = base64Decode(encrypted);
+    const QByteArray n = base64Decode(nonce);
 
-    std::vector<unsigned char> d;
-    d.resize(BrowserShared::NATIVEMSG_MAX_LENGTH);
+    if (m.size() <= static_cast<int>(crypto_box_MACBYTES) || n.size() != static_cast<int>(crypto_box_NONCEBYTES)
+        || sharedKey.size() != static_cast<int>(crypto_box_BEFORENMBYTES)) {
+        return {};
+    }
 
-    if (m.empty() || n.empty() || ck.empty() || sk.empty()) {
+    QByteArray d(m.size() - static_cast<int>(crypto_box_MACBYTES), Qt::Uninitialized);
+    if (crypto_box_open_easy_afternm(reinterpret_cast<uint8_t*>(d.data()),
+                                     reinterpret_cast<const uint8_t*>(m.constData()),
+                                     m.size(),
+                                     reinterpret_cast<const uint8_t*>(n.constData()),
+                                     reinterpret_cast<const uint8_t*>(sharedKey.constData()))
+        != 0) {
         return {};
     }
 
-    if (crypto_box_open_easy(d.data(), m.data(), ma.length(), n.data(), ck.data(), sk.data()) == 0) {
-        return getQByteArray(d.data(), std::char_traits<char>::length(reinterpret_cast<const char*>(d.data())));
+    // Plaintext ends at the first terminator, as with the previous fixed size buffer
+    const auto terminator = d.indexOf('\0');
+    if (terminator >= 0) {
+        d.truncate(terminator);
     }
+    return d;
+}
 
-    return {};
+/**
+ * Precompute the NaCl box shared key for a key pair, so a client session
+ * only pays for the X25519 scalar multiplication once.
+ *
+ * @return shared key; empty if either key is invalid
+ */
+QByteArray BrowserMessageBuilder::getSharedKey(const QString& publicKey, const QString& secretKey)
+{
+    const QByteArray pk = base64Decode(publicKey);
+    const QByteArray sk = base64Decode(secretKey);
+
+    if (pk.size() != static_cast<int>(crypto_box_PUBLICKEYBYTES)
+        || sk.size() != static_cast<int>(crypto_box_SECRETKEYBYTES)) {
+        return {};
+    }
+
+    QByteArray sharedKey(static_cast<int>(crypto_box_BEFORENMBYTES), Qt::Uninitialized);
+    if (crypto_box_beforenm(reinterpret_cast<uint8_t*>(sharedKey.data()),
+                            reinterpret_cast<const uint8_t*>(pk.constData()),
+                            reinterpret_cast<const uint8_t*>(sk.constData()))
+        != 0) {
+        return {};
+    }
+
+    return sharedKey;
 }
 
 QString BrowserMessageBuilder::getBase64FromKey(const uchar* array, const uint len)
@@ -79,6 +79,10 @@ public:
                               const Parameters& params,
                               const QString& publicKey,
                               const QString& secretKey);
+    QJsonObject buildResponse(const QString& action,
+                              const QString& nonce,
+                              const Parameters& params,
+                              const QByteArray& sharedKey);
     QJsonObject getErrorReply(const QString& action, const int errorCode) const;
     QString getErrorMessage(const int errorCode) const;
 
@@ -92,6 +96,12 @@ public:
     QByteArray
     decrypt(const QString& encrypted, const QString& nonce, const QString& publicKey, const QString& secretKey);
 
+    QByteArray getSharedKey(const QString& publicKey, const QString& secretKey);
+    QString encryptMessage(const QJsonObject& message, const QString& nonce, const QByteArray& sharedKey);
+    QJsonObject decryptMessage(const QString& message, const QString& nonce, const QByteArray& sharedKey);
+    QString encrypt(const QString& plaintext, const QString& nonce, const QByteArray& sharedKey);
+    QByteArray decrypt(const QString& encrypted, const QString& nonce, const QByteArray& sharedKey);
+
     QString getBase64FromKey(const uchar* array, const uint len);
     QByteArray getQByteArray(const uchar* array, const uint len) const;
     QJsonObject getJsonObject(const uchar* pArray, const uint len) const;
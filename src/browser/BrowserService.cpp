@@ -155,7 +155,15 @@ QString BrowserService::getDatabaseHash(bool legacy)
                    QCryptographicHash::Sha256)
             .toHex();
     }
-    return QCryptographicHash::hash(getDatabaseRootUuid().toUtf8(), QCryptographicHash::Sha256).toHex();
+
+    // The hash only depends on the root group UUID, so it is recomputed only when the active database changes
+    auto db = getDatabase();
+    const auto rootUuid = db && db->rootGroup() ? db->rootGroup()->uuid() : QUuid();
+    if (m_databaseHash.isEmpty() || rootUuid != m_databaseHashRootUuid) {
+        m_databaseHashRootUuid = rootUuid;
+        m_databaseHash = QCryptographicHash::hash(getDatabaseRootUuid().toUtf8(), QCryptographicHash::Sha256).toHex();
+    }
+    return m_databaseHash;
 }
 
 QString BrowserService::getDatabaseRootUuid()
@@ -187,81 +195,37 @@ QString BrowserService::getDatabaseRecycleBinUuid()
     return recycleBin->uuidToHex();
 }
 
-QJsonArray BrowserService::getChildrenFromGroup(Group* group)
+/**
+ * The group tree of the current database, served from the listing cache.
+ *
+ * @param sinceGeneration generation of a tree the caller already has, the groups
+ *                        array is left empty if the tree has not changed since
+ * @param generation receives the current listing generation
+ */
+QJsonObject BrowserService::getDatabaseGroups(quint64 sinceGeneration, quint64* generation)
 {
-    QJsonArray groupList;
-
-    if (!group) {
-        return groupList;
-    }
-
-    for (const auto& c : group->children()) {
-        if (c == group->database()->metadata()->recycleBin()) {
-            continue;
-        }
-
-        QJsonObject jsonGroup;
-        jsonGroup["name"] = c->name();
-        jsonGroup["uuid"] = Tools::uuidToHex(c->uuid());
-        jsonGroup["children"] = getChildrenFromGroup(c);
-        groupList.push_back(jsonGroup);
+    auto db = getDatabase();
+    m_databaseListing.update(db.data());
+    if (generation) {
+        *generation = m_databaseListing.generation();
     }
-    return groupList;
+    return m_databaseListing.groups(sinceGeneration);
 }
 
-QJsonObject BrowserService::getDatabaseGroups()
+QJsonArray BrowserService::getDatabaseEntries()
 {
-    auto db = getDatabase();
-    if (!db) {
-        return {};
-    }
-
-    Group* rootGroup = db->rootGroup();
-    if (!rootGroup) {
-        return {};
-    }
-
-    QJsonObject root;
-    root["name"] = rootGroup->name();
-    root["uuid"] = Tools::uuidToHex(rootGroup->uuid());
-    root["children"] = getChildrenFromGroup(rootGroup);
-
-    QJsonArray groups;
-    groups.push_back(root);
-
-    QJsonObject result;
-    result["groups"] = groups;
-
-    return result;
+    return getDatabaseEntries(BrowserDatabaseListing::EntryQuery()).value("entries").toArray();
 }
 
-QJsonArray BrowserService::getDatabaseEntries()
+/**
+ * A page of the entries of the current database, served from the listing cache.
+ * See BrowserDatabaseListing::entries for the result format.
+ */
+QJsonObject BrowserService::getDatabaseEntries(const BrowserDatabaseListing::EntryQuery& query)
 {
     auto db = getDatabase();
-    if (!db) {
-        return {};
-    }
-
-    Group* rootGroup = db->rootGroup();
-    if (!rootGroup) {
-        return {};
-    }
-
-    QJsonArray entries;
-    for (const auto& group : rootGroup->groupsRecursive(true)) {
-        if (group == db->metadata()->recycleBin()) {
-            continue;
-        }
-
-        for (const auto& entry : group->entries()) {
-            QJsonObject jentry;
-            jentry["title"] = entry->resolveMultiplePlaceholders(entry->title());
-            jentry["uuid"] = entry->resolveMultiplePlaceholders(entry->uuidToHex());
-            jentry["url"] = entry->resolveMultiplePlaceholders(entry->url());
-            entries.push_back(jentry);
-        }
-    }
-    return entries;
+    m_databaseListing.update(db.data());
+    return m_databaseListing.entries(query);
 }
 
 QJsonObject BrowserService::createNewGroup(const QString& groupName, bool isPasskeysGroup)
@@ -1650,6 +1614,9 @@ void BrowserService::updateWindowState()
 
 void BrowserService::databaseLocked(DatabaseWidget* dbWidget)
 {
+    // Do not keep entry titles and URLs of a locked database around
+    m_databaseListing.clear();
+
     if (dbWidget) {
         QJsonObject msg;
         msg["action"] = QString("database-locked");
@@ -21,6 +21,7 @@
 #define KEEPASSXC_BROWSERSERVICE_H
 
 #include "BrowserAccessControlDialog.h"
+#include "BrowserDatabaseListing.h"
 #include "config-keepassx.h"
 #include "core/Entry.h"
 #include "gui/PasswordGeneratorWidget.h"
@@ -78,8 +79,9 @@ public:
     bool openDatabase(bool triggerUnlock);
     void lockDatabase();
 
-    QJsonObject getDatabaseGroups();
+    QJsonObject getDatabaseGroups(quint64 sinceGeneration = 0, quint64* generation = nullptr);
     QJsonArray getDatabaseEntries();
+    QJsonObject getDatabaseEntries(const BrowserDatabaseListing::EntryQuery& query);
     QJsonObject createNewGroup(const QString& groupName, bool isPasskeysGroup = false);
     QString getCurrentTotp(const QString& uuid);
     void showPasswordGenerator(const KeyPairMessage& keyPairMessage);
@@ -178,7 +180,6 @@ private:
     QJsonObject prepareEntry(const Entry* entry);
     void allowEntry(Entry* entry, const QString& siteHost, const QString& formUrl, const QString& realm);
     void denyEntry(Entry* entry, const QString& siteHost, const QString& formUrl, const QString& realm);
-    QJsonArray getChildrenFromGroup(Group* group);
     Access checkAccess(const Entry* entry, const QString& siteHost, const QString& formHost, const QString& realm);
     Group* getDefaultEntryGroup(const QSharedPointer<Database>& selectedDb = {});
     int sortPriority(const QStringList& urls, const QString& siteUrl, const QString& formUrl);
@@ -215,6 +216,9 @@ private:
     QUuid m_keepassBrowserUUID;
 
     QPointer<DatabaseWidget> m_currentDatabaseWidget;
+    QUuid m_databaseHashRootUuid;
+    QString m_databaseHash;
+    BrowserDatabaseListing m_databaseListing;
     QPointer<PasswordGeneratorWidget> m_passwordGenerator;
 
     Q_DISABLE_COPY(BrowserService);
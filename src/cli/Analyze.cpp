@@ -18,6 +18,7 @@
 #include "Analyze.h"
 
 #include "Utils.h"
+#include "core/DuplicateFinder.h"
 #include "core/Global.h"
 #include "core/Group.h"
 #include "core/HibpOffline.h"
@@ -37,15 +38,50 @@ const QCommandLineOption Analyze::OkonOption =
                        QObject::tr("Path to okon-cli to search a formatted HIBP file"),
                        QObject::tr("okon-cli"));
 
+const QCommandLineOption Analyze::DuplicatesOption =
+    QCommandLineOption("duplicates",
+                       QObject::tr("List entries sharing the same domain and username, TOTP secret or passkey."));
+
+namespace
+{
+    QString entryPath(const Entry* entry)
+    {
+        QString path = entry->title();
+        for (auto g = entry->group(); g && g != g->database()->rootGroup(); g = g->parentGroup()) {
+            path.prepend("/").prepend(g->name());
+        }
+        return path;
+    }
+} // namespace
+
 Analyze::Analyze()
 {
     name = QString("analyze");
     description = QObject::tr("Analyze passwords for weaknesses and problems.");
     options.append(Analyze::HIBPDatabaseOption);
     options.append(Analyze::OkonOption);
+    options.append(Analyze::DuplicatesOption);
 }
 
 int Analyze::executeWithDatabase(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser)
+{
+    // The HIBP check stays the default when no analysis is selected
+    const bool duplicates = parser->isSet(Analyze::DuplicatesOption);
+    if (!duplicates || parser->isSet(Analyze::HIBPDatabaseOption)) {
+        const auto result = checkHibp(database, parser);
+        if (result != EXIT_SUCCESS) {
+            return result;
+        }
+    }
+
+    if (duplicates) {
+        findDuplicates(database);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int Analyze::checkHibp(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser)
 {
     auto& out = Utils::STDOUT;
     auto& err = Utils::STDERR;
@@ -86,11 +122,7 @@ int Analyze::executeWithDatabase(QSharedPointer<Database> database, QSharedPoint
     for (const auto& finding : findings) {
         const auto entry = finding.first;
         auto count = finding.second;
-
-        QString path = entry->title();
-        for (auto g = entry->group(); g && g != g->database()->rootGroup(); g = g->parentGroup()) {
-            path.prepend("/").prepend(g->name());
-        }
+        const auto path = entryPath(entry);
 
         if (count > 0) {
             out << QObject::tr("Password for '%1' has been leaked %2 time(s)!", "", count).arg(path).arg(count)
@@ -102,3 +134,29 @@ int Analyze::executeWithDatabase(QSharedPointer<Database> database, QSharedPoint
 
     return EXIT_SUCCESS;
 }
+
+void Analyze::findDuplicates(QSharedPointer<Database> database)
+{
+    auto& out = Utils::STDOUT;
+
+    out << QObject::tr("Searching database entries for duplicates…") << Qt::endl;
+
+    DuplicateFinder finder(database.data());
+    for (const auto& duplicates : finder.duplicates()) {
+        switch (duplicates.match) {
+        case DuplicateFinder::Match::Login:
+            out << QObject::tr("Duplicate login for %1:").arg(duplicates.description) << Qt::endl;
+            break;
+        case DuplicateFinder::Match::Totp:
+            out << QObject::tr("Duplicate TOTP secret:") << Qt::endl;
+            break;
+        case DuplicateFinder::Match::Passkey:
+            out << QObject::tr("Duplicate passkey for %1:").arg(duplicates.description) << Qt::endl;
+            break;
+        }
+
+        for (const auto entry : duplicates.entries) {
+            out << "  " << entryPath(entry) << Qt::endl;
+        }
+    }
+}
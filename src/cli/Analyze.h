@@ -28,6 +28,11 @@ public:
 
     static const QCommandLineOption HIBPDatabaseOption;
     static const QCommandLineOption OkonOption;
+    static const QCommandLineOption DuplicatesOption;
+
+private:
+    int checkHibp(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser);
+    void findDuplicates(QSharedPointer<Database> database);
 };
 
 #endif // KEEPASSXC_HIBP_H
@@ -45,6 +45,9 @@ public:
     QList<CommandLineArgument> positionalArguments;
     QList<CommandLineArgument> optionalArguments;
     QList<QCommandLineOption> options;
+    // Accept any number of arguments after the optional ones, e.g. a command line to run.
+    // Options are then only recognized before the first positional argument.
+    bool variadicArguments = false;
 
     QString getDescriptionLine();
     QSharedPointer<QCommandLineParser> getCommandLineParser(const QStringList& arguments);
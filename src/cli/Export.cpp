@@ -17,45 +17,112 @@
 
 #include "Export.h"
 
-#include "TextStream.h"
 #include "Utils.h"
 #include "core/Global.h"
 #include "format/CsvExporter.h"
+#include "format/KeePass2Writer.h"
 
 #include <QCommandLineParser>
+#include <QFile>
 
 const QCommandLineOption Export::FormatOption = QCommandLineOption(
     QStringList() << "f" << "format",
     QObject::tr("Format to use when exporting. Available choices are 'xml' or 'csv'. Defaults to 'xml'."),
     QStringLiteral("xml|csv"));
 
+const QCommandLineOption Export::OutputOption =
+    QCommandLineOption(QStringList() << "o" << "output",
+                       QObject::tr("Write the export to the given file instead of standard output."),
+                       QObject::tr("path"));
+
+const QCommandLineOption Export::ChunkOption =
+    QCommandLineOption(QStringList() << "chunk",
+                       QObject::tr("Flush the output after every N entries so pipelines receive data incrementally."),
+                       QStringLiteral("N"));
+
+const QCommandLineOption Export::ProgressOption =
+    QCommandLineOption(QStringList() << "progress", QObject::tr("Report export progress on standard error."));
+
 Export::Export()
 {
     name = QStringLiteral("export");
     options.append(Export::FormatOption);
+    options.append(Export::OutputOption);
+    options.append(Export::ChunkOption);
+    options.append(Export::ProgressOption);
     description = QObject::tr("Exports the content of a database to standard output in the specified format.");
 }
 
 int Export::executeWithDatabase(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser)
 {
-    TextStream out(Utils::STDOUT.device());
     auto& err = Utils::STDERR;
 
-    QString format = parser->value(Export::FormatOption);
-    if (format.isEmpty() || format.startsWith(QStringLiteral("xml"), Qt::CaseInsensitive)) {
-        QByteArray xmlData;
-        QString errorMessage;
-        if (!database->extract(xmlData, &errorMessage)) {
-            err << QObject::tr("Unable to export database to XML: %1").arg(errorMessage) << Qt::endl;
+    const QString format = parser->value(Export::FormatOption);
+    const bool isXml = format.isEmpty() || format.startsWith(QStringLiteral("xml"), Qt::CaseInsensitive);
+    const bool isCsv = format.startsWith(QStringLiteral("csv"), Qt::CaseInsensitive);
+    if (!isXml && !isCsv) {
+        err << QObject::tr("Unsupported format %1").arg(format) << Qt::endl;
+        return EXIT_FAILURE;
+    }
+
+    int chunkSize = 0;
+    if (parser->isSet(Export::ChunkOption)) {
+        bool ok;
+        chunkSize = parser->value(Export::ChunkOption).toInt(&ok);
+        if (!ok || chunkSize < 1) {
+            err << QObject::tr("Invalid chunk size %1.").arg(parser->value(Export::ChunkOption)) << Qt::endl;
             return EXIT_FAILURE;
         }
-        out.write(xmlData.constData());
-    } else if (format.startsWith(QStringLiteral("csv"), Qt::CaseInsensitive)) {
-        CsvExporter csvExporter;
-        out << csvExporter.exportDatabase(database);
+    }
+
+    // Write straight to the output device as groups are visited instead of
+    // building the whole document in memory first.
+    QFile outputFile;
+    QIODevice* output = Utils::STDOUT.device();
+    const QString outputPath = parser->value(Export::OutputOption);
+    if (!outputPath.isEmpty()) {
+        outputFile.setFileName(outputPath);
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << QObject::tr("Failed to open output file %1: %2").arg(outputPath, outputFile.errorString())
+                << Qt::endl;
+            return EXIT_FAILURE;
+        }
+        output = &outputFile;
     } else {
-        err << QObject::tr("Unsupported format %1").arg(format) << Qt::endl;
-        return EXIT_FAILURE;
+        Utils::STDOUT.flush();
+    }
+
+    const bool showProgress = parser->isSet(Export::ProgressOption) && !parser->isSet(Command::QuietOption);
+    const int progressInterval = chunkSize > 0 ? chunkSize : 1000;
+    auto progress = [&](int done, int total) {
+        if (chunkSize > 0 && done % chunkSize == 0) {
+            if (auto file = qobject_cast<QFileDevice*>(output)) {
+                file->flush();
+            }
+        }
+        if (showProgress && (done % progressInterval == 0 || done == total)) {
+            err << QObject::tr("Exported %1 of %2 entries").arg(done).arg(total) << Qt::endl;
+        }
+    };
+
+    if (isXml) {
+        KeePass2Writer writer;
+        writer.extractDatabase(database.data(), output, progress);
+        if (writer.hasError()) {
+            err << QObject::tr("Unable to export database to XML: %1").arg(writer.errorString()) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        CsvExporter csvExporter;
+        csvExporter.setProgressCallback(progress);
+        if (!csvExporter.exportDatabase(output, database)) {
+            err << QObject::tr("Unable to export database to CSV: %1").arg(csvExporter.errorString()) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (auto file = qobject_cast<QFileDevice*>(output)) {
+        file->flush();
     }
 
     return EXIT_SUCCESS;
@@ -28,6 +28,9 @@ public:
     int executeWithDatabase(QSharedPointer<Database> db, QSharedPointer<QCommandLineParser> parser) override;
 
     static const QCommandLineOption FormatOption;
+    static const QCommandLineOption OutputOption;
+    static const QCommandLineOption ChunkOption;
+    static const QCommandLineOption ProgressOption;
 };
 
 #endif // KEEPASSXC_EXPORT_H
@@ -21,8 +21,11 @@
 #include "Utils.h"
 
 #include "core/Global.h"
+#include "format/KdbxXmlReader.h"
+#include "format/KeePass2.h"
 
 #include <QCommandLineParser>
+#include <QFile>
 #include <QFileInfo>
 
 /**
@@ -33,19 +36,27 @@
  * If the database is being saved in a non existent directory, the
  * function will fail.
  *
+ * The XML export is parsed as it is read, so it can be piped in from
+ * standard input by passing '-' as the XML path.
+ *
  * @return EXIT_SUCCESS on success, or EXIT_FAILURE on failure
  */
 
+const QCommandLineOption Import::ProgressOption =
+    QCommandLineOption(QStringList() << "progress", QObject::tr("Report import progress on standard error."));
+
 Import::Import()
 {
     name = QString("import");
     description = QObject::tr("Import the contents of an XML database.");
-    positionalArguments.append({QString("xml"), QObject::tr("Path of the XML database export."), QString("")});
+    positionalArguments.append(
+        {QString("xml"), QObject::tr("Path of the XML database export, or '-' for standard input."), QString("")});
     positionalArguments.append({QString("database"), QObject::tr("Path of the new database."), QString("")});
     options.append(DatabaseCreate::SetKeyFileOption);
     options.append(DatabaseCreate::SetKeyFileShortOption);
     options.append(DatabaseCreate::SetPasswordOption);
     options.append(DatabaseCreate::DecryptionTimeOption);
+    options.append(Import::ProgressOption);
 }
 
 int Import::execute(const QStringList& arguments)
@@ -67,17 +78,61 @@ int Import::execute(const QStringList& arguments)
         return EXIT_FAILURE;
     }
 
+    // The new database password is prompted for on standard input as well
+    const bool readStdin = xmlExportPath == QStringLiteral("-");
+    if (readStdin && parser->isSet(DatabaseCreate::SetPasswordOption)) {
+        err << QObject::tr("Cannot read the XML export from standard input together with --set-password.")
+            << Qt::endl;
+        return EXIT_FAILURE;
+    }
+
     QSharedPointer<Database> db = DatabaseCreate::initializeDatabaseFromOptions(parser);
     if (!db) {
         return EXIT_FAILURE;
     }
 
-    QString errorMessage;
-    if (!db->import(xmlExportPath, &errorMessage)) {
-        err << QObject::tr("Unable to import XML database: %1").arg(errorMessage) << Qt::endl;
+    QFile xmlFile;
+    QIODevice* xmlDevice = &xmlFile;
+    if (readStdin) {
+        xmlDevice = Utils::STDIN.device();
+    } else {
+        xmlFile.setFileName(xmlExportPath);
+        if (!xmlFile.open(QIODevice::ReadOnly)) {
+            err << QObject::tr("Unable to import XML database: %1").arg(xmlFile.errorString()) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    KdbxXmlReader reader(KeePass2::FILE_VERSION_4);
+    const bool showProgress = parser->isSet(Import::ProgressOption) && !parser->isSet(Command::QuietOption);
+    if (showProgress) {
+        int lastPercent = -1;
+        int entries = 0;
+        reader.setProgressCallback([&](qint64 done, qint64 total) {
+            ++entries;
+            if (total > 0) {
+                const int percent = static_cast<int>(done * 100 / total);
+                if (percent != lastPercent) {
+                    lastPercent = percent;
+                    err << QObject::tr("Parsed %1% of the XML export").arg(percent) << Qt::endl;
+                }
+            } else if (entries % 1000 == 0) {
+                err << QObject::tr("Parsed %1 entries").arg(entries) << Qt::endl;
+            }
+        });
+    }
+
+    reader.readDatabase(xmlDevice, db.data());
+    if (reader.hasError()) {
+        err << QObject::tr("Unable to import XML database: %1").arg(reader.errorString()) << Qt::endl;
         return EXIT_FAILURE;
     }
 
+    if (showProgress) {
+        err << QObject::tr("Encrypting and writing database") << Qt::endl;
+    }
+
+    QString errorMessage;
     if (!db->saveAs(dbPath, Database::Atomic, {}, &errorMessage)) {
         err << QObject::tr("Failed to save the database: %1.").arg(errorMessage) << Qt::endl;
         return EXIT_FAILURE;
@@ -25,6 +25,8 @@ class Import : public Command
 public:
     Import();
     int execute(const QStringList& arguments) override;
+
+    static const QCommandLineOption ProgressOption;
 };
 
 #endif // KEEPASSXC_IMPORT_H
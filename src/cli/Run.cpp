@@ -0,0 +1,299 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Run.h"
+
+#include "Utils.h"
+#include "core/Group.h"
+#include "core/Tools.h"
+
+#include <QCommandLineParser>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QTemporaryFile>
+
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+const QCommandLineOption Run::EnvOption =
+    QCommandLineOption(QStringList() << "e" << "env",
+                       QObject::tr("Set the environment variable NAME of the command to the resolved template. "
+                                   "This option can be specified more than once."),
+                       QObject::tr("NAME=template"));
+
+const QCommandLineOption Run::FileOption =
+    QCommandLineOption(QStringList() << "f" << "file",
+                       QObject::tr("Write the resolved template to an anonymous file and set the environment "
+                                   "variable NAME of the command to its path. "
+                                   "This option can be specified more than once."),
+                       QObject::tr("NAME=template"));
+
+namespace
+{
+    // {{entry path#attribute}}, the attribute defaults to the password
+    const QRegularExpression PlaceholderRegex(QStringLiteral("\\{\\{([^{}]+)\\}\\}"));
+    const QRegularExpression VariableNameRegex(QStringLiteral("^[A-Za-z_][A-Za-z0-9_]*$"));
+
+    /**
+     * Secret handed to the command as a file. On Linux this is a memfd that
+     * the command inherits, elsewhere a private temporary file.
+     */
+    class SecretFile
+    {
+    public:
+        explicit SecretFile(const QString& name)
+            : m_name(name)
+        {
+        }
+
+        ~SecretFile()
+        {
+            scrub();
+        }
+
+        bool write(QByteArray data)
+        {
+            bool ok = false;
+#if defined(Q_OS_LINUX) && defined(MFD_CLOEXEC)
+            // Deliberately not close-on-exec, the command accesses it through /dev/fd
+            m_fd = memfd_create(m_name.toLatin1().constData(), 0);
+            if (m_fd >= 0) {
+                ok = ::write(m_fd, data.constData(), data.size()) == data.size() && lseek(m_fd, 0, SEEK_SET) == 0;
+                m_path = QStringLiteral("/dev/fd/%1").arg(m_fd);
+            }
+#endif
+            if (m_fd < 0) {
+                m_file.reset(new QTemporaryFile());
+                ok = m_file->open() && m_file->write(data) == data.size() && m_file->flush();
+                m_path = m_file->fileName();
+                m_file->close();
+            }
+            m_size = data.size();
+            data.fill('\0');
+            return ok;
+        }
+
+        QString path() const
+        {
+            return m_path;
+        }
+
+        void scrub()
+        {
+#if defined(Q_OS_LINUX) && defined(MFD_CLOEXEC)
+            if (m_fd >= 0) {
+                // Dropping the last reference frees the pages
+                ::close(m_fd);
+                m_fd = -1;
+            }
+#endif
+            if (m_file) {
+                if (m_file->open()) {
+                    m_file->write(QByteArray(static_cast<int>(m_size), '\0'));
+                    m_file->flush();
+                }
+                m_file.reset();
+            }
+        }
+
+    private:
+        QString m_name;
+        QString m_path;
+        int m_fd = -1;
+        qint64 m_size = 0;
+        QScopedPointer<QTemporaryFile> m_file;
+    };
+
+    /**
+     * Resolve a single "entry path#attribute" reference like the show command does.
+     */
+    bool resolveReference(const QSharedPointer<Database>& database, const QString& reference, QString& value)
+    {
+        auto& err = Utils::STDERR;
+
+        const int separator = reference.lastIndexOf('#');
+        const QString entryPath = separator >= 0 ? reference.left(separator) : reference;
+        const QString attributeName = separator >= 0 ? reference.mid(separator + 1) : EntryAttributes::PasswordKey;
+
+        Entry* entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            err << QObject::tr("Could not find entry with path %1.").arg(entryPath) << Qt::endl;
+            return false;
+        }
+
+        if (Utils::EntryFieldNames.contains(attributeName)) {
+            value = Utils::getTopLevelField(entry, attributeName);
+            return true;
+        }
+
+        const QStringList attrs = Utils::findAttributes(*entry->attributes(), attributeName);
+        if (attrs.isEmpty()) {
+            err << QObject::tr("ERROR: unknown attribute %1.").arg(attributeName) << Qt::endl;
+            return false;
+        } else if (attrs.size() > 1) {
+            err << QObject::tr("ERROR: attribute %1 is ambiguous, it matches %2.")
+                       .arg(attributeName, QLocale().createSeparatedList(attrs))
+                << Qt::endl;
+            return false;
+        }
+
+        value = entry->resolveMultiplePlaceholders(entry->attributes()->value(attrs.first()));
+        return true;
+    }
+
+    /**
+     * Replace all placeholders of the template. Each reference is resolved
+     * only once, no matter how often it is used.
+     */
+    bool resolveTemplate(const QSharedPointer<Database>& database,
+                         const QString& text,
+                         QHash<QString, QString>& resolved,
+                         QString& result)
+    {
+        bool ok = true;
+        int last = 0;
+        auto it = PlaceholderRegex.globalMatch(text);
+        while (it.hasNext()) {
+            const auto match = it.next();
+            result.append(text.midRef(last, match.capturedStart() - last));
+            last = match.capturedEnd();
+
+            const auto reference = match.captured(1);
+            if (!resolved.contains(reference)) {
+                QString value;
+                ok &= resolveReference(database, reference, value);
+                resolved.insert(reference, value);
+            }
+            result.append(resolved.value(reference));
+        }
+        result.append(text.midRef(last));
+        return ok;
+    }
+
+    bool splitAssignment(const QString& assignment, QString& name, QString& text)
+    {
+        const int separator = assignment.indexOf('=');
+        name = assignment.left(separator);
+        text = assignment.mid(separator + 1);
+        return separator > 0 && VariableNameRegex.match(name).hasMatch();
+    }
+} // namespace
+
+Run::Run()
+{
+    name = QString("run");
+    description = QObject::tr("Run a command with secrets from the database in its environment.");
+    options.append(Run::EnvOption);
+    options.append(Run::FileOption);
+    positionalArguments.append({QString("command"), QObject::tr("Command to run."), QString("")});
+    optionalArguments.append(
+        {QString("arguments"), QObject::tr("Arguments of the command."), QString("[arguments...]")});
+    variadicArguments = true;
+}
+
+int Run::executeWithDatabase(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser)
+{
+    auto& err = Utils::STDERR;
+
+    // Everything after the database is the command line, a leading -- is optional
+    QStringList args = parser->positionalArguments();
+    if (args.at(1) == QLatin1String("--")) {
+        args.removeAt(1);
+    }
+    if (args.size() < 2) {
+        err << QObject::tr("Missing positional argument(s).") << "\n\n";
+        err << getHelpText();
+        return EXIT_FAILURE;
+    }
+    const QString program = args.at(1);
+
+    // Resolve everything up front, so the command is only started if all secrets are available
+    bool ok = true;
+    QHash<QString, QString> resolved;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    for (const auto& assignment : parser->values(Run::EnvOption)) {
+        QString variable, text, value;
+        if (!splitAssignment(assignment, variable, text)) {
+            err << QObject::tr("Invalid assignment %1, expected NAME=template.").arg(assignment) << Qt::endl;
+            ok = false;
+            continue;
+        }
+        ok &= resolveTemplate(database, text, resolved, value);
+        environment.insert(variable, value);
+    }
+
+    QList<QSharedPointer<SecretFile>> files;
+    for (const auto& assignment : parser->values(Run::FileOption)) {
+        QString variable, text, value;
+        if (!splitAssignment(assignment, variable, text)) {
+            err << QObject::tr("Invalid assignment %1, expected NAME=template.").arg(assignment) << Qt::endl;
+            ok = false;
+            continue;
+        }
+        ok &= resolveTemplate(database, text, resolved, value);
+        if (!ok) {
+            continue;
+        }
+
+        auto file = QSharedPointer<SecretFile>::create(variable);
+        if (!file->write(value.toUtf8())) {
+            err << QObject::tr("Failed to write secret file for %1.").arg(variable) << Qt::endl;
+            ok = false;
+            continue;
+        }
+        environment.insert(variable, file->path());
+        files.append(file);
+    }
+    resolved.clear();
+
+    // The command may run for a long time, keep no more secrets around than it needs
+    database.reset();
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    QProcess process;
+    process.setProgram(program);
+    process.setArguments(args.mid(2));
+    process.setProcessEnvironment(environment);
+    process.setProcessChannelMode(QProcess::ForwardedChannels);
+    process.setInputChannelMode(QProcess::ForwardedInputChannel);
+    process.start();
+
+    // The child has its own copy of the environment by now
+    process.setProcessEnvironment({});
+    environment.clear();
+
+    int exitCode = EXIT_FAILURE;
+    if (!process.waitForStarted(-1)) {
+        err << QObject::tr("Failed to run %1: %2").arg(program, process.errorString()) << Qt::endl;
+    } else {
+        process.waitForFinished(-1);
+        if (process.exitStatus() == QProcess::NormalExit) {
+            exitCode = process.exitCode();
+        } else {
+            err << QObject::tr("%1 terminated abnormally.").arg(program) << Qt::endl;
+        }
+    }
+
+    for (const auto& file : asConst(files)) {
+        file->scrub();
+    }
+    return exitCode;
+}
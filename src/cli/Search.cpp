@@ -20,14 +20,27 @@
 #include <QCommandLineParser>
 
 #include "Utils.h"
+#include "config-keepassx.h"
 #include "core/EntrySearcher.h"
 #include "core/Global.h"
 #include "core/Group.h"
+#include "core/MultiDatabaseSearcher.h"
+
+const QCommandLineOption Search::DatabaseOption =
+    QCommandLineOption(QStringList() << "with",
+                       QObject::tr("Also search the given database. Can be specified multiple times."),
+                       QObject::tr("path"));
+
+const QCommandLineOption Search::SameCredentialsOption =
+    QCommandLineOption(QStringList() << "s" << "same-credentials",
+                       QObject::tr("Use the same credentials for all database files."));
 
 Search::Search()
 {
     name = QString("search");
     description = QObject::tr("Find entries quickly.");
+    options.append(Search::DatabaseOption);
+    options.append(Search::SameCredentialsOption);
     positionalArguments.append({QString("term"), QObject::tr("Search term."), QString("")});
 }
 
@@ -38,15 +51,58 @@ int Search::executeWithDatabase(QSharedPointer<Database> database, QSharedPointe
 
     const QStringList args = parser->positionalArguments();
 
-    EntrySearcher searcher;
-    auto results = searcher.search(args.at(1), database->rootGroup(), true);
+    QList<QSharedPointer<Database>> databases{database};
+    for (const auto& path : parser->values(Search::DatabaseOption)) {
+        QSharedPointer<Database> db;
+        if (parser->isSet(Search::SameCredentialsOption)) {
+            db = QSharedPointer<Database>::create();
+            QString errorMessage;
+            if (!db->open(path, database->key(), &errorMessage)) {
+                err << QObject::tr("Error reading database file %1:\n%2").arg(path, errorMessage) << Qt::endl;
+                return EXIT_FAILURE;
+            }
+        } else {
+            db = Utils::unlockDatabase(path,
+                                       !parser->isSet(Command::NoPasswordOption),
+                                       parser->value(Command::KeyFileOption),
+#ifdef WITH_XC_YUBIKEY
+                                       parser->value(Command::YubiKeyOption),
+#else
+                                       "",
+#endif
+                                       parser->isSet(Command::QuietOption));
+            if (!db) {
+                return EXIT_FAILURE;
+            }
+        }
+        databases.append(db);
+    }
+
+    if (databases.size() == 1) {
+        // A single database keeps the tree order of the results
+        EntrySearcher searcher;
+        auto results = searcher.search(args.at(1), database->rootGroup(), true);
+        if (results.isEmpty()) {
+            err << "No results for that search term." << Qt::endl;
+            return EXIT_FAILURE;
+        }
+
+        for (const Entry* result : asConst(results)) {
+            out << result->path().prepend('/') << Qt::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Results of several databases are ranked across databases
+    const auto results = MultiDatabaseSearcher::searchAll(databases, args.at(1), false, true);
     if (results.isEmpty()) {
         err << "No results for that search term." << Qt::endl;
         return EXIT_FAILURE;
     }
 
-    for (const Entry* result : asConst(results)) {
-        out << result->path().prepend('/') << Qt::endl;
+    for (const auto& result : results) {
+        // Prefix each entry with its database
+        out << result.database->filePath() << ":" << result.entry->path().prepend('/') << Qt::endl;
     }
     return EXIT_SUCCESS;
 }
@@ -26,6 +26,9 @@ public:
     Search();
 
     int executeWithDatabase(QSharedPointer<Database> db, QSharedPointer<QCommandLineParser> parser) override;
+
+    static const QCommandLineOption DatabaseOption;
+    static const QCommandLineOption SameCredentialsOption;
 };
 
 #endif // KEEPASSXC_SEARCH_H
@@ -38,7 +38,8 @@ uint Clock::currentSecondsSinceEpoch()
 
 qint64 Clock::currentMilliSecondsSinceEpoch()
 {
-    return instance().currentDateTimeImpl().toMSecsSinceEpoch();
+    // Same result as the local time but without the time zone conversion
+    return instance().currentDateTimeUtcImpl().toMSecsSinceEpoch();
 }
 
 QDateTime Clock::serialized(const QDateTime& dateTime)
@@ -0,0 +1,214 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompiledBlob.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    struct CompiledHeader
+    {
+        char magic[CompiledBlob::MagicSize];
+        qint64 sourceSize;
+        qint64 sourceMtime;
+        quint32 count;
+        quint32 dataSize;
+    };
+    static_assert(sizeof(CompiledHeader) == 32, "Unexpected compiled blob header padding");
+} // namespace
+
+/**
+ * @param magic identifier of the blob format, MagicSize characters that must outlive the blob
+ */
+CompiledBlob::CompiledBlob(const char* magic)
+    : m_magic(magic)
+{
+}
+
+// The mapping (if any) is released together with m_mappedFile
+CompiledBlob::~CompiledBlob() = default;
+
+/**
+ * Build the blob in memory from the given records, which are stored in the given order.
+ *
+ * @return false if the records do not fit into the blob format
+ */
+bool CompiledBlob::build(const QVector<QByteArray>& records, qint64 sourceSize, qint64 sourceMtime)
+{
+    detach();
+
+    qint64 dataSize = 0;
+    for (const auto& record : records) {
+        dataSize += record.size();
+    }
+    const auto indexSize = (static_cast<qint64>(records.size()) + 1) * static_cast<qint64>(sizeof(quint32));
+    const auto blobSize = static_cast<qint64>(sizeof(CompiledHeader)) + indexSize + dataSize;
+    if (blobSize > std::numeric_limits<int>::max()) {
+        return false;
+    }
+
+    CompiledHeader header;
+    std::memcpy(header.magic, m_magic, MagicSize);
+    header.sourceSize = sourceSize;
+    header.sourceMtime = sourceMtime;
+    header.count = static_cast<quint32>(records.size());
+    header.dataSize = static_cast<quint32>(dataSize);
+
+    QVector<quint32> offsets;
+    offsets.reserve(records.size() + 1);
+    quint32 offset = 0;
+    for (const auto& record : records) {
+        offsets.append(offset);
+        offset += static_cast<quint32>(record.size());
+    }
+    offsets.append(offset);
+
+    m_blob.reserve(static_cast<int>(blobSize));
+    m_blob.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_blob.append(reinterpret_cast<const char*>(offsets.constData()), static_cast<int>(indexSize));
+    for (const auto& record : records) {
+        m_blob.append(record);
+    }
+    return attach(reinterpret_cast<const uchar*>(m_blob.constData()), m_blob.size());
+}
+
+/**
+ * Map a blob saved before, if it was built from the same source file and is valid.
+ */
+bool CompiledBlob::load(const QString& cacheFile, qint64 sourceSize, qint64 sourceMtime)
+{
+    detach();
+
+    QScopedPointer<QFile> file(new QFile(cacheFile));
+    if (!file->open(QIODevice::ReadOnly) || file->size() < static_cast<qint64>(sizeof(CompiledHeader))) {
+        return false;
+    }
+
+    CompiledHeader header;
+    if (file->read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)
+        || header.sourceSize != sourceSize || header.sourceMtime != sourceMtime) {
+        return false;
+    }
+
+    auto data = file->map(0, file->size());
+    if (!data) {
+        return false;
+    }
+    if (!attach(data, file->size())) {
+        file->unmap(data);
+        return false;
+    }
+
+    m_mappedFile.reset(file.take());
+    return true;
+}
+
+/**
+ * Persist a blob built in memory, so the next process can map it directly.
+ */
+bool CompiledBlob::save(const QString& cacheFile) const
+{
+    if (m_blob.isEmpty() || !QDir().mkpath(QFileInfo(cacheFile).absolutePath())) {
+        return false;
+    }
+
+    QSaveFile compiled(cacheFile);
+    return compiled.open(QIODevice::WriteOnly) && compiled.write(m_blob) == m_blob.size() && compiled.commit();
+}
+
+int CompiledBlob::size() const
+{
+    return m_size;
+}
+
+bool CompiledBlob::isMapped() const
+{
+    return !m_mappedFile.isNull();
+}
+
+/**
+ * The record at the given index, not copied. Only valid as long as the blob.
+ */
+QByteArray CompiledBlob::record(int index) const
+{
+    if (index < 0 || index >= m_size) {
+        return {};
+    }
+    const auto begin = m_offsets[index];
+    return QByteArray::fromRawData(m_records + begin, static_cast<int>(m_offsets[index + 1] - begin));
+}
+
+/**
+ * Location of the compiled form of the given source file in the given
+ * subdirectory of the user cache directory.
+ */
+QString CompiledBlob::cachePath(const QString& directory, const QString& path)
+{
+    const auto hash = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Sha256).toHex();
+    return QStringLiteral("%1/%2/%3.bin")
+        .arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation), directory, QString::fromLatin1(hash));
+}
+
+bool CompiledBlob::attach(const uchar* data, qint64 size)
+{
+    if (size < static_cast<qint64>(sizeof(CompiledHeader))) {
+        return false;
+    }
+
+    CompiledHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const auto indexSize = (static_cast<qint64>(header.count) + 1) * static_cast<qint64>(sizeof(quint32));
+    if (std::memcmp(header.magic, m_magic, MagicSize) != 0
+        || header.count > static_cast<quint32>(std::numeric_limits<int>::max() - 1)
+        || size != static_cast<qint64>(sizeof(CompiledHeader)) + indexSize + header.dataSize) {
+        return false;
+    }
+
+    // Every record must stay within the record data
+    auto offsets = reinterpret_cast<const quint32*>(data + sizeof(CompiledHeader));
+    if (offsets[0] != 0 || offsets[header.count] != header.dataSize) {
+        return false;
+    }
+    for (quint32 i = 0; i < header.count; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+
+    m_offsets = offsets;
+    m_records = reinterpret_cast<const char*>(data + sizeof(CompiledHeader) + indexSize);
+    m_size = static_cast<int>(header.count);
+    return true;
+}
+
+void CompiledBlob::detach()
+{
+    m_mappedFile.reset();
+    m_blob.clear();
+    m_offsets = nullptr;
+    m_records = nullptr;
+    m_size = 0;
+}
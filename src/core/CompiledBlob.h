@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_COMPILEDBLOB_H
+#define KEEPASSXC_COMPILEDBLOB_H
+
+#include <QByteArray>
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+class QFile;
+
+/**
+ * Compiled list of variable sized records, built in memory or memory mapped
+ * from a cache file. Used by PassphraseWordList and PasswordDictionary to
+ * keep large lists in a form that only has to be parsed once.
+ *
+ * Layout (host byte order, only ever read back on the same machine):
+ *   char    magic[8]
+ *   qint64  source file size
+ *   qint64  source file mtime (ms since epoch)
+ *   quint32 record count (n)
+ *   quint32 record data size
+ *   quint32 offsets[n + 1]
+ *   char    record data
+ *
+ * Cache files may be truncated or tampered with, so the header and every
+ * offset are validated before a blob is used.
+ */
+class CompiledBlob
+{
+public:
+    explicit CompiledBlob(const char* magic);
+    ~CompiledBlob();
+    Q_DISABLE_COPY(CompiledBlob)
+
+    bool build(const QVector<QByteArray>& records, qint64 sourceSize = 0, qint64 sourceMtime = 0);
+    bool load(const QString& cacheFile, qint64 sourceSize, qint64 sourceMtime);
+    bool save(const QString& cacheFile) const;
+
+    int size() const;
+    bool isMapped() const;
+    QByteArray record(int index) const;
+
+    static QString cachePath(const QString& directory, const QString& path);
+
+    static const int MagicSize = 8;
+
+private:
+    bool attach(const uchar* data, qint64 size);
+    void detach();
+
+    const char* m_magic;
+    QScopedPointer<QFile> m_mappedFile;
+    QByteArray m_blob;
+    const quint32* m_offsets = nullptr;
+    const char* m_records = nullptr;
+    int m_size = 0;
+};
+
+#endif // KEEPASSXC_COMPILEDBLOB_H
@@ -48,6 +48,7 @@ public:
         UseAtomicSaves,
         UseDirectWriteSaves,
         SearchLimitGroup,
+        SearchAllDatabases,
         MinimizeOnOpenUrl,
         OpenURLOnDoubleClick,
         HideWindowOnCopy,
@@ -66,6 +67,7 @@ public:
         GlobalAutoTypeModifiers,
         GlobalAutoTypeRetypeTime,
         FaviconDownloadTimeout,
+        FaviconDiskCache,
         UpdateCheckMessageShown,
         DefaultDatabaseFileName,
 
@@ -132,6 +134,7 @@ public:
         Security_EnableCopyOnDoubleClick,
         Security_QuickUnlock,
         Security_DatabasePasswordMinimumQuality,
+        Security_PasswordDictionaryFile,
 
         Browser_Enabled,
         Browser_ShowNotification,
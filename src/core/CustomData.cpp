@@ -38,17 +38,23 @@ CustomData::CustomData(QObject* parent)
 
 QList<QString> CustomData::keys() const
 {
-    return m_data.keys();
+    QList<QString> keys;
+    keys.reserve(m_data.size());
+    for (const auto& data : m_data) {
+        keys.append(data.key);
+    }
+    return keys;
 }
 
 bool CustomData::hasKey(const QString& key) const
 {
-    return m_data.contains(key);
+    return indexOf(key) != -1;
 }
 
 QString CustomData::value(const QString& key) const
 {
-    return m_data.value(key).value;
+    const int index = indexOf(key);
+    return index != -1 ? m_data[index].item.value : QString();
 }
 
 QString CustomData::getKeyWithPrefix(const QString& prefix, const QString& key)
@@ -62,23 +68,23 @@ QString CustomData::getKeyWithPrefix(const QString& prefix, const QString& key)
 
 const CustomData::CustomDataItem& CustomData::item(const QString& key) const
 {
-    auto item = m_data.find(key);
-    Q_ASSERT(item != m_data.end());
-    if (item == m_data.end()) {
+    const int index = indexOf(key);
+    Q_ASSERT(index != -1);
+    if (index == -1) {
         return NULL_ITEM;
     }
-    return item.value();
+    return m_data[index].item;
 }
 
 bool CustomData::contains(const QString& key) const
 {
-    return m_data.contains(key);
+    return indexOf(key) != -1;
 }
 
 bool CustomData::containsValue(const QString& value) const
 {
-    for (auto i = m_data.constBegin(); i != m_data.constEnd(); ++i) {
-        if (i.value().value == value) {
+    for (const auto& data : m_data) {
+        if (data.item.value == value) {
             return true;
         }
     }
@@ -87,8 +93,9 @@ bool CustomData::containsValue(const QString& value) const
 
 void CustomData::set(const QString& key, CustomDataItem item)
 {
-    bool addAttribute = !m_data.contains(key);
-    bool changeValue = !addAttribute && (m_data.value(key).value != item.value);
+    const int index = indexOf(key);
+    bool addAttribute = index == -1;
+    bool changeValue = !addAttribute && (m_data.at(index).item.value != item.value);
 
     if (addAttribute) {
         emit aboutToBeAdded(key);
@@ -98,7 +105,7 @@ void CustomData::set(const QString& key, CustomDataItem item)
         item.lastModified = Clock::currentDateTimeUtc();
     }
     if (addAttribute || changeValue) {
-        m_data.insert(key, item);
+        insert(key, item);
         updateLastModified();
         emitModified();
     }
@@ -117,8 +124,9 @@ void CustomData::remove(const QString& key)
 {
     emit aboutToBeRemoved(key);
 
-    if (m_data.contains(key)) {
-        m_data.remove(key);
+    const int index = indexOf(key);
+    if (index != -1) {
+        m_data.remove(index);
         updateLastModified();
         emitModified();
     }
@@ -128,20 +136,19 @@ void CustomData::remove(const QString& key)
 
 void CustomData::rename(const QString& oldKey, const QString& newKey)
 {
-    const bool containsOldKey = m_data.contains(oldKey);
-    const bool containsNewKey = m_data.contains(newKey);
+    const int oldIndex = indexOf(oldKey);
+    const bool containsOldKey = oldIndex != -1;
+    const bool containsNewKey = contains(newKey);
     Q_ASSERT(containsOldKey && !containsNewKey);
     if (!containsOldKey || containsNewKey) {
         return;
     }
 
-    CustomDataItem data = m_data.value(oldKey);
-
     emit aboutToRename(oldKey, newKey);
 
-    m_data.remove(oldKey);
-    data.lastModified = Clock::currentDateTimeUtc();
-    m_data.insert(newKey, data);
+    auto& data = m_data[oldIndex];
+    data.key = newKey;
+    data.item.lastModified = Clock::currentDateTimeUtc();
 
     updateLastModified();
     emitModified();
@@ -165,15 +172,16 @@ void CustomData::copyDataFrom(const CustomData* other)
 
 QDateTime CustomData::lastModified() const
 {
-    if (m_data.contains(LastModified)) {
-        return Clock::parse(m_data.value(LastModified).value);
+    const int index = indexOf(LastModified);
+    if (index != -1) {
+        return Clock::parse(m_data[index].item.value);
     }
 
     // Try to find the latest modification time in items as a fallback
     QDateTime modified;
-    for (auto i = m_data.constBegin(); i != m_data.constEnd(); ++i) {
-        if (i->lastModified.isValid() && (!modified.isValid() || i->lastModified > modified)) {
-            modified = i->lastModified;
+    for (const auto& data : m_data) {
+        if (data.item.lastModified.isValid() && (!modified.isValid() || data.item.lastModified > modified)) {
+            modified = data.item.lastModified;
         }
     }
     return modified;
@@ -181,20 +189,24 @@ QDateTime CustomData::lastModified() const
 
 QDateTime CustomData::lastModified(const QString& key) const
 {
-    return m_data.value(key).lastModified;
+    const int index = indexOf(key);
+    return index != -1 ? m_data[index].item.lastModified : QDateTime();
 }
 
 void CustomData::updateLastModified(QDateTime lastModified)
 {
-    if (m_data.isEmpty() || (m_data.size() == 1 && m_data.contains(LastModified))) {
-        m_data.remove(LastModified);
+    const int index = indexOf(LastModified);
+    if (m_data.isEmpty() || (m_data.size() == 1 && index != -1)) {
+        if (index != -1) {
+            m_data.remove(index);
+        }
         return;
     }
 
     if (!lastModified.isValid()) {
         lastModified = Clock::currentDateTimeUtc();
     }
-    m_data.insert(LastModified, {lastModified.toString(), QDateTime()});
+    insert(LastModified, {lastModified.toString(), QDateTime()});
 }
 
 bool CustomData::isProtected(const QString& key) const
@@ -210,12 +222,22 @@ bool CustomData::isAutoGenerated(const QString& key) const
 
 bool CustomData::operator==(const CustomData& other) const
 {
-    return (m_data == other.m_data);
+    // Item order does not matter
+    if (m_data.size() != other.m_data.size()) {
+        return false;
+    }
+    for (const auto& data : m_data) {
+        const int index = other.indexOf(data.key);
+        if (index == -1 || !(other.m_data[index].item == data.item)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool CustomData::operator!=(const CustomData& other) const
 {
-    return (m_data != other.m_data);
+    return !(*this == other);
 }
 
 void CustomData::clear()
@@ -242,15 +264,32 @@ int CustomData::dataSize() const
 {
     int size = 0;
 
-    QHashIterator<QString, CustomDataItem> i(m_data);
-    while (i.hasNext()) {
-        i.next();
-
+    for (const auto& data : m_data) {
         // In theory, we should be adding the datetime string size as well, but it makes
         // length calculations rather unpredictable. We also don't know if this instance
         // is entry/group-level CustomData or global CustomData (the only CustomData that
         // actually retains the datetime in the KDBX file).
-        size += i.key().toUtf8().size() + i.value().value.toUtf8().size();
+        size += data.key.toUtf8().size() + data.item.value.toUtf8().size();
     }
     return size;
 }
+
+int CustomData::indexOf(const QString& key) const
+{
+    for (int i = 0; i < m_data.size(); ++i) {
+        if (m_data[i].key == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CustomData::insert(const QString& key, const CustomDataItem& item)
+{
+    const int index = indexOf(key);
+    if (index != -1) {
+        m_data[index].item = item;
+    } else {
+        m_data.append({key, item});
+    }
+}
@@ -19,8 +19,8 @@
 #define KEEPASSXC_CUSTOMDATA_H
 
 #include <QDateTime>
-#include <QHash>
 #include <QObject>
+#include <QVector>
 
 #include "core/ModifiableObject.h"
 
@@ -91,7 +91,19 @@ private slots:
     void updateLastModified(QDateTime lastModified = {});
 
 private:
-    QHash<QString, CustomDataItem> m_data;
+    struct KeyedItem
+    {
+        QString key;
+        CustomDataItem item;
+    };
+
+    int indexOf(const QString& key) const;
+    void insert(const QString& key, const CustomDataItem& item);
+
+    // Most entries and groups carry no items and the others only a few, so a
+    // flat vector searched linearly is enough. An empty vector is a single
+    // shared null pointer and allocates nothing.
+    QVector<KeyedItem> m_data;
 };
 
 #endif // KEEPASSXC_CUSTOMDATA_H
@@ -19,6 +19,7 @@
 #include "Database.h"
 
 #include "core/AsyncTask.h"
+#include "core/ExpiryIndex.h"
 #include "core/FileWatcher.h"
 #include "core/Group.h"
 #include "crypto/Random.h"
@@ -37,6 +38,12 @@
 #include <Windows.h>
 #endif
 
+namespace
+{
+    // Beyond this, objectsModified() reports a bulk change instead of single objects
+    const int MaxTrackedModifiedObjects = 1000;
+} // namespace
+
 QHash<QUuid, QPointer<Database>> Database::s_uuidMap;
 
 Database::Database()
@@ -44,6 +51,7 @@ Database::Database()
     , m_data()
     , m_rootGroup(nullptr)
     , m_fileWatcher(new FileWatcher(this))
+    , m_expiryIndex(new ExpiryIndex(this))
     , m_uuid(QUuid::createUuid())
 {
     // setup modified timer
@@ -53,7 +61,7 @@ Database::Database()
             stopModifiedTimer();
         }
     });
-    connect(&m_modifiedTimer, &QTimer::timeout, this, &Database::emitModified);
+    connect(&m_modifiedTimer, &QTimer::timeout, this, &Database::emitPendingModified);
 
     // other signals
     connect(m_metadata, &Metadata::modified, this, &Database::markAsModified);
@@ -61,9 +69,10 @@ Database::Database()
         updateCommonUsernames();
         updateTagList();
     });
-    connect(this, &Database::modified, this, [this] { updateTagList(); });
     connect(this, &Database::databaseSaved, this, [this]() { updateCommonUsernames(); });
     connect(m_fileWatcher, &FileWatcher::fileChanged, this, &Database::databaseFileChanged);
+    connect(m_expiryIndex, &ExpiryIndex::entryExpired, this, &Database::entryExpired);
+    connect(m_expiryIndex, &ExpiryIndex::groupExpired, this, &Database::groupExpired);
 
     // static uuid map
     s_uuidMap.insert(m_uuid, this);
@@ -612,6 +621,14 @@ const Metadata* Database::metadata() const
     return m_metadata;
 }
 
+/**
+ * Scheduler for the expiry of the entries and groups of this database.
+ */
+ExpiryIndex* Database::expiryIndex()
+{
+    return m_expiryIndex;
+}
+
 /**
  * Returns the original file path that was provided for
  * this database. This path may not exist, may contain
@@ -719,8 +736,8 @@ void Database::updateCommonUsernames(int topN)
 
 void Database::updateTagList()
 {
-    m_tagList.clear();
     if (!m_rootGroup) {
+        m_tagList.clear();
         emit tagListUpdated();
         return;
     }
@@ -736,9 +753,12 @@ void Database::updateTagList()
         }
     }
 
-    m_tagList = tagSet.values();
-    m_tagList.sort();
-    emit tagListUpdated();
+    auto tagList = tagSet.values();
+    tagList.sort();
+    if (tagList != m_tagList) {
+        m_tagList = tagList;
+        emit tagListUpdated();
+    }
 }
 
 void Database::removeTag(const QString& tag)
@@ -947,26 +967,100 @@ bool Database::isModified() const
     return m_modified;
 }
 
+/**
+ * Number of changes since the database object was created. Allows callers
+ * to validate caches without waiting for the delayed modified() signal.
+ */
+quint64 Database::modificationCount() const
+{
+    return m_modificationCount;
+}
+
 bool Database::hasNonDataChanges() const
 {
     return m_hasNonDataChange;
 }
 
 void Database::markAsModified()
+{
+    markObjectModified(nullptr);
+}
+
+/**
+ * Mark the database as modified because the given entry or group changed.
+ * The object is reported by the next objectsModified() notification; other
+ * objects and nullptr only mark the database as modified.
+ */
+void Database::markObjectModified(QObject* object)
 {
     m_modified = true;
-    if (modifiedSignalEnabled() && !m_modifiedTimer.isActive()) {
+    ++m_modificationCount;
+    if (!modifiedSignalEnabled()) {
+        return;
+    }
+
+    // Remember which entry or group changed for the coalesced notification
+    if (qobject_cast<Entry*>(object) || qobject_cast<Group*>(object)) {
+        QMutexLocker locker(&m_modifiedObjectsMutex);
+        if (!m_modifiedObjectsOverflow && !m_modifiedObjectSet.contains(object)) {
+            if (m_modifiedObjects.size() >= MaxTrackedModifiedObjects) {
+                m_modifiedObjectsOverflow = true;
+                m_modifiedObjects.clear();
+                m_modifiedObjectSet.clear();
+            } else {
+                m_modifiedObjectSet.insert(object);
+                m_modifiedObjects.append(object);
+            }
+        }
+    }
+
+    if (!m_modifiedTimer.isActive()) {
         // Small time delay prevents numerous consecutive saves due to repeated signals
         startModifiedTimer();
     }
 }
 
+/**
+ * Emit a single modified() and objectsModified() notification for all
+ * changes since the last one. If too many objects changed to track them
+ * individually, the list of objects is empty and overflow is set. An empty
+ * list without overflow means only changes not tied to an entry or group.
+ */
+void Database::emitPendingModified()
+{
+    QList<QPointer<QObject>> objects;
+    bool overflow;
+    {
+        QMutexLocker locker(&m_modifiedObjectsMutex);
+        objects.swap(m_modifiedObjects);
+        m_modifiedObjectSet.clear();
+        overflow = m_modifiedObjectsOverflow;
+        m_modifiedObjectsOverflow = false;
+    }
+    objects.removeAll(nullptr);
+
+    if (!modifiedSignalEnabled()) {
+        return;
+    }
+
+    updateTagList();
+    emitModified();
+    emit objectsModified(objects, overflow);
+}
+
 void Database::markAsClean()
 {
     bool emitSignal = m_modified;
     m_modified = false;
     stopModifiedTimer();
     m_hasNonDataChange = false;
+    {
+        // Changes before the save are not reported with later notifications
+        QMutexLocker locker(&m_modifiedObjectsMutex);
+        m_modifiedObjects.clear();
+        m_modifiedObjectSet.clear();
+        m_modifiedObjectsOverflow = false;
+    }
     if (emitSignal) {
         emit databaseSaved();
     }
@@ -23,6 +23,7 @@
 #include <QHash>
 #include <QMutex>
 #include <QPointer>
+#include <QSet>
 #include <QTimer>
 
 #include "config-keepassx.h"
@@ -34,6 +35,7 @@
 
 class Entry;
 enum class EntryReferenceType;
+class ExpiryIndex;
 class FileWatcher;
 class Group;
 class Metadata;
@@ -99,6 +101,7 @@ public:
 
     bool isInitialized() const;
     bool isModified() const;
+    quint64 modificationCount() const;
     bool hasNonDataChanges() const;
     bool isSaving();
 
@@ -117,6 +120,7 @@ public:
 
     Metadata* metadata();
     const Metadata* metadata() const;
+    ExpiryIndex* expiryIndex();
     Group* rootGroup();
     const Group* rootGroup() const;
     Q_REQUIRED_RESULT Group* setRootGroup(Group* group);
@@ -164,6 +168,7 @@ public:
 
 public slots:
     void markAsModified();
+    void markObjectModified(QObject* object);
     void markAsClean();
     void updateCommonUsernames(int topN = 10);
     void updateTagList();
@@ -184,6 +189,9 @@ signals:
     void databaseFileChanged();
     void databaseNonDataChanged();
     void tagListUpdated();
+    void entryExpired(Entry* entry);
+    void groupExpired(Group* group);
+    void objectsModified(const QList<QPointer<QObject>>& objects, bool overflow);
 
 private:
     struct DatabaseData
@@ -232,6 +240,7 @@ private:
 
     void startModifiedTimer();
     void stopModifiedTimer();
+    void emitPendingModified();
 
     QPointer<Metadata> const m_metadata;
     DatabaseData m_data;
@@ -240,7 +249,15 @@ private:
     QTimer m_modifiedTimer;
     QMutex m_saveMutex;
     QPointer<FileWatcher> m_fileWatcher;
+    QPointer<ExpiryIndex> m_expiryIndex;
     bool m_modified = false;
+    // Incremented immediately on every change, unlike the delayed modified() signal
+    quint64 m_modificationCount = 0;
+    // Objects that changed since the last modified() notification, changes may come from worker threads
+    QMutex m_modifiedObjectsMutex;
+    QList<QPointer<QObject>> m_modifiedObjects;
+    QSet<const QObject*> m_modifiedObjectSet;
+    bool m_modifiedObjectsOverflow = false;
     bool m_hasNonDataChange = false;
     QString m_keyError;
     bool m_isTemporaryDatabase = false;
@@ -0,0 +1,334 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DuplicateFinder.h"
+
+#include "core/Clock.h"
+#include "core/Database.h"
+#include "core/Global.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "core/Totp.h"
+
+#include <QCryptographicHash>
+#include <QMap>
+#include <QUrl>
+
+#include <algorithm>
+
+namespace
+{
+    // Second level labels under which country code domains are registered, e.g. example.co.uk
+    const QStringList SecondLevelLabels = {"ac", "co", "com", "edu", "go", "gov", "ltd", "ne", "net", "or", "org"};
+
+    QByteArray signatureHash(DuplicateFinder::Match match, const QString& value)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        const auto type = static_cast<char>(match);
+        hash.addData(&type, 1);
+        hash.addData(value.toUtf8());
+        return hash.result();
+    }
+
+    QString resolved(const Entry* entry, const QString& value)
+    {
+        return EntryAttributes::matchReference(value).hasMatch() ? entry->resolveMultiplePlaceholders(value) : value;
+    }
+} // namespace
+
+DuplicateFinder::DuplicateFinder(Database* db, QObject* parent)
+    : QObject(parent)
+    , m_db(db)
+{
+    if (db) {
+        connect(db, &Database::objectsModified, this, &DuplicateFinder::objectsModified);
+    }
+}
+
+DuplicateFinder::~DuplicateFinder() = default;
+
+/**
+ * All sets of at least two entries sharing a signature, largest sets first.
+ * Recycled entries are ignored. An entry can be part of several sets, e.g.
+ * of a login and a TOTP match.
+ */
+QList<DuplicateFinder::Duplicates> DuplicateFinder::duplicates()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_dirty) {
+        rebuild();
+    }
+
+    QList<Duplicates> result;
+    for (const auto& bucket : asConst(m_buckets)) {
+        if (bucket.entries.size() < 2) {
+            continue;
+        }
+
+        Duplicates duplicates{bucket.match, bucket.description, {}};
+        for (const auto& entry : bucket.entries) {
+            if (entry && entry->database() == m_db && !entry->isRecycled()) {
+                duplicates.entries.append(entry);
+            }
+        }
+        if (duplicates.entries.size() > 1) {
+            result.append(duplicates);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Duplicates& lhs, const Duplicates& rhs) {
+        if (lhs.entries.size() != rhs.entries.size()) {
+            return lhs.entries.size() > rhs.entries.size();
+        }
+        if (lhs.match != rhs.match) {
+            return lhs.match < rhs.match;
+        }
+        return lhs.description < rhs.description;
+    });
+    return result;
+}
+
+/**
+ * Merge duplicate entries into the most recently modified one. The other
+ * entries and their history become history items of the kept entry and are
+ * then moved to the recycle bin. Every distinct revision is kept, only
+ * identical revisions with the same modification time are merged, and the
+ * history is not truncated to the history limits of the database.
+ *
+ * @param entries duplicate entries
+ * @param deletePermanently allow deleting the merged entries if the recycle bin is disabled
+ * @return the kept entry, nullptr if the merged entries could not be recycled
+ */
+Entry* DuplicateFinder::merge(const QList<Entry*>& entries, bool deletePermanently)
+{
+    QList<Entry*> sources;
+    for (auto entry : entries) {
+        if (entry && !sources.contains(entry)) {
+            sources.append(entry);
+        }
+    }
+    if (sources.size() < 2) {
+        return sources.value(0);
+    }
+
+    auto db = sources.first()->database();
+    if (db && !db->metadata()->recycleBinEnabled() && !deletePermanently) {
+        return nullptr;
+    }
+
+    auto target = *std::max_element(sources.begin(), sources.end(), [](const Entry* lhs, const Entry* rhs) {
+        return lhs->timeInfo().lastModificationTime() < rhs->timeInfo().lastModificationTime();
+    });
+    sources.removeOne(target);
+
+    // Revisions are ordered by modification time, only identical ones are dropped
+    const auto compareOptions = CompareItemIgnoreMilliseconds | CompareItemIgnoreHistory | CompareItemIgnoreLocation
+                                | CompareItemIgnoreStatistics;
+    QMultiMap<QDateTime, Entry*> merged;
+    const auto targetHistoryItems = target->historyItems();
+    for (auto historyItem : targetHistoryItems) {
+        merged.insert(Clock::serialized(historyItem->timeInfo().lastModificationTime()),
+                      historyItem->clone(Entry::CloneNoFlags));
+    }
+    for (auto source : asConst(sources)) {
+        auto items = source->historyItems();
+        items.append(source);
+        for (auto item : asConst(items)) {
+            const auto modificationTime = Clock::serialized(item->timeInfo().lastModificationTime());
+            auto historyItem = item->clone(Entry::CloneNoFlags);
+            historyItem->setUpdateTimeinfo(false);
+            historyItem->setUuid(target->uuid());
+            historyItem->setUpdateTimeinfo(true);
+
+            const auto sameTime = merged.values(modificationTime);
+            const bool known = std::any_of(sameTime.cbegin(), sameTime.cend(), [&](const Entry* other) {
+                return other->equals(historyItem, compareOptions);
+            });
+            if (known) {
+                delete historyItem;
+                continue;
+            }
+            merged.insert(modificationTime, historyItem);
+        }
+    }
+
+    const bool blockedSignals = target->blockSignals(true);
+    const bool updateTimeInfo = target->canUpdateTimeinfo();
+    target->setUpdateTimeinfo(false);
+    target->removeHistoryItems(targetHistoryItems);
+    for (auto historyItem : asConst(merged)) {
+        target->addHistoryItem(historyItem);
+    }
+    target->setUpdateTimeinfo(updateTimeInfo);
+    target->blockSignals(blockedSignals);
+
+    for (auto source : asConst(sources)) {
+        if (db) {
+            db->recycleEntry(source);
+        } else {
+            delete source;
+        }
+    }
+
+    return target;
+}
+
+/**
+ * Domain under which the host of the URL is registered, e.g. example.co.uk
+ * for https://login.example.co.uk/. The core library has no access to the
+ * public suffix list, so country code second level domains are recognized
+ * by their usual labels. IP addresses and single label hosts are returned as is.
+ */
+QString DuplicateFinder::registrableDomain(const QString& url)
+{
+    const auto trimmed = url.trimmed();
+    if (trimmed.isEmpty()) {
+        return {};
+    }
+
+    const auto host = QUrl::fromUserInput(trimmed).host().toLower();
+    if (host.isEmpty() || host.contains(':') || !host.contains('.') || host.back().isDigit()) {
+        return host;
+    }
+
+    const auto labels = host.split('.', Qt::SkipEmptyParts);
+    int count = 2;
+    if (labels.size() > 2 && labels.last().size() == 2 && SecondLevelLabels.contains(labels.at(labels.size() - 2))) {
+        count = 3;
+    }
+    return labels.mid(qMax(0, labels.size() - count)).join('.');
+}
+
+void DuplicateFinder::objectsModified(const QList<QPointer<QObject>>& objects, bool overflow)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_dirty) {
+        return;
+    }
+    if (overflow) {
+        // Too many changes to track them individually
+        m_dirty = true;
+        return;
+    }
+
+    for (const auto& object : objects) {
+        auto entry = qobject_cast<Entry*>(object.data());
+        if (!entry) {
+            // Group changes can add, move or remove any number of entries
+            m_dirty = true;
+            return;
+        }
+
+        remove(entry->uuid());
+        if (entry->group() && entry->database() == m_db && !entry->isRecycled()) {
+            insert(entry);
+        }
+    }
+}
+
+QVector<DuplicateFinder::Signature> DuplicateFinder::signatures(const Entry* entry)
+{
+    QVector<Signature> result;
+
+    const auto domain = registrableDomain(resolved(entry, entry->url()));
+    const auto username = resolved(entry, entry->username()).trimmed();
+    if (!domain.isEmpty() && !username.isEmpty()) {
+        result.append({signatureHash(Match::Login, domain + '\n' + username.toLower()),
+                       Match::Login,
+                       QString("%1 / %2").arg(domain, username)});
+    }
+
+    if (entry->hasTotp()) {
+        auto secret = entry->totpSettings()->key.toUpper();
+        secret.remove(' ');
+        secret.remove('=');
+        if (!secret.isEmpty()) {
+            result.append({signatureHash(Match::Totp, secret), Match::Totp, {}});
+        }
+    }
+
+    const auto attributes = entry->attributes();
+    const auto credentialId = attributes->value(EntryAttributes::KPEX_PASSKEY_CREDENTIAL_ID);
+    if (!credentialId.isEmpty()) {
+        const auto relyingParty = attributes->value(EntryAttributes::KPEX_PASSKEY_RELYING_PARTY);
+        result.append(
+            {signatureHash(Match::Passkey, relyingParty + '\n' + credentialId), Match::Passkey, relyingParty});
+    }
+
+    return result;
+}
+
+/**
+ * Index all entries of the database, called with the mutex held.
+ */
+void DuplicateFinder::rebuild()
+{
+    m_buckets.clear();
+    m_entrySignatures.clear();
+    m_dirty = false;
+    if (!m_db || !m_db->rootGroup()) {
+        return;
+    }
+
+    const auto entries = m_db->rootGroup()->entriesRecursive();
+    m_buckets.reserve(entries.size());
+    m_entrySignatures.reserve(entries.size());
+    for (auto entry : entries) {
+        if (!entry->isRecycled()) {
+            insert(entry);
+        }
+    }
+}
+
+void DuplicateFinder::insert(Entry* entry)
+{
+    const auto entrySignatures = signatures(entry);
+    if (entrySignatures.isEmpty()) {
+        return;
+    }
+
+    QVector<QByteArray> hashes;
+    hashes.reserve(entrySignatures.size());
+    for (const auto& signature : entrySignatures) {
+        auto it = m_buckets.find(signature.hash);
+        if (it == m_buckets.end()) {
+            it = m_buckets.insert(signature.hash, {signature.match, signature.description, {}});
+        }
+        it->entries.append(entry);
+        hashes.append(signature.hash);
+    }
+    m_entrySignatures.insert(entry->uuid(), hashes);
+}
+
+void DuplicateFinder::remove(const QUuid& uuid)
+{
+    const auto hashes = m_entrySignatures.take(uuid);
+    for (const auto& hash : hashes) {
+        auto it = m_buckets.find(hash);
+        if (it == m_buckets.end()) {
+            continue;
+        }
+        auto& entries = it->entries;
+        entries.erase(std::remove_if(entries.begin(),
+                                     entries.end(),
+                                     [&uuid](const QPointer<Entry>& entry) { return !entry || entry->uuid() == uuid; }),
+                      entries.end());
+        if (entries.isEmpty()) {
+            m_buckets.erase(it);
+        }
+    }
+}
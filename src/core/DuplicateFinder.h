@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_DUPLICATEFINDER_H
+#define KEEPASSXC_DUPLICATEFINDER_H
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QUuid>
+#include <QVector>
+
+class Database;
+class Entry;
+
+/**
+ * Finds entries of a database that describe the same account.
+ *
+ * Every entry gets normalized signatures: the registrable domain of its URL
+ * together with the username, the TOTP secret and the passkey credential ID.
+ * The signatures are hashed into buckets, so all duplicate sets are found in
+ * linear time and no secret is kept in the index. The index follows the
+ * entries reported by Database::objectsModified() and is only rebuilt from
+ * scratch after group or bulk changes.
+ */
+class DuplicateFinder : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Match
+    {
+        Login,
+        Totp,
+        Passkey
+    };
+
+    struct Duplicates
+    {
+        Match match;
+        // Domain and username of a login match, relying party of a passkey match
+        QString description;
+        QList<Entry*> entries;
+    };
+
+    explicit DuplicateFinder(Database* db, QObject* parent = nullptr);
+    ~DuplicateFinder() override;
+
+    QList<Duplicates> duplicates();
+
+    static Entry* merge(const QList<Entry*>& entries, bool deletePermanently = false);
+    static QString registrableDomain(const QString& url);
+
+private slots:
+    void objectsModified(const QList<QPointer<QObject>>& objects, bool overflow);
+
+private:
+    struct Signature
+    {
+        QByteArray hash;
+        Match match;
+        QString description;
+    };
+
+    struct Bucket
+    {
+        Match match;
+        QString description;
+        QVector<QPointer<Entry>> entries;
+    };
+
+    static QVector<Signature> signatures(const Entry* entry);
+    void rebuild();
+    void insert(Entry* entry);
+    void remove(const QUuid& uuid);
+
+    QPointer<Database> m_db;
+    QMutex m_mutex;
+    bool m_dirty = true;
+    QHash<QByteArray, Bucket> m_buckets;
+    QHash<QUuid, QVector<QByteArray>> m_entrySignatures;
+};
+
+#endif // KEEPASSXC_DUPLICATEFINDER_H
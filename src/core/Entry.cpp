@@ -20,6 +20,7 @@
 
 #include "core/Config.h"
 #include "core/Database.h"
+#include "core/ExpiryIndex.h"
 #include "core/Global.h"
 #include "core/Group.h"
 #include "core/Metadata.h"
@@ -49,6 +50,8 @@ Entry::Entry()
     , m_customData(new CustomData(this))
     , m_modifiedSinceBegin(false)
     , m_updateTimeinfo(true)
+    , m_expiryTime(ExpiryIndex::Never)
+    , m_iconUseHistory(false)
 {
     m_data.iconNumber = DefaultIconNumber;
     m_data.autoTypeEnabled = true;
@@ -69,6 +72,9 @@ Entry::Entry()
 Entry::~Entry()
 {
     setUpdateTimeinfo(false);
+    if (m_iconUseMetadata) {
+        m_iconUseMetadata->removeCustomIconUse(m_iconUseUuid, this, m_iconUseHistory);
+    }
     if (m_group) {
         m_group->removeEntry(this);
 
@@ -457,7 +463,52 @@ bool Entry::isExpired() const
 
 bool Entry::willExpireInDays(int days) const
 {
-    return m_data.timeInfo.expires() && m_data.timeInfo.expiryTime() < Clock::currentDateTime().addDays(days);
+    return m_expiryTime != ExpiryIndex::Never
+           && m_expiryTime < Clock::currentMilliSecondsSinceEpoch() + days * qint64(24 * 3600 * 1000);
+}
+
+/**
+ * Refresh the cached expiry time after the expiry settings changed and
+ * schedule the expiry notification with the database.
+ */
+void Entry::updateExpiryState()
+{
+    m_expiryTime = m_data.timeInfo.expires() ? m_data.timeInfo.expiryTime().toMSecsSinceEpoch() : ExpiryIndex::Never;
+
+    auto db = database();
+    if (db) {
+        db->expiryIndex()->schedule(this);
+    }
+}
+
+/**
+ * Register the custom icon of this entry or history item with the
+ * metadata of the owning database, keeping the icon usage index current.
+ */
+void Entry::updateCustomIconUse()
+{
+    const bool historyItem = !m_group && m_historyOwner;
+    auto db = historyItem ? m_historyOwner->database() : database();
+    Metadata* metadata = db && !m_data.customIcon.isNull() ? db->metadata() : nullptr;
+
+    if (metadata != m_iconUseMetadata || m_data.customIcon != m_iconUseUuid || historyItem != m_iconUseHistory) {
+        if (m_iconUseMetadata) {
+            m_iconUseMetadata->removeCustomIconUse(m_iconUseUuid, this, m_iconUseHistory);
+        }
+        m_iconUseMetadata = metadata;
+        m_iconUseUuid = m_data.customIcon;
+        m_iconUseHistory = historyItem;
+        if (metadata) {
+            metadata->addCustomIconUse(m_iconUseUuid, this, historyItem);
+        }
+    }
+
+    // History items follow the database of their owner
+    if (!historyItem) {
+        for (Entry* item : asConst(m_history)) {
+            item->updateCustomIconUse();
+        }
+    }
 }
 
 void Entry::expireNow()
@@ -647,6 +698,7 @@ void Entry::setIcon(int iconNumber)
     if (m_data.iconNumber != iconNumber || !m_data.customIcon.isNull()) {
         m_data.iconNumber = iconNumber;
         m_data.customIcon = QUuid();
+        updateCustomIconUse();
 
         emitModified();
         emitDataChanged();
@@ -660,6 +712,7 @@ void Entry::setIcon(const QUuid& uuid)
     if (m_data.customIcon != uuid) {
         m_data.customIcon = uuid;
         m_data.iconNumber = 0;
+        updateCustomIconUse();
 
         emitModified();
         emitDataChanged();
@@ -722,6 +775,7 @@ void Entry::removeTag(const QString& tag)
 void Entry::setTimeInfo(const TimeInfo& timeInfo)
 {
     m_data.timeInfo = timeInfo;
+    updateExpiryState();
 }
 
 void Entry::setAutoTypeEnabled(bool enable)
@@ -787,6 +841,7 @@ void Entry::setExpires(const bool& value)
 {
     if (m_data.timeInfo.expires() != value) {
         m_data.timeInfo.setExpires(value);
+        updateExpiryState();
         emitModified();
     }
 }
@@ -795,6 +850,7 @@ void Entry::setExpiryTime(const QDateTime& dateTime)
 {
     if (m_data.timeInfo.expiryTime() != dateTime) {
         m_data.timeInfo.setExpiryTime(dateTime);
+        updateExpiryState();
         emitModified();
     }
 }
@@ -814,6 +870,7 @@ void Entry::addHistoryItem(Entry* entry)
     Q_ASSERT(!entry->parent());
 
     entry->setHistoryOwner(this);
+    entry->updateCustomIconUse();
     m_history.append(entry);
     emitModified();
 }
@@ -944,6 +1001,7 @@ Entry* Entry::clone(CloneFlags flags) const
         entry->m_uuid = m_uuid;
     }
     entry->m_data = m_data;
+    entry->updateExpiryState();
     entry->m_customData->copyDataFrom(m_customData);
     entry->m_attributes->copyDataFrom(m_attributes);
     entry->m_attachments->copyDataFrom(m_attachments);
@@ -993,6 +1051,8 @@ void Entry::copyDataFrom(const Entry* other)
 {
     setUpdateTimeinfo(false);
     m_data = other->m_data;
+    updateExpiryState();
+    updateCustomIconUse();
     m_customData->copyDataFrom(other->m_customData);
     m_attributes->copyDataFrom(other->m_attributes);
     m_attachments->copyDataFrom(other->m_attachments);
@@ -1347,6 +1407,7 @@ void Entry::setGroup(Group* group, bool trackPrevious)
         return;
     }
 
+    const auto oldDatabase = database();
     if (m_group) {
         m_group->removeEntry(this);
         if (m_group->database() && m_group->database() != group->database()) {
@@ -1369,6 +1430,11 @@ void Entry::setGroup(Group* group, bool trackPrevious)
     m_group = group;
     group->addEntry(this);
 
+    if (database() != oldDatabase) {
+        updateExpiryState();
+        updateCustomIconUse();
+    }
+
     if (m_updateTimeinfo) {
         m_data.timeInfo.setLocationChanged(Clock::currentDateTimeUtc());
     }
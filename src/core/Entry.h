@@ -32,6 +32,7 @@
 
 class Database;
 class Group;
+class Metadata;
 class PasswordHealth;
 
 namespace Totp
@@ -284,6 +285,8 @@ private slots:
     void updateTotp();
 
 private:
+    void updateExpiryState();
+    void updateCustomIconUse();
     QString resolveMultiplePlaceholdersRecursive(const QString& str, int maxDepth) const;
     QString resolvePlaceholderRecursive(const QString& placeholder, int maxDepth) const;
     QString resolveReferencePlaceholderRecursive(const QString& placeholder, int maxDepth) const;
@@ -307,6 +310,15 @@ private:
     bool m_modifiedSinceBegin;
     QPointer<Group> m_group;
     bool m_updateTimeinfo;
+    // Expiry time in ms since epoch, ExpiryIndex::Never if not set
+    qint64 m_expiryTime;
+    // Custom icon reference registered with the metadata of the owning database
+    QPointer<Metadata> m_iconUseMetadata;
+    QUuid m_iconUseUuid;
+    bool m_iconUseHistory;
+
+    friend class ExpiryIndex;
+    friend class Group;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Entry::CloneFlags)
@@ -66,6 +66,8 @@ public:
     void setCaseSensitive(bool state);
     bool isCaseSensitive() const;
 
+    const QList<SearchTerm>& searchTerms() const;
+
 private:
     bool searchEntryImpl(const Entry* entry);
     void parseSearchTerms(const QString& searchString);
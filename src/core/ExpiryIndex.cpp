@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ExpiryIndex.h"
+
+#include "core/Clock.h"
+#include "core/Global.h"
+#include "core/Group.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Upper bound for the timer so that clock changes and system
+    // suspend are picked up within a reasonable time
+    const qint64 MaxTimerInterval = 60 * 1000;
+    const int MinCompactThreshold = 1024;
+
+    template <typename T> bool laterExpiry(const T& lhs, const T& rhs)
+    {
+        return lhs.expiry > rhs.expiry;
+    }
+} // namespace
+
+const qint64 ExpiryIndex::Never = std::numeric_limits<qint64>::max();
+
+ExpiryIndex::ExpiryIndex(Database* db)
+    : QObject(db)
+    , m_db(db)
+    , m_compactThreshold(MinCompactThreshold)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ExpiryIndex::processExpired);
+}
+
+ExpiryIndex::~ExpiryIndex() = default;
+
+/**
+ * Schedule the current expiry time of the entry. Called whenever the expiry
+ * settings of the entry change or the entry is added to the database.
+ * Entries that already expired are not announced again.
+ */
+void ExpiryIndex::schedule(Entry* entry)
+{
+    if (entry && entry->m_expiryTime != Never && !entry->isExpired()) {
+        push(entry->m_expiryTime, entry);
+    }
+}
+
+void ExpiryIndex::schedule(Group* group)
+{
+    if (group && group->m_expiryTime != Never && !group->isExpired()) {
+        push(group->m_expiryTime, group);
+    }
+}
+
+/**
+ * Number of scheduled items, including outdated ones not yet removed.
+ */
+int ExpiryIndex::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_heap.size();
+}
+
+/**
+ * Announce all entries and groups whose expiry time has passed and schedule the timer for the next one.
+ */
+void ExpiryIndex::processExpired()
+{
+    const auto now = Clock::currentMilliSecondsSinceEpoch();
+
+    QList<Item> due;
+    {
+        QMutexLocker locker(&m_mutex);
+        // An object scheduled repeatedly with the same expiry time is only announced once
+        QSet<QObject*> seen;
+        while (!m_heap.isEmpty() && m_heap.first().expiry < now) {
+            std::pop_heap(m_heap.begin(), m_heap.end(), laterExpiry<Item>);
+            auto item = m_heap.takeLast();
+            if (isCurrent(item) && !seen.contains(item.object)) {
+                seen.insert(item.object);
+                due.append(item);
+            }
+        }
+    }
+
+    for (const auto& item : asConst(due)) {
+        if (auto entry = qobject_cast<Entry*>(item.object)) {
+            entry->emitDataChanged();
+            emit entryExpired(entry);
+        } else if (auto group = qobject_cast<Group*>(item.object)) {
+            emit group->groupDataChanged(group);
+            emit groupExpired(group);
+        }
+    }
+
+    startTimer();
+}
+
+void ExpiryIndex::push(qint64 expiry, QObject* object)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_heap.size() >= m_compactThreshold) {
+            compact();
+        }
+
+        m_heap.append({expiry, object});
+        std::push_heap(m_heap.begin(), m_heap.end(), laterExpiry<Item>);
+        if (m_heap.first().object != object) {
+            // The timer is already set for an earlier item
+            return;
+        }
+    }
+
+    startTimer();
+}
+
+/**
+ * Drop outdated items, called with the mutex held.
+ */
+void ExpiryIndex::compact()
+{
+    m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(), [this](const Item& item) { return !isCurrent(item); }),
+                 m_heap.end());
+    std::make_heap(m_heap.begin(), m_heap.end(), laterExpiry<Item>);
+    m_compactThreshold = qMax(MinCompactThreshold, m_heap.size() * 2);
+}
+
+void ExpiryIndex::startTimer()
+{
+    qint64 next;
+    {
+        QMutexLocker locker(&m_mutex);
+        next = m_heap.isEmpty() ? Never : m_heap.first().expiry;
+    }
+
+    // Prevent warning about QTimer not allowed to be started/stopped from other thread
+    if (next == Never) {
+        QMetaObject::invokeMethod(&m_timer, "stop");
+        return;
+    }
+    // An item is expired once its expiry time is in the past, not when it is reached
+    const auto interval = qBound<qint64>(0, next - Clock::currentMilliSecondsSinceEpoch() + 1, MaxTimerInterval);
+    QMetaObject::invokeMethod(&m_timer, "start", Q_ARG(int, static_cast<int>(interval)));
+}
+
+/**
+ * An item is current if its object still belongs to this database and still expires at the same time.
+ */
+bool ExpiryIndex::isCurrent(const Item& item) const
+{
+    if (auto entry = qobject_cast<Entry*>(item.object)) {
+        return entry->database() == m_db && entry->m_expiryTime == item.expiry;
+    } else if (auto group = qobject_cast<Group*>(item.object)) {
+        return group->database() == m_db && group->m_expiryTime == item.expiry;
+    }
+    return false;
+}
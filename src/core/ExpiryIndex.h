@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_EXPIRYINDEX_H
+#define KEEPASSXC_EXPIRYINDEX_H
+
+#include <QMutex>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+class Database;
+class Entry;
+class Group;
+
+/**
+ * Schedules the expiry of the entries and groups of a database.
+ *
+ * Upcoming expiry times are kept in a min-heap that is served by a single
+ * timer, which emits entryExpired() or groupExpired() once an expiry time
+ * has passed. The index only drives these notifications, isExpired() is
+ * always computed from the clock. Heap items are not removed when an expiry
+ * time changes, outdated items are skipped when they come up.
+ */
+class ExpiryIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ExpiryIndex(Database* db);
+    ~ExpiryIndex() override;
+
+    static const qint64 Never;
+
+    void schedule(Entry* entry);
+    void schedule(Group* group);
+
+    int size() const;
+
+public slots:
+    void processExpired();
+
+signals:
+    void entryExpired(Entry* entry);
+    void groupExpired(Group* group);
+
+private:
+    struct Item
+    {
+        qint64 expiry;
+        QPointer<QObject> object;
+    };
+
+    void push(qint64 expiry, QObject* object);
+    void compact();
+    void startTimer();
+    bool isCurrent(const Item& item) const;
+
+    Database* const m_db;
+    mutable QMutex m_mutex;
+    QVector<Item> m_heap;
+    int m_compactThreshold;
+    QTimer m_timer;
+};
+
+#endif // KEEPASSXC_EXPIRYINDEX_H
@@ -20,6 +20,7 @@
 #include "config-keepassx.h"
 
 #include "core/Config.h"
+#include "core/ExpiryIndex.h"
 
 #ifdef WITH_XC_KEESHARE
 #include "keeshare/KeeShare.h"
@@ -40,6 +41,7 @@ const QString Group::RootAutoTypeSequence = "{USERNAME}{TAB}{PASSWORD}{ENTER}";
 Group::Group()
     : m_customData(new CustomData(this))
     , m_updateTimeinfo(true)
+    , m_expiryTime(ExpiryIndex::Never)
 {
     m_data.iconNumber = DefaultIconNumber;
     m_data.isExpanded = true;
@@ -55,6 +57,9 @@ Group::Group()
 Group::~Group()
 {
     setUpdateTimeinfo(false);
+    if (m_iconUseMetadata) {
+        m_iconUseMetadata->removeCustomIconUse(m_iconUseUuid, this);
+    }
     // Destroy entries and children manually so DeletedObjects can be added
     // to database.
     const QList<Entry*> entries = m_entries;
@@ -239,7 +244,41 @@ bool Group::isRecycled() const
 
 bool Group::isExpired() const
 {
-    return m_data.timeInfo.expires() && m_data.timeInfo.expiryTime() < Clock::currentDateTimeUtc();
+    return m_expiryTime != ExpiryIndex::Never && m_expiryTime < Clock::currentMilliSecondsSinceEpoch();
+}
+
+/**
+ * Refresh the cached expiry time after the expiry settings changed and
+ * schedule the expiry notification with the database.
+ */
+void Group::updateExpiryState()
+{
+    m_expiryTime = m_data.timeInfo.expires() ? m_data.timeInfo.expiryTime().toMSecsSinceEpoch() : ExpiryIndex::Never;
+
+    if (m_db) {
+        m_db->expiryIndex()->schedule(this);
+    }
+}
+
+/**
+ * Register the custom icon of this group with the metadata of the
+ * database, keeping the icon usage index current.
+ */
+void Group::updateCustomIconUse()
+{
+    Metadata* metadata = m_db && !m_data.customIcon.isNull() ? m_db->metadata() : nullptr;
+    if (metadata == m_iconUseMetadata && m_data.customIcon == m_iconUseUuid) {
+        return;
+    }
+
+    if (m_iconUseMetadata) {
+        m_iconUseMetadata->removeCustomIconUse(m_iconUseUuid, this);
+    }
+    m_iconUseMetadata = metadata;
+    m_iconUseUuid = m_data.customIcon;
+    if (metadata) {
+        metadata->addCustomIconUse(m_iconUseUuid, this);
+    }
 }
 
 bool Group::isEmpty() const
@@ -375,6 +414,7 @@ void Group::setIcon(int iconNumber)
     if (iconNumber >= 0 && (m_data.iconNumber != iconNumber || !m_data.customIcon.isNull())) {
         m_data.iconNumber = iconNumber;
         m_data.customIcon = QUuid();
+        updateCustomIconUse();
         emitModified();
         emit groupDataChanged(this);
     }
@@ -385,6 +425,7 @@ void Group::setIcon(const QUuid& uuid)
     if (!uuid.isNull() && m_data.customIcon != uuid) {
         m_data.customIcon = uuid;
         m_data.iconNumber = 0;
+        updateCustomIconUse();
         emitModified();
         emit groupDataChanged(this);
     }
@@ -393,6 +434,7 @@ void Group::setIcon(const QUuid& uuid)
 void Group::setTimeInfo(const TimeInfo& timeInfo)
 {
     m_data.timeInfo = timeInfo;
+    updateExpiryState();
 }
 
 void Group::setExpanded(bool expanded)
@@ -427,6 +469,7 @@ void Group::setExpires(bool value)
 {
     if (m_data.timeInfo.expires() != value) {
         m_data.timeInfo.setExpires(value);
+        updateExpiryState();
         emitModified();
     }
 }
@@ -435,6 +478,7 @@ void Group::setExpiryTime(const QDateTime& dateTime)
 {
     if (m_data.timeInfo.expiryTime() != dateTime) {
         m_data.timeInfo.setExpiryTime(dateTime);
+        updateExpiryState();
         emitModified();
     }
 }
@@ -942,6 +986,7 @@ Group* Group::clone(Entry::CloneFlags entryFlags, Group::CloneFlags groupFlags)
     }
 
     clonedGroup->m_data = m_data;
+    clonedGroup->updateExpiryState();
     clonedGroup->m_customData->copyDataFrom(m_customData);
 
     if (groupFlags & Group::CloneIncludeEntries) {
@@ -978,6 +1023,8 @@ Group* Group::clone(Entry::CloneFlags entryFlags, Group::CloneFlags groupFlags)
 void Group::copyDataFrom(const Group* other)
 {
     if (set(m_data, other->m_data)) {
+        updateExpiryState();
+        updateCustomIconUse();
         emit groupDataChanged(this);
     }
     m_customData->copyDataFrom(other->m_customData);
@@ -994,7 +1041,8 @@ void Group::addEntry(Entry* entry)
     m_entries << entry;
     connect(entry, &Entry::entryDataChanged, this, &Group::entryDataChanged);
     if (m_db) {
-        connect(entry, &Entry::modified, m_db, &Database::markAsModified);
+        Database* db = m_db;
+        connect(entry, &Entry::modified, db, [db, entry] { db->markObjectModified(entry); });
     }
 
     emitModified();
@@ -1055,7 +1103,7 @@ void Group::connectDatabaseSignalsRecursive(Database* db)
             entry->disconnect(m_db);
         }
         if (db) {
-            connect(entry, &Entry::modified, db, &Database::markAsModified);
+            connect(entry, &Entry::modified, db, [db, entry] { db->markObjectModified(entry); });
         }
     }
 
@@ -1069,12 +1117,21 @@ void Group::connectDatabaseSignalsRecursive(Database* db)
         connect(this, &Group::aboutToMove, db, &Database::groupAboutToMove);
         connect(this, &Group::groupMoved, db, &Database::groupMoved);
         connect(this, &Group::groupNonDataChange, db, &Database::markNonDataChange);
-        connect(this, &Group::modified, db, &Database::markAsModified);
+        connect(this, &Group::modified, db, [db, this] { db->markObjectModified(this); });
         // clang-format on
     }
 
     m_db = db;
 
+    // Schedule the expiry of the moved entries and groups with the new database
+    // and register their custom icons with its metadata
+    updateExpiryState();
+    updateCustomIconUse();
+    for (Entry* entry : asConst(m_entries)) {
+        entry->updateExpiryState();
+        entry->updateCustomIconUse();
+    }
+
     for (Group* group : asConst(m_children)) {
         group->connectDatabaseSignalsRecursive(db);
     }
@@ -209,6 +209,8 @@ private:
     void setParent(Database* db);
 
     void connectDatabaseSignalsRecursive(Database* db);
+    void updateExpiryState();
+    void updateCustomIconUse();
     void cleanupParent();
     void recCreateDelObjects();
 
@@ -227,8 +229,14 @@ private:
     QPointer<Group> m_parent;
 
     bool m_updateTimeinfo;
+    // Expiry time in ms since epoch, ExpiryIndex::Never if not set
+    qint64 m_expiryTime;
+    // Custom icon reference registered with the metadata of the owning database
+    QPointer<Metadata> m_iconUseMetadata;
+    QUuid m_iconUseUuid;
 
     friend Group* Database::setRootGroup(Group* group);
+    friend class ExpiryIndex;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Group::CloneFlags)
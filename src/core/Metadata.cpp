@@ -37,6 +37,7 @@ namespace customDataKeys
 {
     static const QString savedSearch = QStringLiteral("KPXC_SavedSearch");
     static const QString autosaveDelay = QStringLiteral("KPXC_autosaveDelayMin");
+    static const QString passwordDictionary = QStringLiteral("KPXC_PasswordDictionary");
 }; // namespace customDataKeys
 
 Metadata::Metadata(QObject* parent)
@@ -207,6 +208,41 @@ QList<QUuid> Metadata::customIconsOrder() const
     return m_customIconsOrder;
 }
 
+/**
+ * Entries, history items and groups of the database that reference the given icon.
+ */
+Metadata::CustomIconUsage Metadata::customIconUsage(const QUuid& uuid) const
+{
+    return m_customIconUsage.value(uuid);
+}
+
+/**
+ * Number of entries and groups using the given icon, history items are not counted.
+ */
+int Metadata::customIconUseCount(const QUuid& uuid) const
+{
+    auto it = m_customIconUsage.constFind(uuid);
+    if (it == m_customIconUsage.constEnd()) {
+        return 0;
+    }
+    return it->entries.size() + it->groups.size();
+}
+
+/**
+ * Custom icons not used by any entry or group. Icons only referenced
+ * by history items are considered unused.
+ */
+QList<QUuid> Metadata::unusedCustomIcons() const
+{
+    QList<QUuid> unused;
+    for (const auto& uuid : m_customIconsOrder) {
+        if (customIconUseCount(uuid) == 0) {
+            unused << uuid;
+        }
+    }
+    return unused;
+}
+
 bool Metadata::recycleBinEnabled() const
 {
     return m_data.recycleBinEnabled;
@@ -285,6 +321,15 @@ int Metadata::autosaveDelayMin() const
     return autosaveDelayMin;
 }
 
+/**
+ * Words that make a password of this database weak, such as the
+ * organization or product names. Used by the health check.
+ */
+QStringList Metadata::passwordDictionary() const
+{
+    return m_customData->value(customDataKeys::passwordDictionary).split('\n', Qt::SkipEmptyParts);
+}
+
 CustomData* Metadata::customData()
 {
     return m_customData;
@@ -400,19 +445,95 @@ void Metadata::removeCustomIcon(const QUuid& uuid)
     Q_ASSERT(!uuid.isNull());
     Q_ASSERT(m_customIcons.contains(uuid));
 
-    // Remove hash record only if this is the same uuid
-    QByteArray hash = hashIcon(m_customIcons[uuid].data);
-    if (m_customIconsHashes.contains(hash) && m_customIconsHashes[hash] == uuid) {
-        m_customIconsHashes.remove(hash);
+    removeCustomIcons({uuid});
+}
+
+/**
+ * Remove several custom icons at once. Entries and groups referencing
+ * the icons are not changed.
+ */
+void Metadata::removeCustomIcons(const QList<QUuid>& uuids)
+{
+    QSet<QUuid> removed;
+    auto db = dynamic_cast<Database*>(parent());
+    for (const auto& uuid : uuids) {
+        auto icon = m_customIcons.find(uuid);
+        if (icon == m_customIcons.end()) {
+            continue;
+        }
+
+        // Remove hash record only if this is the same uuid
+        QByteArray hash = hashIcon(icon->data);
+        if (m_customIconsHashes.value(hash) == uuid) {
+            m_customIconsHashes.remove(hash);
+        }
+
+        m_customIcons.erase(icon);
+        removed.insert(uuid);
+        if (db) {
+            db->addDeletedObject(uuid);
+        }
     }
 
-    m_customIcons.remove(uuid);
-    m_customIconsOrder.removeAll(uuid);
+    if (removed.isEmpty()) {
+        return;
+    }
+
+    QList<QUuid> order;
+    order.reserve(m_customIcons.size());
+    for (const auto& uuid : asConst(m_customIconsOrder)) {
+        if (!removed.contains(uuid)) {
+            order << uuid;
+        }
+    }
+    m_customIconsOrder = order;
     Q_ASSERT(m_customIcons.count() == m_customIconsOrder.count());
-    dynamic_cast<Database*>(parent())->addDeletedObject(uuid);
     emitModified();
 }
 
+void Metadata::addCustomIconUse(const QUuid& uuid, Entry* entry, bool historyItem)
+{
+    auto& usage = m_customIconUsage[uuid];
+    if (historyItem) {
+        usage.historyItems.insert(entry);
+    } else {
+        usage.entries.insert(entry);
+    }
+}
+
+void Metadata::removeCustomIconUse(const QUuid& uuid, Entry* entry, bool historyItem)
+{
+    auto usage = m_customIconUsage.find(uuid);
+    if (usage == m_customIconUsage.end()) {
+        return;
+    }
+    if (historyItem) {
+        usage->historyItems.remove(entry);
+    } else {
+        usage->entries.remove(entry);
+    }
+    if (usage->isEmpty()) {
+        m_customIconUsage.erase(usage);
+    }
+}
+
+void Metadata::addCustomIconUse(const QUuid& uuid, Group* group)
+{
+    m_customIconUsage[uuid].groups.insert(group);
+}
+
+void Metadata::removeCustomIconUse(const QUuid& uuid, Group* group)
+{
+    auto usage = m_customIconUsage.find(uuid);
+    if (usage == m_customIconUsage.end()) {
+        return;
+    }
+    usage->groups.remove(group);
+    if (usage->isEmpty()) {
+        m_customIconUsage.erase(usage);
+    }
+}
+
 QUuid Metadata::findCustomIcon(const QByteArray& candidate)
 {
     QByteArray hash = hashIcon(candidate);
@@ -504,6 +625,23 @@ void Metadata::setAutosaveDelayMin(int value)
     m_customData->set(customDataKeys::autosaveDelay, QString::number(value));
 }
 
+void Metadata::setPasswordDictionary(const QStringList& words)
+{
+    QStringList dictionary;
+    for (const auto& word : words) {
+        const auto trimmed = word.trimmed();
+        if (!trimmed.isEmpty() && !dictionary.contains(trimmed)) {
+            dictionary << trimmed;
+        }
+    }
+
+    if (dictionary.isEmpty()) {
+        m_customData->remove(customDataKeys::passwordDictionary);
+    } else {
+        m_customData->set(customDataKeys::passwordDictionary, dictionary.join('\n'));
+    }
+}
+
 QDateTime Metadata::settingsChanged() const
 {
     return m_settingsChanged;
@@ -22,6 +22,7 @@
 #include <QDateTime>
 #include <QHash>
 #include <QPointer>
+#include <QSet>
 #include <QUuid>
 #include <QVariantMap>
 
@@ -29,6 +30,7 @@
 #include "core/Global.h"
 
 class Database;
+class Entry;
 class Group;
 
 class Metadata : public ModifiableObject
@@ -75,6 +77,19 @@ public:
         }
     };
 
+    // Entries, history items and groups referencing a custom icon
+    struct CustomIconUsage
+    {
+        QSet<Entry*> entries;
+        QSet<Entry*> historyItems;
+        QSet<Group*> groups;
+
+        bool isEmpty() const
+        {
+            return entries.isEmpty() && historyItems.isEmpty() && groups.isEmpty();
+        }
+    };
+
     void init();
     void clear();
 
@@ -96,6 +111,9 @@ public:
     const CustomIconData& customIcon(const QUuid& uuid) const;
     bool hasCustomIcon(const QUuid& uuid) const;
     QList<QUuid> customIconsOrder() const;
+    CustomIconUsage customIconUsage(const QUuid& uuid) const;
+    int customIconUseCount(const QUuid& uuid) const;
+    QList<QUuid> unusedCustomIcons() const;
     bool recycleBinEnabled() const;
     Group* recycleBin();
     const Group* recycleBin() const;
@@ -110,6 +128,7 @@ public:
     int historyMaxItems() const;
     int historyMaxSize() const;
     int autosaveDelayMin() const;
+    QStringList passwordDictionary() const;
     CustomData* customData();
     const CustomData* customData() const;
 
@@ -138,6 +157,7 @@ public:
                        const QString& name = {},
                        const QDateTime& lastModified = {});
     void removeCustomIcon(const QUuid& uuid);
+    void removeCustomIcons(const QList<QUuid>& uuids);
     void copyCustomIcons(const QSet<QUuid>& iconList, const Metadata* otherMetadata);
     QUuid findCustomIcon(const QByteArray& candidate);
     void setRecycleBinEnabled(bool value);
@@ -153,6 +173,7 @@ public:
     void setHistoryMaxItems(int value);
     void setHistoryMaxSize(int value);
     void setAutosaveDelayMin(int value);
+    void setPasswordDictionary(const QStringList& words);
     void setUpdateDatetime(bool value);
     void addSavedSearch(const QString& name, const QString& searchtext);
     void deleteSavedSearch(const QString& name);
@@ -173,11 +194,19 @@ private:
 
     QByteArray hashIcon(const QByteArray& iconData);
 
+    // Maintained by Entry and Group whenever an icon or its owning database changes
+    void addCustomIconUse(const QUuid& uuid, Entry* entry, bool historyItem);
+    void removeCustomIconUse(const QUuid& uuid, Entry* entry, bool historyItem);
+    void addCustomIconUse(const QUuid& uuid, Group* group);
+    void removeCustomIconUse(const QUuid& uuid, Group* group);
+
     MetadataData m_data;
 
     QList<QUuid> m_customIconsOrder;
     QHash<QUuid, CustomIconData> m_customIcons;
     QHash<QByteArray, QUuid> m_customIconsHashes;
+    // Usage of custom icons, also tracks references to icons not (or no longer) in the database
+    QHash<QUuid, CustomIconUsage> m_customIconUsage;
 
     QPointer<Group> m_recycleBin;
     QDateTime m_recycleBinChanged;
@@ -192,6 +221,9 @@ private:
     QPointer<CustomData> m_customData;
 
     bool m_updateDatetime;
+
+    friend class Entry;
+    friend class Group;
 };
 
 #endif // KEEPASSX_METADATA_H
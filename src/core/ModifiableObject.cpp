@@ -17,6 +17,8 @@
 
 #include "ModifiableObject.h"
 
+#include <QChildEvent>
+
 namespace
 {
     template <typename T> T findParent(const QObject* obj)
@@ -39,24 +41,58 @@ namespace
 
 bool ModifiableObject::modifiedSignalEnabled() const
 {
-    auto p = this;
-    while (p) {
-        if (!p->m_emitModified) {
-            return false;
-        }
-        p = findParent<ModifiableObject*>(p);
+    if (!m_modifiedSignalStateValid) {
+        const auto parent = findParent<ModifiableObject*>(this);
+        m_modifiedSignalEnabled = m_emitModified && (!parent || parent->modifiedSignalEnabled());
+        m_modifiedSignalStateValid = true;
     }
-    return true;
+    return m_modifiedSignalEnabled;
 }
 
 void ModifiableObject::setEmitModified(bool value)
 {
     if (m_emitModified != value) {
         m_emitModified = value;
+        invalidateModifiedSignalState();
         emit emitModifiedChanged(m_emitModified);
     }
 }
 
+void ModifiableObject::childEvent(QChildEvent* event)
+{
+    // A reparented child has to re-evaluate the state of its new parents
+    if (event->added() || event->removed()) {
+        auto child = qobject_cast<ModifiableObject*>(event->child());
+        if (child) {
+            child->invalidateModifiedSignalState();
+        } else {
+            invalidateModifiedSignalState(event->child());
+        }
+    }
+    QObject::childEvent(event);
+}
+
+void ModifiableObject::invalidateModifiedSignalState()
+{
+    // If the cached state is already invalid, so is the state of all children
+    if (m_modifiedSignalStateValid) {
+        m_modifiedSignalStateValid = false;
+        invalidateModifiedSignalState(this);
+    }
+}
+
+void ModifiableObject::invalidateModifiedSignalState(QObject* object)
+{
+    for (auto child : object->children()) {
+        auto modifiable = qobject_cast<ModifiableObject*>(child);
+        if (modifiable) {
+            modifiable->invalidateModifiedSignalState();
+        } else {
+            invalidateModifiedSignalState(child);
+        }
+    }
+}
+
 void ModifiableObject::emitModified()
 {
     if (modifiedSignalEnabled()) {
@@ -47,13 +47,21 @@ public slots:
 
 protected:
     void emitModified();
+    void childEvent(QChildEvent* event) override;
 
 signals:
     void modified();
     void emitModifiedChanged(bool value);
 
 private:
+    void invalidateModifiedSignalState();
+    static void invalidateModifiedSignalState(QObject* object);
+
     bool m_emitModified{true};
+    // Cached result of modifiedSignalEnabled(), reset when this object or
+    // one of its parents toggles the signal or the object is reparented
+    mutable bool m_modifiedSignalEnabled{true};
+    mutable bool m_modifiedSignalStateValid{false};
 };
 
 #endif // KEEPASSXC_MODIFIABLEOBJECT_H
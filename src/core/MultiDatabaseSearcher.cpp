@@ -0,0 +1,262 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MultiDatabaseSearcher.h"
+
+#include "core/Database.h"
+#include "core/Group.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+namespace
+{
+    // Time spent searching before control returns to the event loop
+    const qint64 SliceTime = 10;
+
+    /**
+     * Rank of an entry by its title against the words of the parsed search
+     * terms that apply to the title. Lower is better: exact title, title
+     * prefix, title substring, any other match.
+     */
+    int rankEntry(const Entry* entry, const QList<EntrySearcher::SearchTerm>& terms, Qt::CaseSensitivity cs)
+    {
+        const auto title = entry->title();
+        int rank = 3;
+        for (const auto& term : terms) {
+            if (term.exclude || (term.field != EntrySearcher::Field::Undefined
+                                 && term.field != EntrySearcher::Field::Title)) {
+                continue;
+            }
+            if (title.compare(term.word, cs) == 0) {
+                return 0;
+            } else if (title.startsWith(term.word, cs)) {
+                rank = qMin(rank, 1);
+            } else if (title.contains(term.word, cs)) {
+                rank = qMin(rank, 2);
+            }
+        }
+        return rank;
+    }
+
+    bool resultLessThan(const MultiDatabaseSearcher::Result& lhs, const MultiDatabaseSearcher::Result& rhs)
+    {
+        return lhs.rank < rhs.rank || (lhs.rank == rhs.rank && lhs.source < rhs.source);
+    }
+} // namespace
+
+MultiDatabaseSearcher::MultiDatabaseSearcher(QObject* parent)
+    : QObject(parent)
+{
+    m_sliceTimer.setInterval(0);
+    connect(&m_sliceTimer, &QTimer::timeout, this, &MultiDatabaseSearcher::searchSlice);
+}
+
+MultiDatabaseSearcher::~MultiDatabaseSearcher()
+{
+    cancel();
+}
+
+/**
+ * Search the given databases from the event loop. Results are published
+ * through resultsChanged() as each database finishes. An empty search
+ * string clears the results.
+ *
+ * @param databases databases to search, in display order
+ * @param searchString search terms, see EntrySearcher
+ */
+void MultiDatabaseSearcher::search(const QList<QSharedPointer<Database>>& databases, const QString& searchString)
+{
+    cancel();
+    m_searchString = searchString;
+    m_results.clear();
+
+    if (searchString.trimmed().isEmpty()) {
+        emit resultsChanged();
+        emit searchFinished();
+        return;
+    }
+
+    // Parse the search terms once for all databases
+    m_searcher.setCaseSensitive(m_caseSensitive);
+    m_searcher.searchEntries(searchString, {});
+
+    for (int i = 0; i < databases.size(); ++i) {
+        const auto& db = databases[i];
+        if (!db || !db->rootGroup()) {
+            continue;
+        }
+
+        QList<QPointer<Group>> groups;
+        for (auto group : db->rootGroup()->groupsRecursive(true)) {
+            groups.append(group);
+        }
+        m_pending.append({db, i, groups, 0, {}});
+    }
+
+    emit resultsChanged();
+    if (m_pending.isEmpty()) {
+        emit searchFinished();
+    } else {
+        m_sliceTimer.start();
+    }
+}
+
+/**
+ * Stop the search in flight. Results found so far are kept.
+ */
+void MultiDatabaseSearcher::cancel()
+{
+    m_sliceTimer.stop();
+    m_pending.clear();
+}
+
+void MultiDatabaseSearcher::clear()
+{
+    cancel();
+    m_searchString.clear();
+    m_results.clear();
+    emit resultsChanged();
+}
+
+bool MultiDatabaseSearcher::isSearching() const
+{
+    return !m_pending.isEmpty();
+}
+
+QString MultiDatabaseSearcher::searchString() const
+{
+    return m_searchString;
+}
+
+const QList<MultiDatabaseSearcher::Result>& MultiDatabaseSearcher::results() const
+{
+    return m_results;
+}
+
+void MultiDatabaseSearcher::setCaseSensitive(bool state)
+{
+    m_caseSensitive = state;
+}
+
+bool MultiDatabaseSearcher::isCaseSensitive() const
+{
+    return m_caseSensitive;
+}
+
+/**
+ * Search the given databases and wait for the results.
+ *
+ * @param databases databases to search
+ * @param searchString search terms, see EntrySearcher
+ * @param caseSensitive match case
+ * @param forceSearch ignore group search settings
+ * @return merged and ranked results
+ */
+QList<MultiDatabaseSearcher::Result> MultiDatabaseSearcher::searchAll(const QList<QSharedPointer<Database>>& databases,
+                                                                      const QString& searchString,
+                                                                      bool caseSensitive,
+                                                                      bool forceSearch)
+{
+    EntrySearcher searcher(caseSensitive);
+    searcher.searchEntries(searchString, {});
+
+    QList<Result> results;
+    for (int i = 0; i < databases.size(); ++i) {
+        const auto& db = databases[i];
+        if (!db || !db->rootGroup()) {
+            continue;
+        }
+
+        PendingDatabase pending{db, i, {}, 0, {}};
+        for (const auto group : db->rootGroup()->groupsRecursive(true)) {
+            searchGroup(searcher, group, forceSearch, pending);
+        }
+        finishDatabase(results, pending);
+    }
+    return results;
+}
+
+/**
+ * Search the pending databases until the time slice is used up. Finished
+ * databases are merged into the results right away.
+ */
+void MultiDatabaseSearcher::searchSlice()
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    bool changed = false;
+    while (!m_pending.isEmpty() && !elapsed.hasExpired(SliceTime)) {
+        auto& pending = m_pending.first();
+        if (pending.database && pending.nextGroup < pending.groups.size()) {
+            // Groups deleted since the search started are skipped
+            const auto group = pending.groups.at(pending.nextGroup++);
+            if (group) {
+                searchGroup(m_searcher, group, false, pending);
+            }
+            continue;
+        }
+
+        finishDatabase(m_results, pending);
+        m_pending.removeFirst();
+        changed = true;
+    }
+
+    if (changed) {
+        emit resultsChanged();
+    }
+    if (m_pending.isEmpty()) {
+        m_sliceTimer.stop();
+        emit searchFinished();
+    }
+}
+
+void MultiDatabaseSearcher::searchGroup(EntrySearcher& searcher,
+                                        const Group* group,
+                                        bool forceSearch,
+                                        PendingDatabase& pending)
+{
+    if (!forceSearch && !group->resolveSearchingEnabled()) {
+        return;
+    }
+
+    const auto cs = searcher.isCaseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    for (auto entry : searcher.repeatEntries(group->entries())) {
+        pending.results.append(
+            {pending.database.data(), entry, rankEntry(entry, searcher.searchTerms(), cs), pending.source});
+    }
+}
+
+/**
+ * Rank the results of a database and merge them into the given results.
+ */
+void MultiDatabaseSearcher::finishDatabase(QList<Result>& results, PendingDatabase& pending)
+{
+    std::stable_sort(pending.results.begin(), pending.results.end(), resultLessThan);
+
+    QList<Result> merged;
+    merged.reserve(results.size() + pending.results.size());
+    std::merge(results.cbegin(),
+               results.cend(),
+               pending.results.cbegin(),
+               pending.results.cend(),
+               std::back_inserter(merged),
+               resultLessThan);
+    results.swap(merged);
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_MULTIDATABASESEARCHER_H
+#define KEEPASSXC_MULTIDATABASESEARCHER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include "core/EntrySearcher.h"
+
+class Database;
+class Entry;
+class Group;
+
+/**
+ * Searches several databases at once.
+ *
+ * Database objects belong to the GUI thread, so the databases are searched
+ * one after the other in short slices from the event loop instead of on the
+ * thread pool. Results are merged as each database finishes, ranked by how
+ * closely the entry title matches the parsed search terms and then by
+ * database order. Starting a new search cancels the one in flight.
+ */
+class MultiDatabaseSearcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result
+    {
+        QPointer<Database> database;
+        QPointer<Entry> entry;
+        int rank;
+        int source;
+    };
+
+    explicit MultiDatabaseSearcher(QObject* parent = nullptr);
+    ~MultiDatabaseSearcher() override;
+
+    void search(const QList<QSharedPointer<Database>>& databases, const QString& searchString);
+    void cancel();
+    void clear();
+
+    bool isSearching() const;
+    QString searchString() const;
+    const QList<Result>& results() const;
+
+    void setCaseSensitive(bool state);
+    bool isCaseSensitive() const;
+
+    static QList<Result> searchAll(const QList<QSharedPointer<Database>>& databases,
+                                   const QString& searchString,
+                                   bool caseSensitive = false,
+                                   bool forceSearch = false);
+
+signals:
+    void resultsChanged();
+    void searchFinished();
+
+private slots:
+    void searchSlice();
+
+private:
+    // Database waiting to be searched, groups are visited in order
+    struct PendingDatabase
+    {
+        QSharedPointer<Database> database;
+        int source;
+        QList<QPointer<Group>> groups;
+        int nextGroup;
+        QList<Result> results;
+    };
+
+    static void searchGroup(EntrySearcher& searcher, const Group* group, bool forceSearch, PendingDatabase& pending);
+    static void finishDatabase(QList<Result>& results, PendingDatabase& pending);
+
+    bool m_caseSensitive = false;
+    QString m_searchString;
+    QList<Result> m_results;
+    EntrySearcher m_searcher;
+    QList<PendingDatabase> m_pending;
+    QTimer m_sliceTimer;
+};
+
+#endif // KEEPASSXC_MULTIDATABASESEARCHER_H
@@ -17,11 +17,7 @@
 
 #include "PassphraseGenerator.h"
 
-#include <QFile>
-#include <QSet>
-#include <QTextStream>
-#include <cmath>
-
+#include "core/PassphraseWordList.h"
 #include "core/Resources.h"
 #include "crypto/Random.h"
 
@@ -39,14 +35,14 @@ PassphraseGenerator::PassphraseGenerator()
 
 double PassphraseGenerator::estimateEntropy(int wordCount)
 {
-    if (m_wordlist.isEmpty()) {
+    if (!m_wordlist || m_wordlist->isEmpty()) {
         return 0.0;
     }
     if (wordCount < 1) {
         wordCount = m_wordCount;
     }
 
-    return std::log2(m_wordlist.size()) * wordCount;
+    return m_wordlist->entropyPerWord() * wordCount;
 }
 
 void PassphraseGenerator::setWordCount(int wordCount)
@@ -61,45 +57,10 @@ void PassphraseGenerator::setWordCase(PassphraseWordCase wordCase)
 
 void PassphraseGenerator::setWordList(const QString& path)
 {
-    m_wordlist.clear();
-    // Initially load wordlist into a set to avoid duplicates
-    QSet<QString> wordset;
-
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning("Couldn't load passphrase wordlist: %s", qPrintable(path));
-        return;
-    }
-
-    QTextStream in(&file);
-    in.setCodec("UTF-8");
-    QString line = in.readLine();
-    bool isSigned = line.startsWith("-----BEGIN PGP SIGNED MESSAGE-----");
-    if (isSigned) {
-        while (!line.isNull() && !line.trimmed().isEmpty()) {
-            line = in.readLine();
-        }
-    }
-    QRegExp rx("^[0-9]+(-[0-9]+)*\\s+([^\\s]+)$");
-    while (!line.isNull()) {
-        if (isSigned && line.startsWith("-----BEGIN PGP SIGNATURE-----")) {
-            break;
-        }
-        // Handle dash-escaped lines (if the wordlist is signed)
-        if (isSigned && line.startsWith("- ")) {
-            line.remove(0, 2);
-        }
-        line = line.trimmed();
-        line.replace(rx, "\\2");
-        if (!line.isEmpty()) {
-            wordset.insert(line);
-        }
-        line = in.readLine();
-    }
-
-    m_wordlist = wordset.toList();
+    // Wordlists are parsed once and shared between all generator instances
+    m_wordlist = PassphraseWordList::fromFile(path);
 
-    if (m_wordlist.size() < m_minimum_wordlist_length) {
+    if (m_wordlist->size() < m_minimum_wordlist_length) {
         qWarning("Wordlist is less than minimum acceptable size: %s", qPrintable(path));
     }
 }
@@ -118,15 +79,15 @@ void PassphraseGenerator::setWordSeparator(const QString& separator)
 QString PassphraseGenerator::generatePassphrase() const
 {
     // In case there was an error loading the wordlist
-    if (!isValid() || m_wordlist.empty()) {
+    if (!isValid()) {
         return {};
     }
 
     QStringList words;
     int randomIndex = randomGen()->randomUInt(static_cast<quint32>(m_wordCount));
     for (int i = 0; i < m_wordCount; ++i) {
-        int wordIndex = randomGen()->randomUInt(static_cast<quint32>(m_wordlist.size()));
-        auto tmpWord = m_wordlist.at(wordIndex);
+        int wordIndex = randomGen()->randomUInt(static_cast<quint32>(m_wordlist->size()));
+        auto tmpWord = m_wordlist->at(wordIndex);
 
         // convert case
         switch (m_wordCase) {
@@ -151,5 +112,5 @@ QString PassphraseGenerator::generatePassphrase() const
 
 bool PassphraseGenerator::isValid() const
 {
-    return m_wordCount > 0 && m_wordlist.size() >= m_minimum_wordlist_length;
+    return m_wordCount > 0 && m_wordlist && m_wordlist->size() >= m_minimum_wordlist_length;
 }
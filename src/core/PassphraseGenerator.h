@@ -18,7 +18,9 @@
 #ifndef KEEPASSX_PASSPHRASEGENERATOR_H
 #define KEEPASSX_PASSPHRASEGENERATOR_H
 
-#include <QList>
+#include <QSharedPointer>
+
+class PassphraseWordList;
 
 class PassphraseGenerator
 {
@@ -53,7 +55,7 @@ private:
     int m_minimum_wordlist_length = 4000;
     PassphraseWordCase m_wordCase;
     QString m_separator;
-    QList<QString> m_wordlist;
+    QSharedPointer<const PassphraseWordList> m_wordlist;
 
     friend class TestPassphraseGenerator;
 };
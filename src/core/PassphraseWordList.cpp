@@ -0,0 +1,210 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PassphraseWordList.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QRegExp>
+#include <QSet>
+#include <QTextStream>
+#include <cmath>
+
+namespace
+{
+    const char CompiledMagic[CompiledBlob::MagicSize] = {'K', 'P', 'X', 'C', 'W', 'L', '0', '1'};
+
+    struct CacheRecord
+    {
+        qint64 size;
+        qint64 mtime;
+        QSharedPointer<const PassphraseWordList> wordList;
+    };
+
+    QMutex s_cacheMutex;
+    QHash<QString, CacheRecord> s_cache;
+} // namespace
+
+PassphraseWordList::PassphraseWordList()
+    : m_blob(CompiledMagic)
+{
+}
+
+PassphraseWordList::~PassphraseWordList() = default;
+
+/**
+ * Load a wordlist file, reusing a previously loaded instance or the
+ * compiled on-disk form whenever the source file has not changed.
+ *
+ * @param path wordlist file (plain or PGP signed EFF/diceware format)
+ * @return shared wordlist; empty if the file could not be read
+ */
+QSharedPointer<const PassphraseWordList> PassphraseWordList::fromFile(const QString& path)
+{
+    QFileInfo info(path);
+    const auto key = info.canonicalFilePath().isEmpty() ? info.absoluteFilePath() : info.canonicalFilePath();
+    const auto sourceSize = info.size();
+    const auto sourceMtime = info.lastModified().toMSecsSinceEpoch();
+
+    QMutexLocker locker(&s_cacheMutex);
+    auto it = s_cache.constFind(key);
+    if (it != s_cache.constEnd() && it->size == sourceSize && it->mtime == sourceMtime) {
+        return it->wordList;
+    }
+
+    QSharedPointer<PassphraseWordList> wordList(new PassphraseWordList());
+    const auto compiledPath = cachePath(key);
+    if (wordList->m_blob.load(compiledPath, sourceSize, sourceMtime)) {
+        wordList->updateEntropy();
+    } else {
+        bool ok = false;
+        const auto words = parseWordList(path, &ok);
+        if (!ok) {
+            s_cache.remove(key);
+            return QSharedPointer<const PassphraseWordList>(new PassphraseWordList());
+        }
+
+        wordList->compile(words, sourceSize, sourceMtime);
+        wordList->m_blob.save(compiledPath);
+    }
+
+    s_cache.insert(key, {sourceSize, sourceMtime, wordList});
+    return wordList;
+}
+
+/**
+ * Build an in-memory wordlist from the given words, removing duplicates
+ * and empty entries. The result is not cached.
+ */
+QSharedPointer<const PassphraseWordList> PassphraseWordList::fromWords(const QStringList& words)
+{
+    QSharedPointer<PassphraseWordList> wordList(new PassphraseWordList());
+    wordList->compile(words, 0, 0);
+    return wordList;
+}
+
+int PassphraseWordList::size() const
+{
+    return m_blob.size();
+}
+
+bool PassphraseWordList::isEmpty() const
+{
+    return m_blob.size() == 0;
+}
+
+QString PassphraseWordList::at(int index) const
+{
+    return QString::fromUtf8(m_blob.record(index));
+}
+
+/**
+ * Entropy contributed by a single, uniformly chosen word of this list.
+ */
+double PassphraseWordList::entropyPerWord() const
+{
+    return m_entropyPerWord;
+}
+
+bool PassphraseWordList::isMapped() const
+{
+    return m_blob.isMapped();
+}
+
+/**
+ * Location of the compiled form of the given wordlist file.
+ */
+QString PassphraseWordList::cachePath(const QString& path)
+{
+    return CompiledBlob::cachePath(QStringLiteral("wordlists"), path);
+}
+
+/**
+ * Drop all process-wide cached wordlists. Instances still in use remain valid.
+ */
+void PassphraseWordList::clearCache()
+{
+    QMutexLocker locker(&s_cacheMutex);
+    s_cache.clear();
+}
+
+void PassphraseWordList::compile(const QStringList& words, qint64 sourceSize, qint64 sourceMtime)
+{
+    QSet<QString> seen;
+    seen.reserve(words.size());
+    QVector<QByteArray> records;
+    records.reserve(words.size());
+
+    for (const auto& word : words) {
+        if (word.isEmpty() || seen.contains(word)) {
+            continue;
+        }
+        seen.insert(word);
+        records.append(word.toUtf8());
+    }
+
+    m_blob.build(records, sourceSize, sourceMtime);
+    updateEntropy();
+}
+
+void PassphraseWordList::updateEntropy()
+{
+    m_entropyPerWord = m_blob.size() > 0 ? std::log2(m_blob.size()) : 0.0;
+}
+
+QStringList PassphraseWordList::parseWordList(const QString& path, bool* ok)
+{
+    QStringList words;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning("Couldn't load passphrase wordlist: %s", qPrintable(path));
+        *ok = false;
+        return words;
+    }
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    QString line = in.readLine();
+    bool isSigned = line.startsWith("-----BEGIN PGP SIGNED MESSAGE-----");
+    if (isSigned) {
+        while (!line.isNull() && !line.trimmed().isEmpty()) {
+            line = in.readLine();
+        }
+    }
+    QRegExp rx("^[0-9]+(-[0-9]+)*\\s+([^\\s]+)$");
+    while (!line.isNull()) {
+        if (isSigned && line.startsWith("-----BEGIN PGP SIGNATURE-----")) {
+            break;
+        }
+        // Handle dash-escaped lines (if the wordlist is signed)
+        if (isSigned && line.startsWith("- ")) {
+            line.remove(0, 2);
+        }
+        line = line.trimmed();
+        line.replace(rx, "\\2");
+        if (!line.isEmpty()) {
+            words.append(line);
+        }
+        line = in.readLine();
+    }
+
+    *ok = true;
+    return words;
+}
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_PASSPHRASEWORDLIST_H
+#define KEEPASSXC_PASSPHRASEWORDLIST_H
+
+#include "core/CompiledBlob.h"
+
+#include <QSharedPointer>
+#include <QStringList>
+
+/**
+ * Immutable, deduplicated passphrase wordlist.
+ *
+ * The words are stored as one UTF-8 blob with an offset index. The compiled
+ * blob is written to the user cache directory and memory mapped on subsequent
+ * loads, so large custom wordlists are only parsed once. Loaded lists are
+ * shared process-wide and keyed by the source file path, size and mtime.
+ */
+class PassphraseWordList
+{
+public:
+    ~PassphraseWordList();
+    Q_DISABLE_COPY(PassphraseWordList)
+
+    static QSharedPointer<const PassphraseWordList> fromFile(const QString& path);
+    static QSharedPointer<const PassphraseWordList> fromWords(const QStringList& words);
+
+    int size() const;
+    bool isEmpty() const;
+    QString at(int index) const;
+    double entropyPerWord() const;
+    bool isMapped() const;
+
+    static QString cachePath(const QString& path);
+    static void clearCache();
+
+private:
+    PassphraseWordList();
+
+    void compile(const QStringList& words, qint64 sourceSize, qint64 sourceMtime);
+    void updateEntropy();
+    static QStringList parseWordList(const QString& path, bool* ok);
+
+    CompiledBlob m_blob;
+    double m_entropyPerWord = 0.0;
+};
+
+#endif // KEEPASSXC_PASSPHRASEWORDLIST_H
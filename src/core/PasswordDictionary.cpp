@@ -0,0 +1,333 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PasswordDictionary.h"
+
+#include "core/Entry.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QSet>
+#include <QTextStream>
+#include <QUrl>
+#include <algorithm>
+
+namespace
+{
+    // Records are "<normalized key>\0<word>" (UTF-8), sorted by key
+    const char CompiledMagic[CompiledBlob::MagicSize] = {'K', 'P', 'X', 'C', 'P', 'D', '0', '1'};
+
+    struct CacheRecord
+    {
+        qint64 size;
+        qint64 mtime;
+        QSharedPointer<const PasswordDictionary> dictionary;
+    };
+
+    QMutex s_cacheMutex;
+    QHash<QString, CacheRecord> s_cache;
+
+    // Leetspeak substitutions understood by zxcvbn, folded onto one character per class.
+    // Ambiguous substitutions (1 and | for i or l, 7 for l or t) put i, l and t in one class.
+    char normalizeChar(char c)
+    {
+        switch (c) {
+        case '4':
+        case '@':
+            return 'a';
+        case '8':
+            return 'b';
+        case '(':
+        case '<':
+        case '[':
+        case '{':
+            return 'c';
+        case '3':
+            return 'e';
+        case '6':
+        case '9':
+            return 'g';
+        case 'l':
+        case 't':
+        case '1':
+        case '|':
+        case '!':
+        case '7':
+        case '+':
+            return 'i';
+        case '0':
+            return 'o';
+        case '$':
+        case '5':
+            return 's';
+        case '%':
+            return 'x';
+        case '2':
+            return 'z';
+        default:
+            return c;
+        }
+    }
+} // namespace
+
+PasswordDictionary::PasswordDictionary()
+    : m_blob(CompiledMagic)
+{
+}
+
+PasswordDictionary::~PasswordDictionary() = default;
+
+/**
+ * Load a dictionary file with one word per line, lines starting with '#'
+ * are ignored. A previously loaded instance or the compiled on-disk form
+ * is reused whenever the source file has not changed.
+ *
+ * @param path dictionary file
+ * @return shared dictionary; empty if the file could not be read
+ */
+QSharedPointer<const PasswordDictionary> PasswordDictionary::fromFile(const QString& path)
+{
+    QFileInfo info(path);
+    const auto key = info.canonicalFilePath().isEmpty() ? info.absoluteFilePath() : info.canonicalFilePath();
+    const auto sourceSize = info.size();
+    const auto sourceMtime = info.lastModified().toMSecsSinceEpoch();
+
+    QMutexLocker locker(&s_cacheMutex);
+    auto it = s_cache.constFind(key);
+    if (it != s_cache.constEnd() && it->size == sourceSize && it->mtime == sourceMtime) {
+        return it->dictionary;
+    }
+
+    QSharedPointer<PasswordDictionary> dictionary(new PasswordDictionary());
+    const auto compiledPath = cachePath(key);
+    if (!dictionary->m_blob.load(compiledPath, sourceSize, sourceMtime)) {
+        bool ok = false;
+        const auto words = parseDictionary(path, &ok);
+        if (!ok) {
+            s_cache.remove(key);
+            return QSharedPointer<const PasswordDictionary>(new PasswordDictionary());
+        }
+
+        dictionary->compile(words, sourceSize, sourceMtime);
+        dictionary->m_blob.save(compiledPath);
+    }
+
+    s_cache.insert(key, {sourceSize, sourceMtime, dictionary});
+    return dictionary;
+}
+
+/**
+ * Build an in-memory dictionary from the given words. Words shorter than
+ * MinimumWordLength are dropped. The result is not cached.
+ */
+QSharedPointer<const PasswordDictionary> PasswordDictionary::fromWords(const QStringList& words)
+{
+    QSharedPointer<PasswordDictionary> dictionary(new PasswordDictionary());
+    dictionary->compile(words, 0, 0);
+    return dictionary;
+}
+
+int PasswordDictionary::size() const
+{
+    return m_blob.size();
+}
+
+bool PasswordDictionary::isEmpty() const
+{
+    return m_blob.size() == 0;
+}
+
+bool PasswordDictionary::isMapped() const
+{
+    return m_blob.isMapped();
+}
+
+/**
+ * Find the dictionary words contained in a password, also when written
+ * in leetspeak. The result may contain a few false positives, it is meant
+ * to be passed to zxcvbn as user dictionary.
+ *
+ * @param password password to look up
+ * @return matching words in dictionary order
+ */
+QStringList PasswordDictionary::matches(const QString& password) const
+{
+    QStringList words;
+    const int size = m_blob.size();
+    if (size == 0 || password.length() < MinimumWordLength) {
+        return words;
+    }
+
+    const auto text = normalize(password.toLower().toUtf8());
+    QVector<bool> found(size, false);
+
+    for (int start = 0; start + MinimumWordLength <= text.size(); ++start) {
+        int lo = 0;
+        int hi = size;
+        for (int len = 1; start + len <= text.size() && lo < hi; ++len) {
+            // All keys in [lo, hi) share the first len - 1 characters, shorter keys sort first
+            const auto c = static_cast<uchar>(text.at(start + len - 1));
+            const auto rank = [this, len](int index) {
+                const auto key = this->key(index);
+                return key.size() < len ? -1 : static_cast<int>(static_cast<uchar>(key.at(len - 1)));
+            };
+            const auto bound = [&rank](int first, int last, auto pred) {
+                while (first < last) {
+                    const int mid = first + (last - first) / 2;
+                    if (pred(rank(mid))) {
+                        first = mid + 1;
+                    } else {
+                        last = mid;
+                    }
+                }
+                return first;
+            };
+            lo = bound(lo, hi, [c](int r) { return r < c; });
+            hi = bound(lo, hi, [c](int r) { return r <= c; });
+
+            // Keys of exactly this length come first in the remaining range
+            if (len >= MinimumWordLength) {
+                for (int i = lo; i < hi && key(i).size() == len; ++i) {
+                    found[i] = true;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < size; ++i) {
+        if (found[i]) {
+            // The word follows the key and its terminator
+            words << QString::fromUtf8(m_blob.record(i).mid(key(i).size() + 1));
+        }
+    }
+    return words;
+}
+
+/**
+ * Words an attacker targeting this entry would try first: the parts of
+ * its title, username and URL host.
+ */
+QStringList PasswordDictionary::contextWords(const Entry* entry)
+{
+    static const QRegularExpression separators("[^\\p{L}\\p{N}]+");
+    static const QSet<QString> ignored = {"www", "http", "https"};
+
+    QSet<QString> words;
+    const auto addWords = [&words](const QString& text) {
+        for (const auto& word : text.toLower().split(separators, Qt::SkipEmptyParts)) {
+            if (word.length() >= MinimumWordLength && !ignored.contains(word)) {
+                words.insert(word);
+            }
+        }
+    };
+
+    if (entry) {
+        addWords(entry->title());
+        addWords(entry->username());
+        addWords(QUrl::fromUserInput(entry->url()).host());
+        if (entry->username().length() >= MinimumWordLength) {
+            words.insert(entry->username().toLower());
+        }
+    }
+
+    auto result = words.values();
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * Location of the compiled form of the given dictionary file.
+ */
+QString PasswordDictionary::cachePath(const QString& path)
+{
+    return CompiledBlob::cachePath(QStringLiteral("dictionaries"), path);
+}
+
+/**
+ * Drop all process-wide cached dictionaries. Instances still in use remain valid.
+ */
+void PasswordDictionary::clearCache()
+{
+    QMutexLocker locker(&s_cacheMutex);
+    s_cache.clear();
+}
+
+/**
+ * Normalized key of the record at the given index, not copied.
+ */
+QByteArray PasswordDictionary::key(int index) const
+{
+    const auto record = m_blob.record(index);
+    return QByteArray::fromRawData(record.constData(), static_cast<int>(qstrnlen(record.constData(), record.size())));
+}
+
+QByteArray PasswordDictionary::normalize(const QByteArray& word)
+{
+    QByteArray normalized(word);
+    for (auto& c : normalized) {
+        c = normalizeChar(c);
+    }
+    return normalized;
+}
+
+void PasswordDictionary::compile(const QStringList& words, qint64 sourceSize, qint64 sourceMtime)
+{
+    QVector<QByteArray> records;
+    records.reserve(words.size());
+    for (const auto& word : words) {
+        const auto lower = word.trimmed().toLower();
+        if (lower.length() < MinimumWordLength) {
+            continue;
+        }
+        const auto utf8 = lower.toUtf8();
+        records.append(normalize(utf8) + '\0' + utf8);
+    }
+
+    // Records sort by key first since the key is terminated by the smallest byte
+    std::sort(records.begin(), records.end());
+    records.erase(std::unique(records.begin(), records.end()), records.end());
+
+    m_blob.build(records, sourceSize, sourceMtime);
+}
+
+QStringList PasswordDictionary::parseDictionary(const QString& path, bool* ok)
+{
+    QStringList words;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning("Couldn't load password dictionary: %s", qPrintable(path));
+        *ok = false;
+        return words;
+    }
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    while (!in.atEnd()) {
+        const auto line = in.readLine().trimmed();
+        if (!line.isEmpty() && !line.startsWith('#')) {
+            words.append(line);
+        }
+    }
+
+    *ok = true;
+    return words;
+}
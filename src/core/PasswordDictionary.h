@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef KEEPASSXC_PASSWORDDICTIONARY_H
+#define KEEPASSXC_PASSWORDDICTIONARY_H
+
+#include "core/CompiledBlob.h"
+
+#include <QSharedPointer>
+#include <QStringList>
+
+class Entry;
+
+/**
+ * Immutable dictionary of words that make a password weak, such as
+ * organization names or product codenames.
+ *
+ * The words are compiled into one blob sorted by their leetspeak-normalized
+ * form, so the candidate words contained in a password are found with a
+ * prefix walk instead of handing the whole dictionary to zxcvbn. Dictionaries
+ * loaded from a file are memory mapped from a compiled copy in the user cache
+ * directory and shared process-wide, see CompiledBlob.
+ */
+class PasswordDictionary
+{
+public:
+    ~PasswordDictionary();
+    Q_DISABLE_COPY(PasswordDictionary)
+
+    static QSharedPointer<const PasswordDictionary> fromFile(const QString& path);
+    static QSharedPointer<const PasswordDictionary> fromWords(const QStringList& words);
+
+    int size() const;
+    bool isEmpty() const;
+    bool isMapped() const;
+    QStringList matches(const QString& password) const;
+
+    static QStringList contextWords(const Entry* entry);
+    static QString cachePath(const QString& path);
+    static void clearCache();
+
+    static const int MinimumWordLength = 3;
+
+private:
+    PasswordDictionary();
+
+    QByteArray key(int index) const;
+    void compile(const QStringList& words, qint64 sourceSize, qint64 sourceMtime);
+    static QByteArray normalize(const QByteArray& word);
+    static QStringList parseDictionary(const QString& path, bool* ok);
+
+    CompiledBlob m_blob;
+};
+
+#endif // KEEPASSXC_PASSWORDDICTIONARY_H
@@ -15,16 +15,72 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QCache>
+#include <QMessageAuthenticationCode>
+#include <QMutex>
+#include <QSet>
 #include <QString>
+#include <QVector>
 
 #include "Clock.h"
+#include "Config.h"
 #include "Group.h"
+#include "Metadata.h"
+#include "PasswordDictionary.h"
 #include "PasswordHealth.h"
+#include "crypto/Random.h"
 #include "zxcvbn.h"
 
+#include <cmath>
+
 namespace
 {
-    const static int ZXCVBN_ESTIMATE_THRESHOLD = 256;
+    // Passwords up to this length are matched by zxcvbn as a whole
+    const static int ZXCVBN_ESTIMATE_THRESHOLD = 128;
+    // Longer passwords are matched in windows of this size to bound the matching cost
+    const static int ZXCVBN_WINDOW_SIZE = 64;
+    const static int ENTROPY_CACHE_SIZE = 1024;
+
+    QMutex s_entropyCacheMutex;
+    QCache<QByteArray, double> s_entropyCache(ENTROPY_CACHE_SIZE);
+
+    // Passwords are only kept as keyed hashes, the key never leaves the process
+    QByteArray entropyCacheKey(const QString& pwd)
+    {
+        static const QByteArray key = randomGen()->randomArray(32);
+        return QMessageAuthenticationCode::hash(pwd.toUtf8(), key, QCryptographicHash::Sha256);
+    }
+
+    double matchEntropy(const QString& pwd, const char* userDict[])
+    {
+        return ZxcvbnMatch(pwd.toUtf8(), userDict, nullptr);
+    }
+
+    double windowedEntropy(const QString& pwd, const char* userDict[], const std::atomic_bool* canceled)
+    {
+        auto entropy = 0.0;
+        QSet<QString> seen;
+        bool repeated = false;
+        const int windows = (pwd.length() + ZXCVBN_WINDOW_SIZE - 1) / ZXCVBN_WINDOW_SIZE;
+        for (int i = 0; i < windows; ++i) {
+            if (canceled && *canceled) {
+                break;
+            }
+            const auto window = pwd.mid(i * ZXCVBN_WINDOW_SIZE, ZXCVBN_WINDOW_SIZE);
+            if (seen.contains(window)) {
+                repeated = true;
+                continue;
+            }
+            seen.insert(window);
+            entropy += matchEntropy(window, userDict);
+        }
+        // Identical windows are only scored once, like zxcvbn repeat matches
+        // the repetition adds the bits needed to encode the repeat count
+        if (repeated) {
+            entropy += std::log2(windows);
+        }
+        return entropy;
+    }
 } // namespace
 
 PasswordHealth::PasswordHealth(double entropy)
@@ -32,16 +88,99 @@ PasswordHealth::PasswordHealth(double entropy)
     init(entropy);
 }
 
-PasswordHealth::PasswordHealth(const QString& pwd)
+PasswordHealth::PasswordHealth(const QString& pwd, const QStringList& userWords)
 {
-    auto entropy = 0.0;
-    entropy += ZxcvbnMatch(pwd.left(ZXCVBN_ESTIMATE_THRESHOLD).toUtf8(), nullptr, nullptr);
-    if (pwd.length() > ZXCVBN_ESTIMATE_THRESHOLD) {
-        // Add the average entropy per character for any characters above the estimate threshold
-        auto average = entropy / ZXCVBN_ESTIMATE_THRESHOLD;
-        entropy += average * (pwd.length() - ZXCVBN_ESTIMATE_THRESHOLD);
+    init(estimateEntropy(pwd, userWords));
+}
+
+/**
+ * Estimate the entropy of a password with zxcvbn.
+ *
+ * Long passwords are matched in bounded windows whose entropies are added
+ * up, so the cost grows linearly with the length. Results are not cached,
+ * see cacheEntropy().
+ *
+ * @param pwd password to estimate
+ * @param canceled optional flag to abort a long estimation, the result is meaningless if set
+ * @return entropy in bits
+ */
+double PasswordHealth::estimateEntropy(const QString& pwd, const std::atomic_bool* canceled)
+{
+    return estimateEntropy(pwd, {}, canceled);
+}
+
+/**
+ * Estimate the entropy of a password, additionally matching it against
+ * the given words such as the entry title or organization names.
+ */
+double PasswordHealth::estimateEntropy(const QString& pwd,
+                                       const QStringList& userWords,
+                                       const std::atomic_bool* canceled)
+{
+    if (pwd.isEmpty()) {
+        return 0.0;
     }
-    init(entropy);
+
+    // zxcvbn takes the user dictionary as null terminated array of C strings
+    QList<QByteArray> words;
+    QVector<const char*> userDict;
+    for (const auto& word : userWords) {
+        words << word.toUtf8();
+        userDict << words.last().constData();
+    }
+    userDict << nullptr;
+
+    double entropy;
+    if (pwd.length() <= ZXCVBN_ESTIMATE_THRESHOLD) {
+        entropy = matchEntropy(pwd, userDict.data());
+    } else {
+        entropy = windowedEntropy(pwd, userDict.data(), canceled);
+    }
+    return entropy;
+}
+
+/**
+ * Remember the estimated entropy of a password typed into an editor, so
+ * going back to it does not run zxcvbn again. Only interactive estimations
+ * are cached, database-wide checks are not. The cache holds keyed hashes of
+ * the passwords and is cleared when a database is locked or closed.
+ */
+void PasswordHealth::cacheEntropy(const QString& pwd, double entropy)
+{
+    if (pwd.isEmpty()) {
+        return;
+    }
+
+    const auto key = entropyCacheKey(pwd);
+    QMutexLocker locker(&s_entropyCacheMutex);
+    s_entropyCache.insert(key, new double(entropy));
+}
+
+/**
+ * Look up an entropy stored with cacheEntropy() without running zxcvbn.
+ *
+ * @return true if the entropy of the password is cached
+ */
+bool PasswordHealth::cachedEntropy(const QString& pwd, double* entropy)
+{
+    if (pwd.isEmpty()) {
+        *entropy = 0.0;
+        return true;
+    }
+
+    const auto key = entropyCacheKey(pwd);
+    QMutexLocker locker(&s_entropyCacheMutex);
+    if (auto cached = s_entropyCache.object(key)) {
+        *entropy = *cached;
+        return true;
+    }
+    return false;
+}
+
+void PasswordHealth::clearEntropyCache()
+{
+    QMutexLocker locker(&s_entropyCacheMutex);
+    s_entropyCache.clear();
 }
 
 void PasswordHealth::init(double entropy)
@@ -123,6 +262,16 @@ HealthChecker::HealthChecker(QSharedPointer<Database> db)
                 << QObject::tr("Used in %1/%2").arg(entry->group()->hierarchy().join('/'), entry->title());
         }
     }
+
+    // Compile the custom dictionaries once for all entries
+    const auto databaseWords = db->metadata()->passwordDictionary();
+    if (!databaseWords.isEmpty()) {
+        m_dictionaries << PasswordDictionary::fromWords(databaseWords);
+    }
+    const auto organizationDictionary = config()->get(Config::Security_PasswordDictionaryFile).toString();
+    if (!organizationDictionary.isEmpty()) {
+        m_dictionaries << PasswordDictionary::fromFile(organizationDictionary);
+    }
 }
 
 /**
@@ -138,9 +287,14 @@ QSharedPointer<PasswordHealth> HealthChecker::evaluate(const Entry* entry) const
         return {};
     }
 
-    // First analyse the password itself
+    // First analyse the password itself, including words related to the entry
+    // and the custom dictionary words it contains
     const auto pwd = entry->password();
-    auto health = QSharedPointer<PasswordHealth>(new PasswordHealth(pwd));
+    auto userWords = PasswordDictionary::contextWords(entry);
+    for (const auto& dictionary : m_dictionaries) {
+        userWords << dictionary->matches(pwd);
+    }
+    auto health = QSharedPointer<PasswordHealth>(new PasswordHealth(pwd, userWords));
 
     // Second, if the password is in the database more than once,
     // reduce the score accordingly
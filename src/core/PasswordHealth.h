@@ -20,9 +20,13 @@
 
 #include <QHash>
 #include <QSharedPointer>
+#include <QStringList>
+
+#include <atomic>
 
 class Database;
 class Entry;
+class PasswordDictionary;
 
 /**
  * Health status of a single password.
@@ -33,10 +37,17 @@ class PasswordHealth
 {
 public:
     explicit PasswordHealth(double entropy);
-    explicit PasswordHealth(const QString& pwd);
+    explicit PasswordHealth(const QString& pwd, const QStringList& userWords = {});
 
     void init(double entropy);
 
+    static double estimateEntropy(const QString& pwd, const std::atomic_bool* canceled = nullptr);
+    static double
+    estimateEntropy(const QString& pwd, const QStringList& userWords, const std::atomic_bool* canceled = nullptr);
+    static void cacheEntropy(const QString& pwd, double entropy);
+    static bool cachedEntropy(const QString& pwd, double* entropy);
+    static void clearEntropyCache();
+
     /*
      * The password score is defined to be the greater the better
      * (more secure) the password is. It doesn't have a dimension,
@@ -113,6 +124,8 @@ public:
 private:
     // To determine password re-use: first = password, second = entries that use it
     QHash<QString, QStringList> m_reuse;
+    // Database and organization words, compiled once for all entries
+    QList<QSharedPointer<const PasswordDictionary>> m_dictionaries;
 };
 
 #endif // KEEPASSX_PASSWORDHEALTH_H
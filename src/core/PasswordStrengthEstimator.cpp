@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PasswordStrengthEstimator.h"
+
+#include "core/AsyncTask.h"
+#include "core/PasswordHealth.h"
+
+namespace
+{
+    const int DefaultDebounceInterval = 150;
+} // namespace
+
+PasswordStrengthEstimator::PasswordStrengthEstimator(QObject* parent)
+    : QObject(parent)
+{
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(DefaultDebounceInterval);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &PasswordStrengthEstimator::startEstimate);
+}
+
+PasswordStrengthEstimator::~PasswordStrengthEstimator()
+{
+    // Stop a running estimation early, its result is dropped with this object
+    cancel();
+}
+
+void PasswordStrengthEstimator::setDebounceInterval(int msec)
+{
+    m_debounceTimer.setInterval(msec);
+}
+
+/**
+ * True while an estimation is pending or running.
+ */
+bool PasswordStrengthEstimator::isBusy() const
+{
+    return m_debounceTimer.isActive() || m_running;
+}
+
+/**
+ * Request the estimation of a password. The result is reported through
+ * estimated(), immediately if the password was estimated before.
+ */
+void PasswordStrengthEstimator::estimate(const QString& password)
+{
+    cancel();
+
+    double entropy;
+    if (PasswordHealth::cachedEntropy(password, &entropy)) {
+        emit estimated(entropy);
+        return;
+    }
+
+    m_password = password;
+    m_debounceTimer.start();
+}
+
+/**
+ * Drop the pending request and abort the running one.
+ */
+void PasswordStrengthEstimator::cancel()
+{
+    m_debounceTimer.stop();
+    m_password.clear();
+    m_restart = false;
+    if (m_canceled) {
+        *m_canceled = true;
+        m_canceled.reset();
+    }
+}
+
+void PasswordStrengthEstimator::startEstimate()
+{
+    if (m_running) {
+        // Start over once the canceled estimation returned
+        m_restart = true;
+        return;
+    }
+
+    CancelFlag canceled(new std::atomic_bool(false));
+    m_canceled = canceled;
+    m_running = true;
+
+    const auto password = m_password;
+    m_password.clear();
+
+    AsyncTask::runThenCallback(
+        [password, canceled] { return PasswordHealth::estimateEntropy(password, canceled.data()); },
+        this,
+        [this, password, canceled](double entropy) {
+            m_running = false;
+            if (!*canceled) {
+                PasswordHealth::cacheEntropy(password, entropy);
+            }
+            if (m_restart) {
+                m_restart = false;
+                startEstimate();
+            } else if (!*canceled) {
+                m_canceled.reset();
+                emit estimated(entropy);
+            }
+        });
+}
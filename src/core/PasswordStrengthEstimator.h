@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef KEEPASSXC_PASSWORDSTRENGTHESTIMATOR_H
+#define KEEPASSXC_PASSWORDSTRENGTHESTIMATOR_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include <atomic>
+
+/**
+ * Estimates the password strength of user input off the GUI thread.
+ *
+ * Requests are debounced and estimated on the thread pool, one at a time.
+ * A new request cancels the one in flight, only the result for the latest
+ * password is reported. Cached results are reported immediately.
+ *
+ * @see PasswordHealth::estimateEntropy
+ */
+class PasswordStrengthEstimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PasswordStrengthEstimator(QObject* parent = nullptr);
+    ~PasswordStrengthEstimator() override;
+
+    void setDebounceInterval(int msec);
+    bool isBusy() const;
+
+public slots:
+    void estimate(const QString& password);
+    void cancel();
+
+signals:
+    void estimated(double entropy);
+
+private slots:
+    void startEstimate();
+
+private:
+    using CancelFlag = QSharedPointer<std::atomic_bool>;
+
+    QTimer m_debounceTimer;
+    QString m_password;
+    CancelFlag m_canceled;
+    bool m_running = false;
+    bool m_restart = false;
+};
+
+#endif // KEEPASSXC_PASSWORDSTRENGTHESTIMATOR_H
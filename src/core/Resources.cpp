@@ -48,6 +48,8 @@ QString Resources::pluginPath(const QString& name) const
 
     // for TestAutoType
     pluginPaths << QCoreApplication::applicationDirPath() + "/../src/autotype/test";
+    // for TestGuiAutoTypeX11
+    pluginPaths << QCoreApplication::applicationDirPath() + "/../../src/autotype/xcb";
 
 #if defined(Q_OS_MACOS) && defined(WITH_APP_BUNDLE)
     pluginPaths << QCoreApplication::applicationDirPath() + "/../PlugIns";
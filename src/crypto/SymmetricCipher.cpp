@@ -18,11 +18,22 @@
 #include "SymmetricCipher.h"
 
 #include "config-keepassx.h"
+#include "core/Global.h"
 #include "format/KeePass2.h"
 
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
 #include <botan/block_cipher.h>
 #include <botan/cipher_mode.h>
 
+namespace
+{
+    // Segments smaller than this are not worth handing to another thread
+    const int MinParallelSegmentSize = 64 * 1024;
+} // namespace
+
 bool SymmetricCipher::init(Mode mode, Direction direction, const QByteArray& key, const QByteArray& iv)
 {
     m_mode = mode;
@@ -149,6 +160,120 @@ bool SymmetricCipher::aesKdf(const QByteArray& key, int rounds, QByteArray& data
     }
 }
 
+/**
+ * Decrypt a CBC ciphertext, or a chunk of it, in place, splitting the work across threads.
+ *
+ * CBC decryption of a block only depends on the ciphertext of the previous
+ * block, so each segment can be decrypted independently when it is started
+ * with the last ciphertext block of the preceding segment as IV. Padding is
+ * only checked and removed on the final segment of the last chunk. The IV of
+ * the next chunk is the last ciphertext block of the current one.
+ *
+ * @param mode CBC cipher mode
+ * @param key cipher key
+ * @param iv initialization vector of the first block
+ * @param data ciphertext, replaced by the unpadded plaintext on success
+ * @param error optional error string
+ * @param threads number of segments to use, 0 selects the ideal thread count
+ * @param lastChunk false if more ciphertext follows, the data is then not unpadded
+ * @return true on success
+ */
+bool SymmetricCipher::decryptCbcParallel(Mode mode,
+                                         const QByteArray& key,
+                                         const QByteArray& iv,
+                                         QByteArray& data,
+                                         QString* error,
+                                         int threads,
+                                         bool lastChunk)
+{
+    auto setError = [error](const QString& message) {
+        if (error) {
+            *error = message;
+        }
+    };
+
+    if (mode != Aes128_CBC && mode != Aes256_CBC && mode != Twofish_CBC) {
+        setError(QObject::tr("SymmetricCipher::init: Invalid cipher mode."));
+        return false;
+    }
+
+    const int block = blockSize(mode);
+    if (data.isEmpty() || data.size() % block != 0) {
+        setError(QObject::tr("Invalid ciphertext length of %1 for %2.").arg(data.size()).arg(modeToString(mode)));
+        return false;
+    }
+    if (iv.size() != ivSize(mode)) {
+        setError(QObject::tr("SymmetricCipher::init: Invalid IV size of %1 for %2.")
+                     .arg(iv.size())
+                     .arg(modeToString(mode)));
+        return false;
+    }
+
+    if (threads <= 0) {
+        threads = QThread::idealThreadCount();
+    }
+    const int totalBlocks = data.size() / block;
+    const int segmentBlocks =
+        qMax(MinParallelSegmentSize / block, (totalBlocks + qMax(threads, 1) - 1) / qMax(threads, 1));
+
+    struct Segment
+    {
+        int offset;
+        int length;
+        QByteArray iv;
+        QString error;
+    };
+
+    // Capture every segment IV before any ciphertext is overwritten
+    QVector<Segment> segments;
+    for (int offset = 0; offset < data.size(); offset += segmentBlocks * block) {
+        const int length = qMin(segmentBlocks * block, data.size() - offset);
+        segments.append({offset, length, offset == 0 ? iv : data.mid(offset - block, block), {}});
+    }
+
+    auto raw = reinterpret_cast<uint8_t*>(data.data());
+    const auto lastOffset = lastChunk ? segments.last().offset : -1;
+    const auto botanMode = modeToString(mode).toStdString();
+    auto decryptSegment = [&](Segment& segment) {
+        try {
+            auto cipher = Botan::Cipher_Mode::create_or_throw(botanMode,
+#ifdef WITH_XC_BOTAN3
+                                                              Botan::Cipher_Dir::Decryption);
+#else
+                                                              Botan::Cipher_Dir::DECRYPTION);
+#endif
+            cipher->set_key(reinterpret_cast<const uint8_t*>(key.constData()), key.size());
+            cipher->start(reinterpret_cast<const uint8_t*>(segment.iv.constData()), segment.iv.size());
+            if (segment.offset != lastOffset) {
+                cipher->process(raw + segment.offset, segment.length);
+            } else {
+                Botan::secure_vector<uint8_t> input(raw + segment.offset, raw + segment.offset + segment.length);
+                cipher->finish(input);
+                std::copy(input.begin(), input.end(), raw + segment.offset);
+                segment.length = static_cast<int>(input.size());
+            }
+        } catch (std::exception& e) {
+            segment.error = e.what();
+        }
+    };
+
+    if (segments.size() == 1) {
+        decryptSegment(segments.first());
+    } else {
+        QtConcurrent::blockingMap(segments, decryptSegment);
+    }
+
+    for (const auto& segment : asConst(segments)) {
+        if (!segment.error.isEmpty()) {
+            setError(segment.error);
+            return false;
+        }
+    }
+
+    data.resize(segments.last().offset + segments.last().length);
+    return true;
+}
+
 QString SymmetricCipher::errorString() const
 {
     return m_error;
@@ -59,6 +59,13 @@ public:
     Q_REQUIRED_RESULT bool finish(QByteArray& data);
 
     static bool aesKdf(const QByteArray& key, int rounds, QByteArray& data);
+    static bool decryptCbcParallel(Mode mode,
+                                   const QByteArray& key,
+                                   const QByteArray& iv,
+                                   QByteArray& data,
+                                   QString* error = nullptr,
+                                   int threads = 0,
+                                   bool lastChunk = true);
 
     void reset();
     Mode mode();
@@ -461,7 +461,9 @@ namespace FdoSecrets
 
         connect(coll, &Collection::itemCreated, this, &DBusMgr::emitItemCreated);
         connect(coll, &Collection::itemChanged, this, &DBusMgr::emitItemChanged);
-        connect(coll, &Collection::itemDeleted, this, &DBusMgr::emitItemDeleted);
+        connect(coll, &Collection::itemDeleted, this, [this, coll](const QDBusObjectPath& itemPath) {
+            emitItemDeleted(coll, itemPath);
+        });
 
         return true;
     }
@@ -581,11 +583,10 @@ namespace FdoSecrets
         }
     }
 
-    void DBusMgr::emitItemDeleted(Item* item)
+    void DBusMgr::emitItemDeleted(Collection* coll, const QDBusObjectPath& itemPath)
     {
-        auto coll = item->collection();
         QVariantList args;
-        args += QVariant::fromValue(item->objectPath());
+        args += QVariant::fromValue(itemPath);
         // send on primary path
         sendDBusSignal(
             coll->objectPath().path(), DBUS_INTERFACE_SECRET_COLLECTION, QStringLiteral("ItemDeleted"), args);
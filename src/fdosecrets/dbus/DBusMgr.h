@@ -211,7 +211,7 @@ namespace FdoSecrets
         void emitCollectionDeleted(Collection* coll);
         void emitItemCreated(Item* item);
         void emitItemChanged(Item* item);
-        void emitItemDeleted(Item* item);
+        void emitItemDeleted(Collection* coll, const QDBusObjectPath& itemPath);
         void emitPromptCompleted(bool dismissed, QVariant result);
 
         void dbusServiceUnregistered(const QString& service);
@@ -31,6 +31,12 @@
 
 namespace FdoSecrets
 {
+    namespace
+    {
+        // Flush coalesced item signals early once this many are pending within one event loop turn
+        constexpr int MaxPendingItemSignals = 1000;
+    } // namespace
+
     Collection* Collection::Create(Service* parent, DatabaseWidget* backend)
     {
         return new Collection(parent, backend);
@@ -56,6 +62,10 @@ namespace FdoSecrets
             }
             emit doneUnlockCollection(accepted);
         });
+
+        m_itemSignalTimer.setSingleShot(true);
+        m_itemSignalTimer.setInterval(0);
+        connect(&m_itemSignalTimer, &QTimer::timeout, this, &Collection::flushItemSignals);
     }
 
     bool Collection::reloadBackend()
@@ -69,6 +79,8 @@ namespace FdoSecrets
             m_items.first()->removeFromDBus();
         }
         cleanupConnections();
+        // deliver pending item signals while still on the old path
+        flushItemSignals();
         dbus()->unregisterObject(this);
 
         // make sure we have updated copy of the filepath, which is used to identify the database.
@@ -510,15 +522,93 @@ namespace FdoSecrets
         });
 
         // relay signals
-        connect(item, &Item::itemChanged, this, [this, item]() { emit itemChanged(item); });
+        connect(item, &Item::itemChanged, this, [this, item]() { queueItemChanged(item); });
         connect(item, &Item::itemAboutToDelete, this, [this, item]() {
             m_items.removeAll(item);
             m_entryToItem.remove(item->backend());
-            emit itemDeleted(item);
+            queueItemDeleted(item);
         });
 
         if (emitSignal) {
-            emit itemCreated(item);
+            queueItemCreated(item);
+        }
+    }
+
+    void Collection::queueItemCreated(Item* item)
+    {
+        m_pendingCreatedSet.insert(item);
+        m_pendingCreated << item;
+        scheduleItemSignals();
+    }
+
+    void Collection::queueItemChanged(Item* item)
+    {
+        // bulk operations modify the same entry many times, announce it only once
+        if (m_pendingChangedSet.contains(item)) {
+            return;
+        }
+        m_pendingChangedSet.insert(item);
+        m_pendingChanged << item;
+        scheduleItemSignals();
+    }
+
+    void Collection::queueItemDeleted(Item* item)
+    {
+        // the lists may keep the stale pointer, only members of the sets are emitted
+        m_pendingChangedSet.remove(item);
+        if (m_pendingCreatedSet.remove(item)) {
+            // never announced, so there is nothing to retract either
+            return;
+        }
+        m_pendingDeleted << item->objectPath();
+        scheduleItemSignals();
+    }
+
+    void Collection::scheduleItemSignals()
+    {
+        if (m_pendingCreated.size() + m_pendingChanged.size() + m_pendingDeleted.size() >= MaxPendingItemSignals) {
+            flushItemSignals();
+        } else if (!m_itemSignalTimer.isActive()) {
+            m_itemSignalTimer.start();
+        }
+    }
+
+    /**
+     * Emit the coalesced item signals. Deletions go first because an entry moved between groups
+     * is deleted and recreated at the same object path.
+     */
+    void Collection::flushItemSignals()
+    {
+        m_itemSignalTimer.stop();
+
+        QList<QDBusObjectPath> deleted;
+        QList<Item*> created;
+        QList<Item*> changed;
+        QSet<const Item*> createdSet;
+        QSet<const Item*> changedSet;
+        deleted.swap(m_pendingDeleted);
+        created.swap(m_pendingCreated);
+        changed.swap(m_pendingChanged);
+        createdSet.swap(m_pendingCreatedSet);
+        changedSet.swap(m_pendingChangedSet);
+
+        if (!m_backend) {
+            // already removed from dbus
+            return;
+        }
+
+        for (const auto& path : asConst(deleted)) {
+            emit itemDeleted(path);
+        }
+        for (auto item : asConst(created)) {
+            if (createdSet.remove(item)) {
+                emit itemCreated(item);
+            }
+        }
+        for (auto item : asConst(changed)) {
+            if (changedSet.remove(item)) {
+                emit itemChanged(item);
+            }
         }
     }
 
@@ -572,6 +662,7 @@ namespace FdoSecrets
             return;
         }
 
+        flushItemSignals();
         emit collectionAboutToDelete();
 
         // remove from dbus early
@@ -23,6 +23,8 @@
 
 #include "core/EntrySearcher.h"
 
+#include <QTimer>
+
 class Database;
 class DatabaseWidget;
 class Entry;
@@ -71,8 +73,10 @@ namespace FdoSecrets
         createItem(const QVariantMap& properties, const Secret& secret, bool replace, Item*& item, PromptBase*& prompt);
 
     signals:
+        // Item signals are coalesced and emitted at most once per event loop turn, see flushItemSignals
         void itemCreated(Item* item);
-        void itemDeleted(Item* item);
+        // the item object may already be gone by the time this is emitted, so only its former path is given
+        void itemDeleted(const QDBusObjectPath& itemPath);
         void itemChanged(Item* item);
 
         void collectionChanged();
@@ -140,6 +144,11 @@ namespace FdoSecrets
         friend class CreateCollectionPrompt;
 
         void onEntryAdded(Entry* entry, bool emitSignal);
+        void queueItemCreated(Item* item);
+        void queueItemChanged(Item* item);
+        void queueItemDeleted(Item* item);
+        void scheduleItemSignals();
+        void flushItemSignals();
         void populateContents();
         void connectGroupSignalRecursive(Group* group);
         void cleanupConnections();
@@ -173,6 +182,14 @@ namespace FdoSecrets
         QSet<QString> m_aliases;
         QList<Item*> m_items;
         QMap<const Entry*, Item*> m_entryToItem;
+
+        // pending item signals, see flushItemSignals
+        QTimer m_itemSignalTimer;
+        QList<Item*> m_pendingCreated;
+        QSet<const Item*> m_pendingCreatedSet;
+        QList<Item*> m_pendingChanged;
+        QSet<const Item*> m_pendingChangedSet;
+        QList<QDBusObjectPath> m_pendingDeleted;
     };
 
 } // namespace FdoSecrets
@@ -18,6 +18,7 @@
 
 #include "CsvExporter.h"
 
+#include <QBuffer>
 #include <QFile>
 
 #include "core/Group.h"
@@ -34,22 +35,24 @@ bool CsvExporter::exportDatabase(const QString& filename, const QSharedPointer<c
 
 bool CsvExporter::exportDatabase(QIODevice* device, const QSharedPointer<const Database>& db)
 {
-    if (device->write(exportHeader().toUtf8()) == -1) {
-        m_error = device->errorString();
-        return false;
-    }
+    m_entriesWritten = 0;
+    m_entriesTotal = m_progressCallback ? db->rootGroup()->entriesRecursive(false).size() : 0;
 
-    if (device->write(exportGroup(db->rootGroup()).toUtf8()) == -1) {
+    if (device->write(exportHeader().toUtf8()) == -1) {
         m_error = device->errorString();
         return false;
     }
 
-    return true;
+    // Rows are written as groups are visited instead of building the whole document first
+    return exportGroup(device, db->rootGroup());
 }
 
 QString CsvExporter::exportDatabase(const QSharedPointer<const Database>& db)
 {
-    return exportHeader() + exportGroup(db->rootGroup());
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    exportDatabase(&buffer, db);
+    return QString::fromUtf8(buffer.data());
 }
 
 QString CsvExporter::errorString() const
@@ -57,6 +60,11 @@ QString CsvExporter::errorString() const
     return m_error;
 }
 
+void CsvExporter::setProgressCallback(ProgressCallback callback)
+{
+    m_progressCallback = std::move(callback);
+}
+
 QString CsvExporter::exportHeader()
 {
     QString header;
@@ -73,9 +81,8 @@ QString CsvExporter::exportHeader()
     return header + QString("\n");
 }
 
-QString CsvExporter::exportGroup(const Group* group, QString groupPath)
+bool CsvExporter::exportGroup(QIODevice* device, const Group* group, QString groupPath)
 {
-    QString response;
     if (!groupPath.isEmpty()) {
         groupPath.append("/");
     }
@@ -97,15 +104,24 @@ QString CsvExporter::exportGroup(const Group* group, QString groupPath)
         addColumn(line, entry->timeInfo().creationTime().toString(Qt::ISODate));
 
         line.append("\n");
-        response.append(line);
+        if (device->write(line.toUtf8()) == -1) {
+            m_error = device->errorString();
+            return false;
+        }
+
+        if (m_progressCallback) {
+            m_progressCallback(++m_entriesWritten, m_entriesTotal);
+        }
     }
 
     const QList<Group*>& children = group->children();
     for (const Group* child : children) {
-        response.append(exportGroup(child, groupPath));
+        if (!exportGroup(device, child, groupPath)) {
+            return false;
+        }
     }
 
-    return response;
+    return true;
 }
 
 void CsvExporter::addColumn(QString& str, const QString& column)
@@ -21,6 +21,7 @@
 
 #include <QSharedPointer>
 #include <QString>
+#include <functional>
 
 class Database;
 class Group;
@@ -29,17 +30,27 @@ class QIODevice;
 class CsvExporter
 {
 public:
+    /**
+     * Called after each entry has been written with the number of
+     * entries written so far and the total number of entries.
+     */
+    typedef std::function<void(int, int)> ProgressCallback;
+
     bool exportDatabase(const QString& filename, const QSharedPointer<const Database>& db);
     bool exportDatabase(QIODevice* device, const QSharedPointer<const Database>& db);
     QString exportDatabase(const QSharedPointer<const Database>& db);
     QString errorString() const;
+    void setProgressCallback(ProgressCallback callback);
 
 private:
-    QString exportGroup(const Group* group, QString groupPath = QString());
+    bool exportGroup(QIODevice* device, const Group* group, QString groupPath = QString());
     QString exportHeader();
     void addColumn(QString& str, const QString& column);
 
     QString m_error;
+    ProgressCallback m_progressCallback;
+    int m_entriesWritten = 0;
+    int m_entriesTotal = 0;
 };
 
 #endif // KEEPASSX_CSVEXPORTER_H
@@ -18,6 +18,8 @@
 #include "Kdbx4Writer.h"
 
 #include <QBuffer>
+#include <array>
+#include <cmath>
 
 #include "config-keepassx.h"
 #include "crypto/CryptoHash.h"
@@ -27,6 +29,43 @@
 #include "streams/SymmetricCipherStream.h"
 #include "streams/qtiocompressor.h"
 
+namespace
+{
+    // Smaller attachments are always compressed, switching the level costs a deflate block
+    const int IncompressibleMinSize = 16 * 1024;
+    const int EntropySampleSize = 4096;
+    // Bits per byte above which deflate gains next to nothing
+    const double IncompressibleEntropy = 7.5;
+
+    /**
+     * Whether data is most likely compressed or encrypted already, judged by
+     * the byte entropy of samples taken at its start, middle and end.
+     */
+    bool isIncompressible(const QByteArray& data)
+    {
+        if (data.size() < IncompressibleMinSize) {
+            return false;
+        }
+
+        std::array<int, 256> counts{};
+        const int middle = (data.size() - EntropySampleSize) / 2;
+        for (int offset : {0, middle, data.size() - EntropySampleSize}) {
+            for (int i = offset; i < offset + EntropySampleSize; ++i) {
+                ++counts[static_cast<uchar>(data.at(i))];
+            }
+        }
+
+        const double total = 3 * EntropySampleSize;
+        double entropy = 0.0;
+        for (int count : counts) {
+            if (count > 0) {
+                entropy -= count / total * std::log2(count / total);
+            }
+        }
+        return entropy > IncompressibleEntropy;
+    }
+} // namespace
+
 bool Kdbx4Writer::writeDatabase(QIODevice* device, Database* db)
 {
     m_error = false;
@@ -156,7 +195,10 @@ bool Kdbx4Writer::writeDatabase(QIODevice* device, Database* db)
         writeInnerHeaderField(outputDevice, KeePass2::InnerHeaderFieldID::InnerRandomStreamKey, protectedStreamKey));
 
     // Write attachments to the inner header
-    auto idxMap = writeAttachments(outputDevice, db);
+    auto idxMap = writeAttachments(outputDevice, db, ioCompressor.data());
+    if (hasError()) {
+        return false;
+    }
 
     CHECK_RETURN_FALSE(writeInnerHeaderField(outputDevice, KeePass2::InnerHeaderFieldID::End, QByteArray()));
 
@@ -211,12 +253,22 @@ bool Kdbx4Writer::writeInnerHeaderField(QIODevice* device, KeePass2::InnerHeader
     return true;
 }
 
-KdbxXmlWriter::BinaryIdxMap Kdbx4Writer::writeAttachments(QIODevice* device, Database* db)
+/**
+ * Write all attachments of the database to the inner header, deduplicated.
+ *
+ * @param device output device
+ * @param db source database
+ * @param compressor compressor of the output device, if any; incompressible
+ *        attachments are stored without compression
+ * @return binary pool index for each attachment, empty if the compression level could not be changed
+ */
+KdbxXmlWriter::BinaryIdxMap Kdbx4Writer::writeAttachments(QIODevice* device, Database* db, QtIOCompressor* compressor)
 {
     const QList<Entry*> allEntries = db->rootGroup()->entriesRecursive(true);
     QHash<QByteArray, qint64> writtenAttachments;
     KdbxXmlWriter::BinaryIdxMap idxMap;
     qint64 nextIdx = 0;
+    const int compressionLevel = compressor ? compressor->compressionLevel() : 0;
 
     for (const Entry* entry : allEntries) {
         const QList<QString> attachmentKeys = entry->attachments()->keys();
@@ -243,6 +295,11 @@ KdbxXmlWriter::BinaryIdxMap Kdbx4Writer::writeAttachments(QIODevice* device, Dat
             // Deduplicate attachments with the same hash
             const auto hashResult = hash.result();
             if (!writtenAttachments.contains(hashResult)) {
+                // Pass already compressed data through as stored blocks instead of deflating it again
+                if (compressor && !compressor->setCompressionLevel(isIncompressible(data) ? 0 : compressionLevel)) {
+                    raiseError(compressor->errorString());
+                    return {};
+                }
                 writeInnerHeaderField(device, KeePass2::InnerHeaderFieldID::Binary, data);
                 writtenAttachments.insert(hashResult, nextIdx++);
             }
@@ -250,6 +307,12 @@ KdbxXmlWriter::BinaryIdxMap Kdbx4Writer::writeAttachments(QIODevice* device, Dat
         }
     }
 
+    // The XML that follows is compressed normally
+    if (compressor && !compressor->setCompressionLevel(compressionLevel)) {
+        raiseError(compressor->errorString());
+        return {};
+    }
+
     return idxMap;
 }
 
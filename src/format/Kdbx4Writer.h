@@ -21,6 +21,8 @@
 #include "KdbxWriter.h"
 #include "format/KdbxXmlWriter.h"
 
+class QtIOCompressor;
+
 /**
  * KDBX4 writer implementation.
  */
@@ -33,7 +35,7 @@ public:
 
 private:
     bool writeInnerHeaderField(QIODevice* device, KeePass2::InnerHeaderFieldID fieldId, const QByteArray& data);
-    KdbxXmlWriter::BinaryIdxMap writeAttachments(QIODevice* device, Database* db);
+    KdbxXmlWriter::BinaryIdxMap writeAttachments(QIODevice* device, Database* db, QtIOCompressor* compressor);
     static bool serializeVariantMap(const QVariantMap& map, QByteArray& outputBytes);
 };
 
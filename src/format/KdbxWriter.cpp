@@ -71,10 +71,26 @@ void KdbxWriter::extractDatabase(QByteArray& xmlOutput, Database* db)
     QBuffer buffer;
     buffer.setBuffer(&xmlOutput);
     buffer.open(QIODevice::WriteOnly);
+    extractDatabase(&buffer, db);
+}
+
+/**
+ * Write the unencrypted XML of a database directly to a device.
+ *
+ * @param device output device
+ * @param db source database
+ * @param progress optional progress callback, see KdbxXmlWriter::setProgressCallback()
+ */
+void KdbxWriter::extractDatabase(QIODevice* device, Database* db, const KdbxXmlWriter::ProgressCallback& progress)
+{
     KdbxXmlWriter::BinaryIdxMap idxMap;
     KdbxXmlWriter writer(db->formatVersion(), idxMap);
     writer.disableInnerStreamProtection(true);
-    writer.writeDatabase(&buffer, db);
+    writer.setProgressCallback(progress);
+    writer.writeDatabase(device, db);
+    if (writer.hasError()) {
+        raiseError(writer.errorString());
+    }
 }
 
 /**
@@ -18,6 +18,7 @@
 #ifndef KEEPASSXC_KDBXWRITER_H
 #define KEEPASSXC_KDBXWRITER_H
 
+#include "KdbxXmlWriter.h"
 #include "KeePass2.h"
 #include "core/Endian.h"
 
@@ -53,6 +54,7 @@ public:
     virtual bool writeDatabase(QIODevice* device, Database* db) = 0;
 
     void extractDatabase(QByteArray& xmlOutput, Database* db);
+    void extractDatabase(QIODevice* device, Database* db, const KdbxXmlWriter::ProgressCallback& progress = {});
 
     bool hasError() const;
     QString errorString() const;
@@ -158,6 +158,11 @@ void KdbxXmlReader::readDatabase(QIODevice* device, Database* db, KeePass2Random
     }
 }
 
+void KdbxXmlReader::setProgressCallback(ProgressCallback callback)
+{
+    m_progressCallback = std::move(callback);
+}
+
 bool KdbxXmlReader::strictMode() const
 {
     return m_strictMode;
@@ -440,6 +445,13 @@ void KdbxXmlReader::parseCustomDataItem(CustomData* customData)
     }
 
     if (keySet && valueSet) {
+        // The same few keys repeat on every entry, share one string for each of them
+        const auto sharedKey = m_customDataKeys.constFind(key);
+        if (sharedKey != m_customDataKeys.constEnd()) {
+            key = *sharedKey;
+        } else {
+            m_customDataKeys.insert(key);
+        }
         customData->set(key, item);
         return;
     }
@@ -589,6 +601,11 @@ Group* KdbxXmlReader::parseGroup()
             if (newEntry) {
                 entries.append(newEntry);
             }
+            if (m_progressCallback) {
+                auto device = m_xml.device();
+                const bool sized = device && !device->isSequential();
+                m_progressCallback(sized ? device->pos() : 0, sized ? device->size() : 0);
+            }
             continue;
         }
         if (m_xml.name() == "CustomData") {
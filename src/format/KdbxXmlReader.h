@@ -23,7 +23,9 @@
 
 #include <QCoreApplication>
 #include <QMultiHash>
+#include <QSet>
 #include <QXmlStreamReader>
+#include <functional>
 
 class QIODevice;
 class Group;
@@ -39,6 +41,13 @@ class KdbxXmlReader
     Q_DECLARE_TR_FUNCTIONS(KdbxXmlReader)
 
 public:
+    /**
+     * Called after each top-level entry has been parsed with the approximate
+     * number of bytes read so far and the total input size, both 0 if the
+     * input is sequential.
+     */
+    typedef std::function<void(qint64, qint64)> ProgressCallback;
+
     explicit KdbxXmlReader(quint32 version);
     explicit KdbxXmlReader(quint32 version, QHash<QString, QByteArray> binaryPool);
     virtual ~KdbxXmlReader() = default;
@@ -54,6 +63,7 @@ public:
 
     bool strictMode() const;
     void setStrictMode(bool strictMode);
+    void setProgressCallback(ProgressCallback callback);
 
 protected:
     typedef QPair<QString, QString> StringPair;
@@ -99,6 +109,7 @@ protected:
     const quint32 m_kdbxVersion;
 
     bool m_strictMode = false;
+    ProgressCallback m_progressCallback;
 
     QPointer<Database> m_db;
     QPointer<Metadata> m_meta;
@@ -109,6 +120,8 @@ protected:
     QHash<QUuid, Group*> m_groups;
     QHash<QUuid, Entry*> m_entries;
 
+    QSet<QString> m_customDataKeys;
+
     QHash<QString, QByteArray> m_binaryPool;
     QMultiHash<QString, QPair<Entry*, QString>> m_binaryMap;
     QByteArray m_headerHash;
@@ -61,6 +61,9 @@ void KdbxXmlWriter::writeDatabase(QIODevice* device,
         fillBinaryIdxMap();
     }
 
+    m_entriesWritten = 0;
+    m_entriesTotal = m_progressCallback ? db->rootGroup()->entriesRecursive(false).size() : 0;
+
     m_xml.setDevice(device);
     m_xml.writeStartDocument("1.0", true);
     m_xml.writeStartElement("KeePassFile");
@@ -83,6 +86,16 @@ void KdbxXmlWriter::writeDatabase(const QString& filename, Database* db)
     writeDatabase(&file, db);
 }
 
+/**
+ * Report progress while the database is written. The XML is written to the
+ * device as groups are visited, so the callback can also be used to flush
+ * the output device at regular intervals.
+ */
+void KdbxXmlWriter::setProgressCallback(ProgressCallback callback)
+{
+    m_progressCallback = std::move(callback);
+}
+
 bool KdbxXmlWriter::hasError()
 {
     return m_error;
@@ -342,6 +355,9 @@ void KdbxXmlWriter::writeGroup(const Group* group)
     const QList<Entry*>& entryList = group->entries();
     for (const Entry* entry : entryList) {
         writeEntry(entry);
+        if (m_progressCallback) {
+            m_progressCallback(++m_entriesWritten, m_entriesTotal);
+        }
     }
 
     const QList<Group*>& children = group->children();
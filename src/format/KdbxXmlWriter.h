@@ -20,6 +20,7 @@
 
 #include <QDateTime>
 #include <QXmlStreamWriter>
+#include <functional>
 
 #include "core/CustomData.h"
 #include "core/Group.h"
@@ -35,6 +36,12 @@ public:
      */
     typedef QHash<QPair<const Entry*, QString>, qint64> BinaryIdxMap;
 
+    /**
+     * Called after each (non-history) entry has been written with the
+     * number of entries written so far and the total number of entries.
+     */
+    typedef std::function<void(int, int)> ProgressCallback;
+
     explicit KdbxXmlWriter(quint32 version);
     explicit KdbxXmlWriter(quint32 version, KdbxXmlWriter::BinaryIdxMap binaryIdxMap);
 
@@ -43,6 +50,7 @@ public:
                        KeePass2RandomStream* randomStream = nullptr,
                        const QByteArray& headerHash = QByteArray());
     void writeDatabase(const QString& filename, Database* db);
+    void setProgressCallback(ProgressCallback callback);
     void disableInnerStreamProtection(bool disable);
     bool innerStreamProtectionDisabled() const;
     bool hasError();
@@ -93,6 +101,9 @@ private:
     KeePass2RandomStream* m_randomStream = nullptr;
     BinaryIdxMap m_binaryIdxMap;
     QByteArray m_headerHash;
+    ProgressCallback m_progressCallback;
+    int m_entriesWritten = 0;
+    int m_entriesTotal = 0;
 
     bool m_error = false;
 
@@ -26,9 +26,9 @@
 #include "core/Metadata.h"
 #include "core/Tools.h"
 #include "crypto/CryptoHash.h"
+#include "crypto/SymmetricCipher.h"
 #include "format/KeePass1.h"
 #include "keys/FileKey.h"
-#include "streams/SymmetricCipherStream.h"
 
 class KeePass1Key : public CompositeKey
 {
@@ -43,6 +43,39 @@ private:
     QByteArray m_keyfileData;
 };
 
+namespace
+{
+    // The decrypted body is parsed in place: field data is handed out as
+    // views on the body buffer instead of being copied for every field.
+    template <typename SizedInt> bool readFieldInt(const QByteArray& content, int& pos, SizedInt& value)
+    {
+        if (content.size() - pos < static_cast<int>(sizeof(SizedInt))) {
+            return false;
+        }
+        value = Endian::bytesToSizedInt<SizedInt>(
+            QByteArray::fromRawData(content.constData() + pos, sizeof(SizedInt)), KeePass1::BYTEORDER);
+        pos += sizeof(SizedInt);
+        return true;
+    }
+
+    bool readFieldData(const QByteArray& content, int& pos, int size, QByteArray& fieldData)
+    {
+        if (size < 0 || content.size() - pos < size) {
+            return false;
+        }
+        fieldData = QByteArray::fromRawData(content.constData() + pos, size);
+        pos += size;
+        return true;
+    }
+
+    // Strings are NUL terminated, but the terminator is not guaranteed to be within the field
+    QString fieldString(const QByteArray& fieldData)
+    {
+        return QString::fromUtf8(fieldData.constData(),
+                                 static_cast<int>(qstrnlen(fieldData.constData(), fieldData.size())));
+    }
+} // namespace
+
 KeePass1Reader::KeePass1Reader()
     : m_tmpParent(nullptr)
     , m_device(nullptr)
@@ -159,17 +192,15 @@ KeePass1Reader::readDatabase(QIODevice* device, const QString& password, QIODevi
     kdf->setSeed(m_transformSeed);
     db->setKdf(kdf);
 
-    qint64 contentPos = m_device->pos();
-
-    QScopedPointer<SymmetricCipherStream> cipherStream(testKeys(password, keyfileData, contentPos));
-
-    if (!cipherStream) {
+    QByteArray content;
+    if (!testKeys(password, keyfileData, content)) {
         return {};
     }
 
+    int contentPos = 0;
     QList<Group*> groups;
     for (quint32 i = 0; i < numGroups; i++) {
-        Group* group = readGroup(cipherStream.data());
+        Group* group = readGroup(content, contentPos);
         if (!group) {
             return {};
         }
@@ -178,7 +209,7 @@ KeePass1Reader::readDatabase(QIODevice* device, const QString& password, QIODevi
 
     QList<Entry*> entries;
     for (quint32 i = 0; i < numEntries; i++) {
-        Entry* entry = readEntry(cipherStream.data());
+        Entry* entry = readEntry(content, contentPos);
         if (!entry) {
             return {};
         }
@@ -293,12 +324,19 @@ QString KeePass1Reader::errorString()
     return m_errorStr;
 }
 
-SymmetricCipherStream*
-KeePass1Reader::testKeys(const QString& password, const QByteArray& keyfileData, qint64 contentPos)
+bool KeePass1Reader::testKeys(const QString& password, const QByteArray& keyfileData, QByteArray& content)
 {
     const QList<PasswordEncoding> encodings = {Windows1252, Latin1, UTF8};
 
-    QScopedPointer<SymmetricCipherStream> cipherStream;
+    // Read the encrypted body once; every candidate key is tested against it
+    // and the matching plaintext is parsed directly without decrypting again.
+    const QByteArray encryptedContent = m_device->readAll();
+
+    auto mode = SymmetricCipher::Aes256_CBC;
+    if (m_encryptionFlags & KeePass1::Twofish) {
+        mode = SymmetricCipher::Twofish_CBC;
+    }
+
     QByteArray passwordData;
     QTextCodec* codec = QTextCodec::codecForName("Windows-1252");
     QByteArray passwordDataCorrect = codec->fromUnicode(password);
@@ -330,56 +368,24 @@ KeePass1Reader::testKeys(const QString& password, const QByteArray& keyfileData,
 
         QByteArray finalKey = key(passwordData, keyfileData);
         if (finalKey.isEmpty()) {
-            return nullptr;
-        }
-
-        cipherStream.reset(new SymmetricCipherStream(m_device));
-
-        auto mode = SymmetricCipher::Aes256_CBC;
-        if (m_encryptionFlags & KeePass1::Twofish) {
-            mode = SymmetricCipher::Twofish_CBC;
-        }
-        if (!cipherStream->init(mode, SymmetricCipher::Decrypt, finalKey, m_encryptionIV)) {
-            raiseError(cipherStream->errorString());
-            return nullptr;
-        }
-        if (!cipherStream->open(QIODevice::ReadOnly)) {
-            raiseError(cipherStream->errorString());
-            return nullptr;
+            return false;
         }
 
-        bool success = verifyKey(cipherStream.data());
-
-        cipherStream->reset();
-        cipherStream->close();
-        if (!m_device->seek(contentPos)) {
-            QString msg = tr("unable to seek to content position");
-            if (!m_device->errorString().isEmpty()) {
-                msg.append("\n").append(m_device->errorString());
-            }
-            raiseError(msg);
-
-            return nullptr;
+        // A wrong key almost always fails the padding check, try the next encoding then
+        QByteArray decryptedContent = encryptedContent;
+        if (!SymmetricCipher::decryptCbcParallel(mode, finalKey, m_encryptionIV, decryptedContent)) {
+            continue;
         }
 
-        if (success) {
-            if (!cipherStream->init(mode, SymmetricCipher::Decrypt, finalKey, m_encryptionIV)) {
-                raiseError(cipherStream->errorString());
-                return nullptr;
-            }
-            cipherStream->open(QIODevice::ReadOnly);
-            break;
-        } else {
-            cipherStream.reset();
+        if (verifyKey(decryptedContent)) {
+            content = decryptedContent;
+            return true;
         }
     }
 
-    if (!cipherStream) {
-        raiseError(tr("Invalid credentials were provided, please try again.\n"
-                      "If this reoccurs, then your database file may be corrupt."));
-    }
-
-    return cipherStream.take();
+    raiseError(tr("Invalid credentials were provided, please try again.\n"
+                  "If this reoccurs, then your database file may be corrupt."));
+    return false;
 }
 
 QByteArray KeePass1Reader::key(const QByteArray& password, const QByteArray& keyfileData)
@@ -405,22 +411,12 @@ QByteArray KeePass1Reader::key(const QByteArray& password, const QByteArray& key
     return hash.result();
 }
 
-bool KeePass1Reader::verifyKey(SymmetricCipherStream* cipherStream)
+bool KeePass1Reader::verifyKey(const QByteArray& content)
 {
-    CryptoHash contentHash(CryptoHash::Sha256);
-    QByteArray buffer;
-
-    do {
-        if (!Tools::readFromDevice(cipherStream, buffer)) {
-            return false;
-        }
-        contentHash.addData(buffer);
-    } while (!buffer.isEmpty());
-
-    return contentHash.result() == m_contentHashHeader;
+    return CryptoHash::hash(content, CryptoHash::Sha256) == m_contentHashHeader;
 }
 
-Group* KeePass1Reader::readGroup(QIODevice* cipherStream)
+Group* KeePass1Reader::readGroup(const QByteArray& content, int& pos)
 {
     QScopedPointer<Group> group(new Group());
     group->setUpdateTimeinfo(false);
@@ -433,24 +429,24 @@ Group* KeePass1Reader::readGroup(QIODevice* cipherStream)
     bool groupIdSet = false;
     bool groupLevelSet = false;
 
-    bool ok;
     bool reachedEnd = false;
 
     do {
-        auto fieldType = Endian::readSizedInt<quint16>(cipherStream, KeePass1::BYTEORDER, &ok);
-        if (!ok) {
+        quint16 fieldType;
+        if (!readFieldInt(content, pos, fieldType)) {
             raiseError(tr("Invalid group field type number"));
             return nullptr;
         }
 
-        auto fieldSize = static_cast<int>(Endian::readSizedInt<quint32>(cipherStream, KeePass1::BYTEORDER, &ok));
-        if (!ok) {
+        quint32 rawFieldSize;
+        if (!readFieldInt(content, pos, rawFieldSize)) {
             raiseError(tr("Invalid group field size"));
             return nullptr;
         }
+        auto fieldSize = static_cast<int>(rawFieldSize);
 
-        QByteArray fieldData = cipherStream->read(fieldSize);
-        if (fieldData.size() != fieldSize) {
+        QByteArray fieldData;
+        if (!readFieldData(content, pos, fieldSize, fieldData)) {
             raiseError(tr("Read group field data doesn't match size"));
             return nullptr;
         }
@@ -468,7 +464,7 @@ Group* KeePass1Reader::readGroup(QIODevice* cipherStream)
             groupIdSet = true;
             break;
         case 0x0002:
-            group->setName(QString::fromUtf8(fieldData.constData()));
+            group->setName(fieldString(fieldData));
             break;
         case 0x0003: {
             if (fieldSize != 5) {
@@ -557,7 +553,7 @@ Group* KeePass1Reader::readGroup(QIODevice* cipherStream)
     return group.take();
 }
 
-Entry* KeePass1Reader::readEntry(QIODevice* cipherStream)
+Entry* KeePass1Reader::readEntry(const QByteArray& content, int& pos)
 {
     QScopedPointer<Entry> entry(new Entry());
     entry->setUpdateTimeinfo(false);
@@ -565,24 +561,24 @@ Entry* KeePass1Reader::readEntry(QIODevice* cipherStream)
 
     TimeInfo timeInfo;
     QString binaryName;
-    bool ok;
     bool reachedEnd = false;
 
     do {
-        auto fieldType = Endian::readSizedInt<quint16>(cipherStream, KeePass1::BYTEORDER, &ok);
-        if (!ok) {
+        quint16 fieldType;
+        if (!readFieldInt(content, pos, fieldType)) {
             raiseError(tr("Missing entry field type number"));
             return nullptr;
         }
 
-        auto fieldSize = static_cast<int>(Endian::readSizedInt<quint32>(cipherStream, KeePass1::BYTEORDER, &ok));
-        if (!ok) {
+        quint32 rawFieldSize;
+        if (!readFieldInt(content, pos, rawFieldSize)) {
             raiseError(tr("Invalid entry field size"));
             return nullptr;
         }
+        auto fieldSize = static_cast<int>(rawFieldSize);
 
-        QByteArray fieldData = cipherStream->read(fieldSize);
-        if (fieldData.size() != fieldSize) {
+        QByteArray fieldData;
+        if (!readFieldData(content, pos, fieldSize, fieldData)) {
             raiseError(tr("Read entry field data doesn't match size"));
             return nullptr;
         }
@@ -596,7 +592,7 @@ Entry* KeePass1Reader::readEntry(QIODevice* cipherStream)
                 raiseError(tr("Invalid entry UUID field size"));
                 return nullptr;
             }
-            m_entryUuids.insert(fieldData, entry.data());
+            m_entryUuids.insert(QByteArray(fieldData.constData(), fieldSize), entry.data());
             break;
         case 0x0002: {
             if (fieldSize != 4) {
@@ -617,19 +613,19 @@ Entry* KeePass1Reader::readEntry(QIODevice* cipherStream)
             break;
         }
         case 0x0004:
-            entry->setTitle(QString::fromUtf8(fieldData.constData()));
+            entry->setTitle(fieldString(fieldData));
             break;
         case 0x0005:
-            entry->setUrl(QString::fromUtf8(fieldData.constData()));
+            entry->setUrl(fieldString(fieldData));
             break;
         case 0x0006:
-            entry->setUsername(QString::fromUtf8(fieldData.constData()));
+            entry->setUsername(fieldString(fieldData));
             break;
         case 0x0007:
-            entry->setPassword(QString::fromUtf8(fieldData.constData()));
+            entry->setPassword(fieldString(fieldData));
             break;
         case 0x0008:
-            parseNotes(QString::fromUtf8(fieldData.constData()), entry.data());
+            parseNotes(fieldString(fieldData), entry.data());
             break;
         case 0x0009: {
             if (fieldSize != 5) {
@@ -677,11 +673,11 @@ Entry* KeePass1Reader::readEntry(QIODevice* cipherStream)
             break;
         }
         case 0x000D:
-            binaryName = QString::fromUtf8(fieldData.constData());
+            binaryName = fieldString(fieldData);
             break;
         case 0x000E:
             if (fieldSize != 0) {
-                entry->attachments()->set(binaryName, fieldData);
+                entry->attachments()->set(binaryName, QByteArray(fieldData.constData(), fieldSize));
             }
             break;
         case 0xFFFF:
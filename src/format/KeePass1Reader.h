@@ -24,7 +24,6 @@
 class Database;
 class Entry;
 class Group;
-class SymmetricCipherStream;
 class QIODevice;
 
 class KeePass1Reader
@@ -47,11 +46,11 @@ private:
         UTF8
     };
 
-    SymmetricCipherStream* testKeys(const QString& password, const QByteArray& keyfileData, qint64 contentPos);
+    bool testKeys(const QString& password, const QByteArray& keyfileData, QByteArray& content);
     QByteArray key(const QByteArray& password, const QByteArray& keyfileData);
-    bool verifyKey(SymmetricCipherStream* cipherStream);
-    Group* readGroup(QIODevice* cipherStream);
-    Entry* readEntry(QIODevice* cipherStream);
+    bool verifyKey(const QByteArray& content);
+    Group* readGroup(const QByteArray& content, int& pos);
+    Entry* readEntry(const QByteArray& content, int& pos);
     void parseNotes(const QString& rawNotes, Entry* entry);
     bool constructGroupTree(const QList<Group*>& groups);
     void parseMetaStream(const Entry* entry);
@@ -141,6 +141,22 @@ bool KeePass2Writer::writeDatabase(QIODevice* device, Database* db)
 }
 
 void KeePass2Writer::extractDatabase(Database* db, QByteArray& xmlOutput)
+{
+    prepareExtract(db);
+    m_writer->extractDatabase(xmlOutput, db);
+}
+
+/**
+ * Stream the unencrypted XML of a database to a device without
+ * buffering the whole document in memory.
+ */
+void KeePass2Writer::extractDatabase(Database* db, QIODevice* device, const KdbxXmlWriter::ProgressCallback& progress)
+{
+    prepareExtract(db);
+    m_writer->extractDatabase(device, db, progress);
+}
+
+void KeePass2Writer::prepareExtract(Database* db)
 {
     m_error = false;
     m_errorStr.clear();
@@ -154,8 +170,6 @@ void KeePass2Writer::extractDatabase(Database* db, QByteArray& xmlOutput)
         Q_ASSERT(m_version >= KeePass2::FILE_VERSION_4);
         m_writer.reset(new Kdbx4Writer());
     }
-
-    m_writer->extractDatabase(xmlOutput, db);
 }
 
 bool KeePass2Writer::hasError() const
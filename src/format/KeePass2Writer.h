@@ -33,6 +33,7 @@ public:
     bool writeDatabase(const QString& filename, Database* db);
     bool writeDatabase(QIODevice* device, Database* db);
     void extractDatabase(Database* db, QByteArray& xmlOutput);
+    void extractDatabase(Database* db, QIODevice* device, const KdbxXmlWriter::ProgressCallback& progress = {});
     static quint32 kdbxVersionRequired(Database const* db, bool ignoreCurrent = false, bool ignoreKdf = false);
 
     QSharedPointer<KdbxWriter> writer() const;
@@ -42,6 +43,7 @@ public:
     QString errorString() const;
 
 private:
+    void prepareExtract(Database* db);
     void raiseError(const QString& errorMessage);
 
     bool m_error = false;
@@ -37,6 +37,9 @@
 #ifdef WITH_XC_BROWSER
 #include "browser/BrowserSettingsPage.h"
 #endif
+#ifdef WITH_XC_NETWORKING
+#include "gui/IconDownloader.h"
+#endif
 
 class ApplicationSettingsWidget::ExtraPage
 {
@@ -183,6 +186,7 @@ ApplicationSettingsWidget::ApplicationSettingsWidget(QWidget* parent)
     m_secUi->privacy->setVisible(false);
     m_generalUi->faviconTimeoutLabel->setVisible(false);
     m_generalUi->faviconTimeoutSpinBox->setVisible(false);
+    m_generalUi->faviconCacheCheckBox->setVisible(false);
 #endif
 }
 
@@ -236,6 +240,7 @@ void ApplicationSettingsWidget::loadSettings()
     m_generalUi->autoTypeEntryURLMatchCheckBox->setChecked(config()->get(Config::AutoTypeEntryURLMatch).toBool());
     m_generalUi->autoTypeHideExpiredEntryCheckBox->setChecked(config()->get(Config::AutoTypeHideExpiredEntry).toBool());
     m_generalUi->faviconTimeoutSpinBox->setValue(config()->get(Config::FaviconDownloadTimeout).toInt());
+    m_generalUi->faviconCacheCheckBox->setChecked(config()->get(Config::FaviconDiskCache).toBool());
     m_generalUi->ConfirmMoveEntryToRecycleBinCheckBox->setChecked(
         !config()->get(Config::Security_NoConfirmMoveEntryToRecycleBin).toBool());
     m_generalUi->EnableCopyOnDoubleClickCheckBox->setChecked(
@@ -392,6 +397,12 @@ void ApplicationSettingsWidget::saveSettings()
     config()->set(Config::AutoTypeEntryURLMatch, m_generalUi->autoTypeEntryURLMatchCheckBox->isChecked());
     config()->set(Config::AutoTypeHideExpiredEntry, m_generalUi->autoTypeHideExpiredEntryCheckBox->isChecked());
     config()->set(Config::FaviconDownloadTimeout, m_generalUi->faviconTimeoutSpinBox->value());
+#ifdef WITH_XC_NETWORKING
+    config()->set(Config::FaviconDiskCache, m_generalUi->faviconCacheCheckBox->isChecked());
+    if (!m_generalUi->faviconCacheCheckBox->isChecked()) {
+        IconDownloader::clearCache();
+    }
+#endif
     config()->set(Config::Security_NoConfirmMoveEntryToRecycleBin,
                   !m_generalUi->ConfirmMoveEntryToRecycleBinCheckBox->isChecked());
     config()->set(Config::Security_EnableCopyOnDoubleClick, m_generalUi->EnableCopyOnDoubleClickCheckBox->isChecked());
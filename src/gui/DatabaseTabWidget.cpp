@@ -22,6 +22,7 @@
 
 #include "autotype/AutoType.h"
 #include "core/Merger.h"
+#include "core/MultiDatabaseSearcher.h"
 #include "core/Tools.h"
 #include "format/CsvExporter.h"
 #include "gui/Clipboard.h"
@@ -43,6 +44,7 @@ DatabaseTabWidget::DatabaseTabWidget(QWidget* parent)
     , m_databaseOpenDialog(new DatabaseOpenDialog(this))
     , m_importWizard(nullptr)
     , m_databaseOpenInProgress(false)
+    , m_databaseSearcher(new MultiDatabaseSearcher(this))
 {
     auto* tabBar = new QTabBar(this);
     tabBar->setAcceptDrops(true);
@@ -60,6 +62,9 @@ DatabaseTabWidget::DatabaseTabWidget(QWidget* parent)
     connect(autoType(), SIGNAL(autotypeFinished()), SLOT(relockPendingDatabase()));
     connect(m_databaseOpenDialog.data(), &DatabaseOpenDialog::dialogFinished,
             this, &DatabaseTabWidget::handleDatabaseUnlockDialogFinished);
+    connect(this, SIGNAL(databaseLocked(DatabaseWidget*)), SLOT(refreshSearchAllDatabases()));
+    connect(this, SIGNAL(databaseUnlocked(DatabaseWidget*)), SLOT(refreshSearchAllDatabases()));
+    connect(this, SIGNAL(databaseClosed(QString)), SLOT(refreshSearchAllDatabases()));
     // clang-format on
 
 #ifdef Q_OS_MACOS
@@ -927,6 +932,65 @@ void DatabaseTabWidget::performGlobalAutoType(const QString& search)
     }
 }
 
+/**
+ * Search every unlocked database without blocking the user interface. Results are published
+ * through databaseSearcher(), an empty search string clears them.
+ */
+void DatabaseTabWidget::searchAllDatabases(const QString& searchString)
+{
+    QList<QSharedPointer<Database>> unlockedDatabases;
+    for (int i = 0, c = count(); i < c; ++i) {
+        auto* dbWidget = databaseWidgetFromIndex(i);
+        if (!dbWidget->isLocked()) {
+            unlockedDatabases.append(dbWidget->database());
+        }
+    }
+
+    m_databaseSearcher->search(unlockedDatabases, searchString);
+}
+
+void DatabaseTabWidget::endSearchAllDatabases()
+{
+    m_databaseSearcher->clear();
+}
+
+void DatabaseTabWidget::setSearchAllDatabasesCaseSensitive(bool state)
+{
+    m_databaseSearcher->setCaseSensitive(state);
+    refreshSearchAllDatabases();
+}
+
+void DatabaseTabWidget::refreshSearchAllDatabases()
+{
+    if (!m_databaseSearcher->searchString().isEmpty()) {
+        searchAllDatabases(m_databaseSearcher->searchString());
+    }
+}
+
+/**
+ * Switch to the tab of the database containing the given entry and select it
+ */
+void DatabaseTabWidget::selectEntry(Entry* entry)
+{
+    if (!entry || !entry->group()) {
+        return;
+    }
+
+    for (int i = 0, c = count(); i < c; ++i) {
+        auto* dbWidget = databaseWidgetFromIndex(i);
+        if (!dbWidget->isLocked() && dbWidget->database().data() == entry->group()->database()) {
+            setCurrentIndex(i);
+            dbWidget->restoreGroupEntryFocus(entry->group()->uuid(), entry->uuid());
+            return;
+        }
+    }
+}
+
+MultiDatabaseSearcher* DatabaseTabWidget::databaseSearcher() const
+{
+    return m_databaseSearcher;
+}
+
 void DatabaseTabWidget::performBrowserUnlock()
 {
     if (m_databaseOpenInProgress) {
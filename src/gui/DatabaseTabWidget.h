@@ -28,6 +28,8 @@
 
 class Database;
 class DatabaseWidget;
+class Entry;
+class MultiDatabaseSearcher;
 class DatabaseWidgetStateSync;
 class DatabaseOpenWidget;
 
@@ -47,6 +49,7 @@ public:
     bool canSave(int index = -1) const;
     bool isModified(int index = -1) const;
     bool hasLockableDatabases() const;
+    MultiDatabaseSearcher* databaseSearcher() const;
 
 public slots:
     void lockAndSwitchToFirstUnlockedDatabase(int index = -1);
@@ -95,6 +98,11 @@ public slots:
     void performGlobalAutoType(const QString& search);
     void performBrowserUnlock();
 
+    void searchAllDatabases(const QString& searchString);
+    void endSearchAllDatabases();
+    void setSearchAllDatabasesCaseSensitive(bool state);
+    void selectEntry(Entry* entry);
+
 signals:
     void databaseOpened(DatabaseWidget* dbWidget);
     void databaseClosed(const QString& filePath);
@@ -114,6 +122,7 @@ private slots:
     void handleDatabaseUnlockDialogFinished(bool accepted, DatabaseWidget* dbWidget);
     void handleExportError(const QString& reason);
     void updateLastDatabases();
+    void refreshSearchAllDatabases();
 
 private:
     QSharedPointer<Database> execNewDatabaseWizard();
@@ -126,6 +135,7 @@ private:
     QPointer<DatabaseOpenDialog> m_databaseOpenDialog;
     QPointer<ImportWizard> m_importWizard;
     QTimer m_lockDelayTimer;
+    MultiDatabaseSearcher* m_databaseSearcher;
     bool m_databaseOpenInProgress;
 };
 
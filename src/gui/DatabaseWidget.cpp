@@ -35,6 +35,7 @@
 #include "core/AsyncTask.h"
 #include "core/EntrySearcher.h"
 #include "core/Merger.h"
+#include "core/PasswordHealth.h"
 #include "core/Tools.h"
 #include "gui/Clipboard.h"
 #include "gui/CloneDialog.h"
@@ -259,6 +260,8 @@ DatabaseWidget::~DatabaseWidget()
     // if a copy of the QSharedPointer is created in any slots activated by the Database destructor.
     // More details: https://github.com/keepassxreboot/keepassxc/issues/6393.
     m_db.clear();
+    // Entropies of passwords typed into the editors are not kept past the database
+    PasswordHealth::clearEntropyCache();
 }
 
 QSharedPointer<Database> DatabaseWidget::database() const
@@ -2074,6 +2077,7 @@ bool DatabaseWidget::lock()
 
     endSearch();
     clearAllWidgets();
+    PasswordHealth::clearEntropyCache();
     switchToOpenDatabase(m_db->filePath());
 
     auto newDb = QSharedPointer<Database>::create(m_db->filePath());
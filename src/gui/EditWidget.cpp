@@ -40,6 +40,7 @@ EditWidget::EditWidget(QWidget* parent)
     headlineLabel()->setTextFormat(Qt::PlainText);
 
     connect(m_ui->categoryList, SIGNAL(categoryChanged(int)), m_ui->stackedWidget, SLOT(setCurrentIndex(int)));
+    connect(m_ui->stackedWidget, SIGNAL(currentChanged(int)), SIGNAL(currentPageChanged(int)));
 
     connect(m_ui->buttonBox, SIGNAL(accepted()), SIGNAL(accepted()));
     connect(m_ui->buttonBox, SIGNAL(rejected()), SIGNAL(rejected()));
@@ -126,6 +127,11 @@ void EditWidget::setCurrentPage(int index)
     m_ui->stackedWidget->setCurrentIndex(index);
 }
 
+int EditWidget::currentPage() const
+{
+    return m_ui->stackedWidget->currentIndex();
+}
+
 void EditWidget::setHeadline(const QString& text)
 {
     m_ui->headerLabel->setHidden(text.isEmpty());
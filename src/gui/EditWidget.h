@@ -46,6 +46,7 @@ public:
     int pageIndex(const QWidget* widget) const;
     void setPageHidden(QWidget* widget, bool hidden);
     void setCurrentPage(int index);
+    int currentPage() const;
     void setHeadline(const QString& text);
     QLabel* headlineLabel();
     void setReadOnly(bool readOnly);
@@ -55,6 +56,7 @@ public:
     virtual bool isModified() const;
 
 signals:
+    void currentPageChanged(int index);
     void apply();
     void accepted();
     void rejected();
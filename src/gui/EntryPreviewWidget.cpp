@@ -78,6 +78,8 @@ EntryPreviewWidget::EntryPreviewWidget(QWidget* parent)
     connect(m_ui->toggleEntryNotesButton, SIGNAL(clicked(bool)), SLOT(setEntryNotesVisible(bool)));
     connect(m_ui->toggleGroupNotesButton, SIGNAL(clicked(bool)), SLOT(setGroupNotesVisible(bool)));
     connect(m_ui->entryTabWidget, SIGNAL(tabBarClicked(int)), SLOT(updateTabIndexes()), Qt::QueuedConnection);
+    // Tabs are only rendered once they become visible
+    connect(m_ui->entryTabWidget, SIGNAL(currentChanged(int)), SLOT(renderEntryTab(int)));
     // Prevent the url from being focused after clicked to allow the Copy Password button to work properly
     connect(m_ui->entryUrlLabel, &QLabel::linkActivated, this, [this] {
         openEntryUrl();
@@ -130,6 +132,7 @@ void EntryPreviewWidget::clear()
     hide();
     m_currentEntry = nullptr;
     m_currentGroup = nullptr;
+    m_renderedEntryTabs.clear();
     m_ui->entryAttachmentsWidget->unlinkAttachments();
 }
 
@@ -190,11 +193,14 @@ void EntryPreviewWidget::setGroup(Group* selectedGroup)
 void EntryPreviewWidget::refresh()
 {
     if (m_currentEntry) {
+        // Invalidate all tabs, only the visible one is rendered right away
+        m_renderedEntryTabs.clear();
+        m_ui->entryAttachmentsWidget->unlinkAttachments();
+
+        resolveEntryFields();
         updateEntryHeaderLine();
         updateEntryTotp();
-        updateEntryGeneralTab();
-        updateEntryAdvancedTab();
-        updateEntryAutotypeTab();
+        updateEntryTabStates();
 
         setVisible(!config()->get(Config::GUI_HidePreviewPanel).toBool());
 
@@ -203,6 +209,7 @@ void EntryPreviewWidget::refresh()
             m_ui->entryTabWidget->isTabEnabled(m_selectedTabEntry) ? m_selectedTabEntry : GeneralTabIndex;
         Q_ASSERT(m_ui->entryTabWidget->isTabEnabled(GeneralTabIndex));
         m_ui->entryTabWidget->setCurrentIndex(tabIndex);
+        renderEntryTab(m_ui->entryTabWidget->currentIndex());
     } else if (m_currentGroup) {
         updateGroupHeaderLine();
         updateGroupGeneralTab();
@@ -241,11 +248,67 @@ void EntryPreviewWidget::setDatabaseMode(DatabaseWidget::Mode mode)
     }
 }
 
+/**
+ * Update the displayed entry fields. Placeholders are only resolved for
+ * fields that contain any, most entries are shown without a lookup.
+ */
+void EntryPreviewWidget::resolveEntryFields()
+{
+    Q_ASSERT(m_currentEntry);
+    const EntryFields fields{m_currentEntry->title(),
+                             m_currentEntry->username(),
+                             m_currentEntry->password(),
+                             m_currentEntry->notes(),
+                             m_currentEntry->url()};
+
+    const auto hasPlaceholder = [](const QString& value) { return value.contains('{'); };
+    const bool needsResolve = hasPlaceholder(fields.title) || hasPlaceholder(fields.username)
+                              || hasPlaceholder(fields.password) || hasPlaceholder(fields.notes)
+                              || hasPlaceholder(fields.url);
+    m_entryFields = needsResolve ? resolvePlaceholders(m_currentEntry) : fields;
+}
+
+EntryPreviewWidget::EntryFields EntryPreviewWidget::resolvePlaceholders(const Entry* entry)
+{
+    return {entry->resolveMultiplePlaceholders(entry->title()),
+            entry->resolveMultiplePlaceholders(entry->username()),
+            entry->resolveMultiplePlaceholders(entry->password()),
+            entry->resolveMultiplePlaceholders(entry->notes()),
+            entry->resolveMultiplePlaceholders(entry->url())};
+}
+
+void EntryPreviewWidget::renderEntryTab(int index)
+{
+    auto tab = m_ui->entryTabWidget->widget(index);
+    if (!m_currentEntry || !tab || m_renderedEntryTabs.contains(tab)) {
+        return;
+    }
+
+    if (tab == m_ui->entryGeneralTab) {
+        updateEntryGeneralTab();
+    } else if (tab == m_ui->entryAdvancedTab) {
+        updateEntryAdvancedTab();
+    } else if (tab == m_ui->entryAutotypeTab) {
+        updateEntryAutotypeTab();
+    }
+    m_renderedEntryTabs.insert(tab);
+}
+
+void EntryPreviewWidget::updateEntryTabStates()
+{
+    Q_ASSERT(m_currentEntry);
+    const bool hasAttributes = !m_currentEntry->attributes()->customKeys().isEmpty();
+    const bool hasAttachments = !m_currentEntry->attachments()->isEmpty();
+    setTabEnabled(m_ui->entryTabWidget, m_ui->entryAdvancedTab, hasAttributes || hasAttachments);
+    setTabEnabled(m_ui->entryTabWidget,
+                  m_ui->entryAutotypeTab,
+                  m_currentEntry->autoTypeEnabled() && m_currentEntry->groupAutoTypeEnabled());
+}
+
 void EntryPreviewWidget::updateEntryHeaderLine()
 {
     Q_ASSERT(m_currentEntry);
-    const QString title = m_currentEntry->resolveMultiplePlaceholders(m_currentEntry->title());
-    m_ui->entryTitleLabel->setRawText(hierarchy(m_currentEntry->group(), title));
+    m_ui->entryTitleLabel->setRawText(hierarchy(m_currentEntry->group(), m_entryFields.title));
     m_ui->entryIcon->setPixmap(Icons::entryIconPixmap(m_currentEntry, IconSize::Large));
 }
 
@@ -271,8 +334,7 @@ void EntryPreviewWidget::updateEntryTotp()
 void EntryPreviewWidget::setUsernameVisible(bool state)
 {
     if (state) {
-        auto username = m_currentEntry->resolveMultiplePlaceholders(m_currentEntry->username());
-        m_ui->entryUsernameLabel->setText(username);
+        m_ui->entryUsernameLabel->setText(m_entryFields.username);
         m_ui->entryUsernameLabel->setFont(Font::defaultFont());
         m_ui->entryUsernameLabel->setCursorPosition(0);
     } else {
@@ -287,7 +349,7 @@ void EntryPreviewWidget::setPasswordVisible(bool state)
 {
     m_ui->entryPasswordLabel->setFont(Font::fixedFont());
 
-    const QString password = m_currentEntry->resolveMultiplePlaceholders(m_currentEntry->password());
+    const QString& password = m_entryFields.password;
     if (state) {
         if (config()->get(Config::GUI_ColorPasswords).toBool()) {
             // Show the password in color
@@ -323,8 +385,7 @@ void EntryPreviewWidget::setPasswordVisible(bool state)
 
 void EntryPreviewWidget::setEntryNotesVisible(bool state)
 {
-    setNotesVisible(
-        m_ui->entryNotesTextEdit, m_currentEntry->resolveMultiplePlaceholders(m_currentEntry->notes()), state);
+    setNotesVisible(m_ui->entryNotesTextEdit, m_entryFields.notes, state);
     m_ui->toggleEntryNotesButton->setIcon(icons()->onOffIcon("password-show", state));
 }
 
@@ -393,7 +454,7 @@ void EntryPreviewWidget::updateEntryGeneralTab()
     const QString url = m_currentEntry->url();
     if (!url.isEmpty()) {
         // URL is well formed and can be opened in a browser
-        m_ui->entryUrlLabel->setUrl(m_currentEntry->resolveMultiplePlaceholders(url));
+        m_ui->entryUrlLabel->setUrl(m_entryFields.url);
         m_ui->entryUrlLabel->setCursor(Qt::PointingHandCursor);
         m_ui->entryUrlLabel->setOpenExternalLinks(false);
     } else {
@@ -416,11 +477,9 @@ void EntryPreviewWidget::updateEntryAdvancedTab()
     const EntryAttributes* attributes = m_currentEntry->attributes();
     const QStringList customAttributes = attributes->customKeys();
     const bool hasAttributes = !customAttributes.isEmpty();
-    const bool hasAttachments = !m_currentEntry->attachments()->isEmpty();
     m_ui->entryAttributesTable->setRowCount(customAttributes.size());
     m_ui->entryAttributesTable->setColumnCount(3);
 
-    setTabEnabled(m_ui->entryTabWidget, m_ui->entryAdvancedTab, hasAttributes || hasAttachments);
     if (hasAttributes) {
         auto i = 0;
         QFont font;
@@ -491,9 +550,6 @@ void EntryPreviewWidget::updateEntryAutotypeTab()
     }
 
     m_ui->entryAutotypeTree->addTopLevelItems(items);
-    setTabEnabled(m_ui->entryTabWidget,
-                  m_ui->entryAutotypeTab,
-                  m_currentEntry->autoTypeEnabled() && m_currentEntry->groupAutoTypeEnabled());
 }
 
 void EntryPreviewWidget::updateGroupHeaderLine()
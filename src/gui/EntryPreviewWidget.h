@@ -21,6 +21,8 @@
 #include "config-keepassx.h"
 #include "gui/DatabaseWidget.h"
 
+#include <QSet>
+
 namespace Ui
 {
     class EntryPreviewWidget;
@@ -71,9 +73,23 @@ private slots:
 
     void updateTotpLabel();
     void updateTabIndexes();
+    void renderEntryTab(int index);
     void openEntryUrl();
 
 private:
+    struct EntryFields
+    {
+        QString title;
+        QString username;
+        QString password;
+        QString notes;
+        QString url;
+    };
+
+    void updateEntryTabStates();
+    void resolveEntryFields();
+    static EntryFields resolvePlaceholders(const Entry* entry);
+
     void removeTab(QTabWidget* tabWidget, QWidget* widget);
     void setTabEnabled(QTabWidget* tabWidget, QWidget* widget, bool enabled);
 
@@ -86,6 +102,8 @@ private:
     QTimer m_totpTimer;
     quint8 m_selectedTabEntry;
     quint8 m_selectedTabGroup;
+    QSet<QWidget*> m_renderedEntryTabs;
+    EntryFields m_entryFields;
 };
 
 #endif // KEEPASSX_DETAILSWIDGET_H
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IconDownloadQueue.h"
+
+#include "core/Database.h"
+#include "core/Entry.h"
+#include "core/Metadata.h"
+#include "gui/IconDownloader.h"
+#include "gui/Icons.h"
+
+#include <QUrl>
+
+// Requests to the same host are additionally limited by QNetworkAccessManager
+const int IconDownloadQueue::MaxConcurrentDownloads = 8;
+
+IconDownloadQueue::IconDownloadQueue(QObject* parent)
+    : QObject(parent)
+    , m_finished(0)
+{
+}
+
+IconDownloadQueue::~IconDownloadQueue()
+{
+    abort();
+}
+
+void IconDownloadQueue::setDatabase(const QSharedPointer<Database>& database)
+{
+    m_db = database;
+}
+
+/**
+ * Queue the favicon download for the entry. Entries on the same domain
+ * share a single download.
+ */
+void IconDownloadQueue::addEntry(Entry* entry)
+{
+    const auto url = entry->webUrl();
+    const auto domain = IconDownloader::domainKey(url);
+    if (domain.isEmpty()) {
+        return;
+    }
+
+    auto it = m_jobs.find(domain);
+    if (it == m_jobs.end()) {
+        it = m_jobs.insert(domain, {url, {}});
+        m_pending.append(domain);
+    } else if (QUrl::fromUserInput(url).host().compare(domain.section(':', 0, 0), Qt::CaseInsensitive) == 0) {
+        // Prefer a URL on the domain itself over one of its subdomains
+        it->url = url;
+    }
+    it->entries.append(entry);
+}
+
+void IconDownloadQueue::clear()
+{
+    abort();
+    m_jobs.clear();
+    m_finished = 0;
+}
+
+void IconDownloadQueue::start()
+{
+    startDownloads();
+}
+
+QStringList IconDownloadQueue::domains() const
+{
+    return m_jobs.keys();
+}
+
+int IconDownloadQueue::count() const
+{
+    return m_jobs.size();
+}
+
+int IconDownloadQueue::finishedCount() const
+{
+    return m_finished;
+}
+
+bool IconDownloadQueue::isActive() const
+{
+    return !m_active.isEmpty() || !m_pending.isEmpty();
+}
+
+void IconDownloadQueue::abort()
+{
+    for (auto downloader : m_active.keys()) {
+        downloader->disconnect(this);
+        downloader->deleteLater();
+    }
+    m_active.clear();
+    m_pending.clear();
+}
+
+void IconDownloadQueue::startDownloads()
+{
+    while (m_active.size() < MaxConcurrentDownloads && !m_pending.isEmpty()) {
+        const auto domain = m_pending.takeFirst();
+
+        auto downloader = new IconDownloader(this);
+        connect(downloader, &IconDownloader::finished, this, &IconDownloadQueue::downloadFinished);
+        downloader->setUrl(m_jobs.value(domain).url);
+        m_active.insert(downloader, domain);
+        if (!downloader->download()) {
+            // Nothing to try for this URL
+            m_active.remove(downloader);
+            downloader->deleteLater();
+            finishDomain(domain, Failed);
+        }
+    }
+
+    if (m_active.isEmpty() && m_pending.isEmpty()) {
+        emit finished();
+    }
+}
+
+void IconDownloadQueue::downloadFinished(const QString& url, const QImage& icon)
+{
+    Q_UNUSED(url);
+
+    auto downloader = qobject_cast<IconDownloader*>(sender());
+    if (!downloader || !m_active.contains(downloader)) {
+        return;
+    }
+
+    const auto domain = m_active.take(downloader);
+    downloader->deleteLater();
+
+    finishDomain(domain, applyIcon(m_jobs.value(domain), icon));
+    startDownloads();
+}
+
+void IconDownloadQueue::finishDomain(const QString& domain, Result result)
+{
+    ++m_finished;
+    emit domainFinished(domain, result);
+}
+
+IconDownloadQueue::Result IconDownloadQueue::applyIcon(const Job& job, const QImage& icon)
+{
+    if (!m_db || icon.isNull()) {
+        return Failed;
+    }
+
+    // Don't add an icon larger than 128x128, but retain original size if smaller
+    constexpr auto maxIconSize = 128;
+    auto scaledIcon = icon;
+    if (icon.width() > maxIconSize || icon.height() > maxIconSize) {
+        scaledIcon = icon.scaled(maxIconSize, maxIconSize);
+    }
+
+    auto result = AlreadyExists;
+    QByteArray serializedIcon = Icons::saveToBytes(scaledIcon);
+    QUuid uuid = m_db->metadata()->findCustomIcon(serializedIcon);
+    if (uuid.isNull()) {
+        uuid = QUuid::createUuid();
+        m_db->metadata()->addCustomIcon(uuid, serializedIcon);
+        result = Added;
+    }
+
+    // Set the icon on all the entries associated with this domain
+    for (const auto& entry : job.entries) {
+        if (entry) {
+            entry->setIcon(uuid);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_ICONDOWNLOADQUEUE_H
+#define KEEPASSXC_ICONDOWNLOADQUEUE_H
+
+#include <QHash>
+#include <QMap>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QStringList>
+
+class Database;
+class Entry;
+class IconDownloader;
+class QImage;
+
+/**
+ * Downloads the favicons of many entries at once.
+ *
+ * Entries are grouped by the registrable domain of their URL and every domain
+ * is downloaded only once, with at most MaxConcurrentDownloads downloads
+ * running at the same time. The resulting icon is added to the database once
+ * and set on all entries of the domain.
+ */
+class IconDownloadQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Result
+    {
+        Added,
+        AlreadyExists,
+        Failed
+    };
+
+    explicit IconDownloadQueue(QObject* parent = nullptr);
+    ~IconDownloadQueue() override;
+
+    static const int MaxConcurrentDownloads;
+
+    void setDatabase(const QSharedPointer<Database>& database);
+    void addEntry(Entry* entry);
+    void clear();
+    void start();
+
+    QStringList domains() const;
+    int count() const;
+    int finishedCount() const;
+    bool isActive() const;
+
+public slots:
+    void abort();
+
+signals:
+    void domainFinished(const QString& domain, IconDownloadQueue::Result result);
+    void finished();
+
+private slots:
+    void downloadFinished(const QString& url, const QImage& icon);
+
+private:
+    struct Job
+    {
+        QString url;
+        QList<QPointer<Entry>> entries;
+    };
+
+    void startDownloads();
+    void finishDomain(const QString& domain, Result result);
+    Result applyIcon(const Job& job, const QImage& icon);
+
+    QSharedPointer<Database> m_db;
+    QMap<QString, Job> m_jobs;
+    QStringList m_pending;
+    QHash<IconDownloader*, QString> m_active;
+    int m_finished;
+
+    Q_DISABLE_COPY(IconDownloadQueue)
+};
+
+#endif // KEEPASSXC_ICONDOWNLOADQUEUE_H
@@ -21,14 +21,59 @@
 #include "networking/NetworkManager.h"
 
 #include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
 #include <QHostInfo>
 #include <QImageReader>
 #include <QNetworkReply>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 #define MAX_REDIRECTS 5
 
+namespace
+{
+    const quint32 CacheMagic = 0x4b504649; // "KPFI"
+    const quint32 CacheVersion = 2;
+    // Used if the server does not specify a lifetime, and as upper bound
+    const qint64 DefaultCacheLifetime = 7 * 24 * 3600;
+    const qint64 MaxCacheLifetime = 30 * 24 * 3600;
+
+    QString cacheDirectory()
+    {
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/favicons";
+    }
+
+    QByteArray urlHash(const QUrl& url)
+    {
+        return QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha256);
+    }
+
+    /**
+     * Expiry time of a fetched icon according to the Cache-Control header of the reply.
+     */
+    QDateTime cacheExpiry(const QNetworkReply* reply)
+    {
+        static const QRegularExpression maxAgeRegex(R"(max-age\s*=\s*(\d+))");
+
+        qint64 lifetime = DefaultCacheLifetime;
+        const auto cacheControl = QString::fromLatin1(reply->rawHeader("Cache-Control")).toLower();
+        const auto match = maxAgeRegex.match(cacheControl);
+        if (cacheControl.contains("no-cache") || cacheControl.contains("no-store")) {
+            lifetime = 0;
+        } else if (match.hasMatch()) {
+            lifetime = match.captured(1).toLongLong();
+        }
+        return QDateTime::currentDateTimeUtc().addSecs(qMin(lifetime, MaxCacheLifetime));
+    }
+} // namespace
+
 IconDownloader::IconDownloader(QObject* parent)
     : QObject(parent)
+    , m_hasCached(false)
     , m_reply(nullptr)
     , m_redirects(0)
 {
@@ -44,6 +89,8 @@ IconDownloader::~IconDownloader()
 void IconDownloader::setUrl(const QString& entryUrl)
 {
     m_url = entryUrl;
+    m_domain.clear();
+    m_hasCached = false;
     QUrl url = QUrl::fromUserInput(m_url);
     if (!url.isValid() || url.host().isEmpty()) {
         return;
@@ -124,15 +171,42 @@ void IconDownloader::setUrl(const QString& entryUrl)
             m_urlsToTry.append(favicon_url);
         }
     }
+
+    m_domain = domainKey(url.toString());
 }
 
-void IconDownloader::download()
+/**
+ * Start downloading the favicon. If the disk cache is enabled, a still valid
+ * icon from it is reported without any network request, a stale one is
+ * revalidated with its ETag before the regular list of URLs is tried.
+ *
+ * @return true if finished() will be emitted
+ */
+bool IconDownloader::download()
 {
     if (m_urlsToTry.isEmpty()) {
-        return;
+        return false;
     }
 
     if (!m_timeout.isActive()) {
+        m_hasCached = readCache(m_cached);
+        if (m_hasCached && m_cached.expiry > QDateTime::currentDateTimeUtc()) {
+            auto image = parseImage(m_cached.bytes);
+            if (!image.isNull()) {
+                // Report like a finished download, callers do not expect the signal from within download()
+                QTimer::singleShot(0, this, [this, image] { emit finished(m_url, image); });
+                return true;
+            }
+        }
+        if (m_hasCached && !m_cached.etag.isEmpty()) {
+            for (int i = 0; i < m_urlsToTry.size(); ++i) {
+                if (urlHash(m_urlsToTry.at(i)) == m_cached.sourceHash) {
+                    m_urlsToTry.move(i, 0);
+                    break;
+                }
+            }
+        }
+
         int timeout = config()->get(Config::FaviconDownloadTimeout).toInt();
         m_timeout.start(timeout * 1000);
 
@@ -140,6 +214,44 @@ void IconDownloader::download()
         // If a favicon is not found, the next URL will be tried
         fetchFavicon(m_urlsToTry.takeFirst());
     }
+    return true;
+}
+
+/**
+ * Key used to share downloads and cached icons between entries: the
+ * registrable domain (or IP address) of the URL including a non-default port.
+ *
+ * @param entryUrl entry URL
+ * @return domain key, empty if the URL has no host
+ */
+QString IconDownloader::domainKey(const QString& entryUrl)
+{
+    const auto url = QUrl::fromUserInput(entryUrl);
+    if (!url.isValid() || url.host().isEmpty()) {
+        return {};
+    }
+
+    auto domain = urlTools()->getBaseDomainFromUrl(url.toString()).toLower();
+    if (url.port() != -1) {
+        domain.append(QString(":%1").arg(url.port()));
+    }
+    return domain;
+}
+
+/**
+ * Location of the cached icon of the given domain. File names are hashed
+ * so the cache directory does not list the domains in the database, and
+ * the cached icons only hold a hash of the URL they were fetched from.
+ */
+QString IconDownloader::cachePath(const QString& domain)
+{
+    const auto hash = QCryptographicHash::hash(domain.toUtf8(), QCryptographicHash::Sha256).toHex();
+    return QStringLiteral("%1/%2.bin").arg(cacheDirectory(), QString::fromLatin1(hash));
+}
+
+void IconDownloader::clearCache()
+{
+    QDir(cacheDirectory()).removeRecursively();
 }
 
 void IconDownloader::abortDownload()
@@ -155,6 +267,9 @@ void IconDownloader::fetchFavicon(const QUrl& url)
     m_fetchUrl = url;
 
     QNetworkRequest request(url);
+    if (m_hasCached && !m_cached.etag.isEmpty() && urlHash(url) == m_cached.sourceHash) {
+        request.setRawHeader("If-None-Match", m_cached.etag);
+    }
     m_reply = getNetMgr()->get(request);
 
     connect(m_reply, &QNetworkReply::finished, this, &IconDownloader::fetchFinished);
@@ -173,6 +288,8 @@ void IconDownloader::fetchFinished()
 
     bool error = (m_reply->error() != QNetworkReply::NoError);
     QUrl redirectTarget = urlTools()->getRedirectTarget(m_reply);
+    bool notModified = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+    CachedIcon fetched{urlHash(m_fetchUrl), m_reply->rawHeader("ETag"), cacheExpiry(m_reply), m_bytesReceived};
 
     m_reply->deleteLater();
     m_reply = nullptr;
@@ -188,6 +305,13 @@ void IconDownloader::fetchFinished()
                 }
                 m_urlsToTry.prepend(redirectTarget);
             }
+        } else if (notModified && m_hasCached && fetched.sourceHash == m_cached.sourceHash) {
+            // The cached icon is still current
+            fetched.bytes = m_cached.bytes;
+            if (fetched.etag.isEmpty()) {
+                fetched.etag = m_cached.etag;
+            }
+            image = parseImage(fetched.bytes);
         } else {
             // No redirect, and we theoretically have some icon data now.
             image = parseImage(m_bytesReceived);
@@ -197,6 +321,7 @@ void IconDownloader::fetchFinished()
     if (!image.isNull()) {
         // Valid icon received
         m_timeout.stop();
+        writeCache(fetched);
         emit finished(url, image);
     } else if (!m_urlsToTry.empty()) {
         // Try the next url
@@ -238,3 +363,46 @@ QImage IconDownloader::parseImage(QByteArray& imageBytes) const
 
     return img;
 }
+
+bool IconDownloader::readCache(CachedIcon& cached) const
+{
+    if (m_domain.isEmpty() || !config()->get(Config::FaviconDiskCache).toBool()) {
+        return false;
+    }
+
+    QFile file(cachePath(m_domain));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion) {
+        // Older versions kept the source URL in plain text
+        file.remove();
+        return false;
+    }
+    stream >> cached.sourceHash >> cached.etag >> cached.expiry >> cached.bytes;
+    return stream.status() == QDataStream::Ok && !cached.bytes.isEmpty();
+}
+
+void IconDownloader::writeCache(const CachedIcon& cached) const
+{
+    if (m_domain.isEmpty() || !config()->get(Config::FaviconDiskCache).toBool()) {
+        return;
+    }
+
+    const auto path = cachePath(m_domain);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        QDataStream stream(&file);
+        stream << CacheMagic << CacheVersion << cached.sourceHash << cached.etag << cached.expiry << cached.bytes;
+        file.commit();
+    }
+}
@@ -18,6 +18,7 @@
 #ifndef KEEPASSXC_ICONDOWNLOADER_H
 #define KEEPASSXC_ICONDOWNLOADER_H
 
+#include <QDateTime>
 #include <QImage>
 #include <QTimer>
 #include <QUrl>
@@ -33,7 +34,11 @@ public:
     ~IconDownloader() override;
 
     void setUrl(const QString& entryUrl);
-    void download();
+    bool download();
+
+    static QString domainKey(const QString& entryUrl);
+    static QString cachePath(const QString& domain);
+    static void clearCache();
 
 signals:
     void finished(const QString& entryUrl, const QImage& image);
@@ -46,10 +51,24 @@ private slots:
     void fetchReadyRead();
 
 private:
+    // On-disk cache record of the icon last fetched for a domain, the source URL is only kept as hash
+    struct CachedIcon
+    {
+        QByteArray sourceHash;
+        QByteArray etag;
+        QDateTime expiry;
+        QByteArray bytes;
+    };
+
     void fetchFavicon(const QUrl& url);
     QImage parseImage(QByteArray& imageBytes) const;
+    bool readCache(CachedIcon& cached) const;
+    void writeCache(const CachedIcon& cached) const;
 
     QString m_url;
+    QString m_domain;
+    CachedIcon m_cached;
+    bool m_hasCached;
     QUrl m_fetchUrl;
     QList<QUrl> m_urlsToTry;
     QByteArray m_bytesReceived;
@@ -19,13 +19,8 @@
 #include "ui_IconDownloaderDialog.h"
 
 #include "core/Config.h"
-#include "core/Database.h"
 #include "core/Entry.h"
-#include "core/Metadata.h"
 #include "core/Tools.h"
-#include "gui/IconDownloader.h"
-#include "gui/IconModels.h"
-#include "gui/Icons.h"
 #include "osutils/OSUtils.h"
 #ifdef Q_OS_MACOS
 #include "gui/osutils/macutils/MacUtils.h"
@@ -37,6 +32,7 @@ IconDownloaderDialog::IconDownloaderDialog(QWidget* parent)
     : QDialog(parent)
     , m_ui(new Ui::IconDownloaderDialog())
     , m_dataModel(new QStandardItemModel(this))
+    , m_queue(new IconDownloadQueue(this))
 {
     setWindowFlags(Qt::Window);
     setAttribute(Qt::WA_DeleteOnClose);
@@ -45,11 +41,12 @@ IconDownloaderDialog::IconDownloaderDialog(QWidget* parent)
     showFallbackMessage(false);
 
     m_dataModel->clear();
-    m_dataModel->setHorizontalHeaderLabels({tr("URL"), tr("Status")});
+    m_dataModel->setHorizontalHeaderLabels({tr("Domain"), tr("Status")});
 
     m_ui->tableView->setModel(m_dataModel);
     m_ui->tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
 
+    connect(m_queue, &IconDownloadQueue::domainFinished, this, &IconDownloaderDialog::downloadFinished);
     connect(m_ui->cancelButton, SIGNAL(clicked()), SLOT(abortDownloads()));
     connect(m_ui->closeButton, SIGNAL(clicked()), SLOT(close()));
 }
@@ -63,18 +60,16 @@ void IconDownloaderDialog::downloadFavicons(const QSharedPointer<Database>& data
                                             const QList<Entry*>& entries,
                                             bool force)
 {
-    m_db = database;
-    m_urlToEntries.clear();
-    abortDownloads();
+    m_queue->clear();
+    m_queue->setDatabase(database);
     for (const auto& e : entries) {
         // Only consider entries with a valid URL and without a custom icon
-        auto webUrl = e->webUrl();
-        if (!webUrl.isEmpty() && (force || e->iconUuid().isNull())) {
-            m_urlToEntries.insert(webUrl, e);
+        if (force || e->iconUuid().isNull()) {
+            m_queue->addEntry(e);
         }
     }
 
-    if (m_urlToEntries.count() > 0) {
+    if (m_queue->count() > 0) {
 #ifdef Q_OS_MACOS
         macUtils()->raiseOwnWindow();
         Tools::wait(100);
@@ -84,10 +79,9 @@ void IconDownloaderDialog::downloadFavicons(const QSharedPointer<Database>& data
         open();
         QApplication::processEvents();
 
-        for (const auto& url : m_urlToEntries.uniqueKeys()) {
+        for (const auto& domain : m_queue->domains()) {
             m_dataModel->appendRow(QList<QStandardItem*>()
-                                   << new QStandardItem(url) << new QStandardItem(tr("Downloading…")));
-            m_activeDownloaders.append(createDownloader(url));
+                                   << new QStandardItem(domain) << new QStandardItem(tr("Downloading…")));
         }
 
         // Setup the dialog
@@ -96,82 +90,35 @@ void IconDownloaderDialog::downloadFavicons(const QSharedPointer<Database>& data
         QApplication::processEvents();
 
         // Start the downloads
-        for (auto downloader : m_activeDownloaders) {
-            downloader->download();
-        }
+        m_queue->start();
+        updateCancelButton();
     }
 }
 
 void IconDownloaderDialog::downloadFaviconInBackground(const QSharedPointer<Database>& database, Entry* entry)
 {
-    m_db = database;
-    m_urlToEntries.clear();
-    abortDownloads();
-
-    auto webUrl = entry->webUrl();
-    if (!webUrl.isEmpty()) {
-        m_urlToEntries.insert(webUrl, entry);
-    }
-
-    if (m_urlToEntries.count() > 0) {
-        m_activeDownloaders.append(createDownloader(webUrl));
-        m_activeDownloaders.first()->download();
-    }
+    m_queue->clear();
+    m_queue->setDatabase(database);
+    m_queue->addEntry(entry);
+    m_queue->start();
 }
 
-IconDownloader* IconDownloaderDialog::createDownloader(const QString& url)
+void IconDownloaderDialog::downloadFinished(const QString& domain, IconDownloadQueue::Result result)
 {
-    auto downloader = new IconDownloader();
-    connect(downloader,
-            SIGNAL(finished(const QString&, const QImage&)),
-            this,
-            SLOT(downloadFinished(const QString&, const QImage&)));
-
-    downloader->setUrl(url);
-    return downloader;
-}
-
-void IconDownloaderDialog::downloadFinished(const QString& url, const QImage& icon)
-{
-    // Prevent re-entrance from multiple calls finishing at the same time
-    QMutexLocker locker(&m_mutex);
-
-    // Cleanup the icon downloader that sent this signal
-    auto downloader = qobject_cast<IconDownloader*>(sender());
-    if (downloader) {
-        downloader->deleteLater();
-        m_activeDownloaders.removeAll(downloader);
-    }
-
     updateProgressBar();
     updateCancelButton();
 
-    if (m_db && !icon.isNull()) {
-        // Don't add an icon larger than 128x128, but retain original size if smaller
-        constexpr auto maxIconSize = 128;
-        auto scaledIcon = icon;
-        if (icon.width() > maxIconSize || icon.height() > maxIconSize) {
-            scaledIcon = icon.scaled(maxIconSize, maxIconSize);
-        }
-
-        QByteArray serializedIcon = Icons::saveToBytes(scaledIcon);
-        QUuid uuid = m_db->metadata()->findCustomIcon(serializedIcon);
-        if (uuid.isNull()) {
-            uuid = QUuid::createUuid();
-            m_db->metadata()->addCustomIcon(uuid, serializedIcon);
-            updateTable(url, tr("Ok"));
-        } else {
-            updateTable(url, tr("Already Exists"));
-        }
-
-        // Set the icon on all the entries associated with this url
-        for (const auto entry : m_urlToEntries.values(url)) {
-            entry->setIcon(uuid);
-        }
-    } else {
+    switch (result) {
+    case IconDownloadQueue::Added:
+        updateTable(domain, tr("Ok"));
+        break;
+    case IconDownloadQueue::AlreadyExists:
+        updateTable(domain, tr("Already Exists"));
+        break;
+    case IconDownloadQueue::Failed:
         showFallbackMessage(true);
-        updateTable(url, tr("Download Failed"));
-        return;
+        updateTable(domain, tr("Download Failed"));
+        break;
     }
 }
 
@@ -184,8 +131,8 @@ void IconDownloaderDialog::showFallbackMessage(bool state)
 
 void IconDownloaderDialog::updateProgressBar()
 {
-    int total = m_urlToEntries.uniqueKeys().count();
-    int value = total - m_activeDownloaders.count();
+    int total = m_queue->count();
+    int value = m_queue->finishedCount();
     m_ui->progressBar->setValue(value);
     m_ui->progressBar->setMaximum(total);
     m_ui->progressLabel->setText(
@@ -194,24 +141,22 @@ void IconDownloaderDialog::updateProgressBar()
 
 void IconDownloaderDialog::updateCancelButton()
 {
-    m_ui->cancelButton->setEnabled(!m_activeDownloaders.isEmpty());
+    m_ui->cancelButton->setEnabled(m_queue->isActive());
 }
 
-void IconDownloaderDialog::updateTable(const QString& url, const QString& message)
+void IconDownloaderDialog::updateTable(const QString& domain, const QString& message)
 {
     for (int i = 0; i < m_dataModel->rowCount(); ++i) {
-        if (m_dataModel->item(i, 0)->text() == url) {
+        if (m_dataModel->item(i, 0)->text() == domain) {
             m_dataModel->item(i, 1)->setText(message);
+            break;
         }
     }
 }
 
 void IconDownloaderDialog::abortDownloads()
 {
-    for (auto* downloader : m_activeDownloaders) {
-        downloader->deleteLater();
-    }
-    m_activeDownloaders.clear();
+    m_queue->abort();
     updateProgressBar();
     updateCancelButton();
 }
@@ -19,13 +19,11 @@
 #define KEEPASSX_ICONDOWNLOADERDIALOG_H
 
 #include <QDialog>
-#include <QMap>
-#include <QMutex>
+
+#include "gui/IconDownloadQueue.h"
 
 class Database;
 class Entry;
-class CustomIconModel;
-class IconDownloader;
 class QStandardItemModel;
 
 namespace Ui
@@ -45,23 +43,18 @@ public:
     void downloadFaviconInBackground(const QSharedPointer<Database>& database, Entry* entry);
 
 private slots:
-    void downloadFinished(const QString& url, const QImage& icon);
+    void downloadFinished(const QString& domain, IconDownloadQueue::Result result);
     void abortDownloads();
 
 private:
-    IconDownloader* createDownloader(const QString& url);
-
     void showFallbackMessage(bool state);
-    void updateTable(const QString& url, const QString& message);
+    void updateTable(const QString& domain, const QString& message);
     void updateProgressBar();
     void updateCancelButton();
 
     QScopedPointer<Ui::IconDownloaderDialog> m_ui;
     QStandardItemModel* m_dataModel;
-    QSharedPointer<Database> m_db;
-    QMultiMap<QString, Entry*> m_urlToEntries;
-    QList<IconDownloader*> m_activeDownloaders;
-    QMutex m_mutex;
+    IconDownloadQueue* m_queue;
 
     Q_DISABLE_COPY(IconDownloaderDialog)
 };
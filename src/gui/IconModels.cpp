@@ -61,11 +61,24 @@ void CustomIconModel::setIcons(const QHash<QUuid, QPixmap>& icons, const QList<Q
 
     m_icons = icons;
     m_iconsOrder = iconsOrder;
+    m_useCounts.clear();
     Q_ASSERT(m_icons.count() == m_iconsOrder.count());
 
     endResetModel();
 }
 
+/**
+ * Show how many entries and groups use each icon. Icons without a
+ * known use count do not get a tooltip.
+ */
+void CustomIconModel::setUseCounts(const QHash<QUuid, int>& useCounts)
+{
+    m_useCounts = useCounts;
+    if (!m_iconsOrder.isEmpty()) {
+        emit dataChanged(index(0, 0), index(m_iconsOrder.size() - 1, 0), {Qt::ToolTipRole});
+    }
+}
+
 int CustomIconModel::rowCount(const QModelIndex& parent) const
 {
     if (!parent.isValid()) {
@@ -84,6 +97,11 @@ QVariant CustomIconModel::data(const QModelIndex& index, int role) const
     if (role == Qt::DecorationRole) {
         QUuid uuid = uuidFromIndex(index);
         return m_icons.value(uuid);
+    } else if (role == Qt::ToolTipRole) {
+        auto useCount = m_useCounts.constFind(uuidFromIndex(index));
+        if (useCount != m_useCounts.constEnd()) {
+            return tr("Used by %n entry(s) or group(s)", "", useCount.value());
+        }
     }
 
     return {};
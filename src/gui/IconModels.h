@@ -42,12 +42,14 @@ public:
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     void setIcons(const QHash<QUuid, QPixmap>& icons, const QList<QUuid>& iconsOrder);
+    void setUseCounts(const QHash<QUuid, int>& useCounts);
     QUuid uuidFromIndex(const QModelIndex& index) const;
     QModelIndex indexFromUuid(const QUuid& uuid) const;
 
 private:
     QHash<QUuid, QPixmap> m_icons;
     QList<QUuid> m_iconsOrder;
+    QHash<QUuid, int> m_useCounts;
 };
 
 #endif // KEEPASSX_ICONMODELS_H
@@ -23,6 +23,7 @@
 #include <QImageReader>
 #include <QPaintDevice>
 #include <QPainter>
+#include <QPixmapCache>
 
 #include "config-keepassx.h"
 #include "core/Config.h"
@@ -38,13 +39,17 @@
 class AdaptiveIconEngine : public QIconEngine
 {
 public:
-    explicit AdaptiveIconEngine(QIcon baseIcon, QColor overrideColor = {});
+    explicit AdaptiveIconEngine(QIcon baseIcon, QString name, QColor overrideColor = {});
     void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state) override;
     QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) override;
     QIconEngine* clone() const override;
 
 private:
+    QColor color(QIcon::Mode mode) const;
+    QPixmap renderPixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) const;
+
     QIcon m_baseIcon;
+    QString m_name;
     QColor m_overrideColor;
 };
 
@@ -109,56 +114,90 @@ QIcon Icons::trayIcon(bool unlocked)
     return i;
 }
 
-AdaptiveIconEngine::AdaptiveIconEngine(QIcon baseIcon, QColor overrideColor)
+AdaptiveIconEngine::AdaptiveIconEngine(QIcon baseIcon, QString name, QColor overrideColor)
     : QIconEngine()
     , m_baseIcon(std::move(baseIcon))
+    , m_name(std::move(name))
     , m_overrideColor(overrideColor)
 {
 }
 
 void AdaptiveIconEngine::paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state)
 {
-    // Temporary image canvas to ensure that the background is transparent and alpha blending works.
     auto scale = painter->device()->devicePixelRatioF();
-    QImage img(rect.size() * scale, QImage::Format_ARGB32_Premultiplied);
-    img.fill(0);
-    QPainter p(&img);
+    painter->drawPixmap(rect, renderPixmap(rect.size() * scale, mode, state));
+}
 
-    m_baseIcon.paint(&p, img.rect(), Qt::AlignCenter, mode, state);
+QPixmap AdaptiveIconEngine::pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state)
+{
+    return renderPixmap(size, mode, state);
+}
 
+QIconEngine* AdaptiveIconEngine::clone() const
+{
+    return new AdaptiveIconEngine(m_baseIcon, m_name, m_overrideColor);
+}
+
+QColor AdaptiveIconEngine::color(QIcon::Mode mode) const
+{
     if (m_overrideColor.isValid()) {
-        p.setCompositionMode(QPainter::CompositionMode_SourceIn);
-        p.fillRect(img.rect(), m_overrideColor);
-    } else if (getMainWindow()) {
-        QPalette palette = getMainWindow()->palette();
-        p.setCompositionMode(QPainter::CompositionMode_SourceIn);
-
-        if (mode == QIcon::Active) {
-            p.fillRect(img.rect(), palette.color(QPalette::Active, QPalette::ButtonText));
-        } else if (mode == QIcon::Selected) {
-            p.fillRect(img.rect(), palette.color(QPalette::Active, QPalette::HighlightedText));
-        } else if (mode == QIcon::Disabled) {
-            p.fillRect(img.rect(), palette.color(QPalette::Disabled, QPalette::WindowText));
-        } else {
-            p.fillRect(img.rect(), palette.color(QPalette::Normal, QPalette::WindowText));
-        }
+        return m_overrideColor;
     }
 
-    painter->drawImage(rect, img);
+    auto mainWindow = getMainWindow();
+    if (!mainWindow) {
+        return {};
+    }
+
+    QPalette palette = mainWindow->palette();
+    switch (mode) {
+    case QIcon::Active:
+        return palette.color(QPalette::Active, QPalette::ButtonText);
+    case QIcon::Selected:
+        return palette.color(QPalette::Active, QPalette::HighlightedText);
+    case QIcon::Disabled:
+        return palette.color(QPalette::Disabled, QPalette::WindowText);
+    default:
+        return palette.color(QPalette::Normal, QPalette::WindowText);
+    }
 }
 
-QPixmap AdaptiveIconEngine::pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state)
+/**
+ * Render the recolored icon in device pixels. The result is kept in the global
+ * pixmap cache, keyed by everything it depends on including the effective color,
+ * so a palette change never hits a stale pixmap. Theme changes clear the cache.
+ */
+QPixmap AdaptiveIconEngine::renderPixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) const
 {
+    const auto color = this->color(mode);
+    const auto key = QString("kpxc-icon:%1:%2x%3:%4:%5:%6")
+                         .arg(m_name)
+                         .arg(size.width())
+                         .arg(size.height())
+                         .arg(mode)
+                         .arg(state)
+                         .arg(color.isValid() ? color.name(QColor::HexArgb) : QString("-"));
+
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap)) {
+        return pixmap;
+    }
+
+    // Temporary image canvas to ensure that the background is transparent and alpha blending works.
     QImage img(size, QImage::Format_ARGB32_Premultiplied);
     img.fill(0);
-    QPainter painter(&img);
-    paint(&painter, QRect(0, 0, size.width(), size.height()), mode, state);
-    return QPixmap::fromImage(img, Qt::ImageConversionFlag::NoFormatConversion);
-}
+    {
+        QPainter p(&img);
+        m_baseIcon.paint(&p, img.rect(), Qt::AlignCenter, mode, state);
+        if (color.isValid()) {
+            p.setCompositionMode(QPainter::CompositionMode_SourceIn);
+            p.fillRect(img.rect(), color);
+        }
+    }
 
-QIconEngine* AdaptiveIconEngine::clone() const
-{
-    return new AdaptiveIconEngine(m_baseIcon);
+    pixmap = QPixmap::fromImage(img, Qt::ImageConversionFlag::NoFormatConversion);
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
 }
 
 QIcon Icons::icon(const QString& name, bool recolor, const QColor& overrideColor)
@@ -171,20 +210,23 @@ QIcon Icons::icon(const QString& name, bool recolor, const QColor& overrideColor
     //
     // See issue #4963: https://github.com/keepassxreboot/keepassxc/issues/4963
     // and qt5ct issue #80: https://sourceforge.net/p/qt5ct/tickets/80/
-    QIcon::setThemeName("application");
+    // Setting the theme name invalidates all themed icons, so only do it when it has changed.
+    if (QIcon::themeName() != "application") {
+        QIcon::setThemeName("application");
+    }
 #endif
 
-    QString cacheName =
-        QString("%1:%2:%3").arg(recolor ? "1" : "0", overrideColor.isValid() ? overrideColor.name() : "#", name);
+    QString cacheName = QString("%1:%2:%3").arg(
+        recolor ? "1" : "0", overrideColor.isValid() ? overrideColor.name(QColor::HexArgb) : "#", name);
     QIcon icon = m_iconCache.value(cacheName);
 
-    if (!icon.isNull() && !overrideColor.isValid()) {
+    if (!icon.isNull()) {
         return icon;
     }
 
     icon = QIcon::fromTheme(name);
     if (recolor) {
-        icon = QIcon(new AdaptiveIconEngine(icon, overrideColor));
+        icon = QIcon(new AdaptiveIconEngine(icon, name, overrideColor));
         icon.setIsMask(true);
     }
 
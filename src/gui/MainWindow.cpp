@@ -29,6 +29,7 @@
 #include <QStatusBar>
 #include <QTimer>
 #include <QToolButton>
+#include <QTreeView>
 #include <QWindow>
 
 #include "config-keepassx.h"
@@ -45,6 +46,7 @@
 #include "gui/SearchWidget.h"
 #include "gui/ShortcutSettingsPage.h"
 #include "gui/entry/EntryView.h"
+#include "gui/entry/SearchResultsModel.h"
 #include "gui/osutils/OSUtils.h"
 #include "gui/remote/RemoteSettings.h"
 
@@ -123,6 +125,42 @@ MainWindow::MainWindow()
         m_ui->toolBar->setVisible(!config()->get(Config::GUI_HideToolbar).toBool());
     });
 
+    // Results of a search across all open databases replace the database tabs while it is active
+    m_searchResultsView = new QTreeView(m_ui->pageDatabase);
+    m_searchResultsView->setObjectName("searchResultsView");
+    m_searchResultsView->setModel(new SearchResultsModel(m_ui->tabWidget->databaseSearcher(), m_searchResultsView));
+    m_searchResultsView->setRootIsDecorated(false);
+    m_searchResultsView->setUniformRowHeights(true);
+    m_searchResultsView->setAlternatingRowColors(true);
+    m_searchResultsView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_searchResultsView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_searchResultsView->hide();
+    m_ui->pageDatabase->layout()->addWidget(m_searchResultsView);
+
+    connect(m_searchWidget, &SearchWidget::searchAllDatabases, this, [this](const QString& text) {
+        m_ui->tabWidget->searchAllDatabases(text);
+        setSearchResultsVisible(!text.isEmpty());
+    });
+    connect(m_searchWidget, &SearchWidget::searchCanceled, this, [this] {
+        m_ui->tabWidget->endSearchAllDatabases();
+        setSearchResultsVisible(false);
+    });
+    connect(m_searchWidget,
+            &SearchWidget::caseSensitiveChanged,
+            m_ui->tabWidget,
+            &DatabaseTabWidget::setSearchAllDatabasesCaseSensitive);
+    connect(m_searchWidget, &SearchWidget::downPressed, this, [this] {
+        if (m_searchResultsView->isVisible()) {
+            m_searchResultsView->setFocus();
+        }
+    });
+    connect(m_searchResultsView, &QTreeView::activated, this, [this](const QModelIndex& index) {
+        auto model = qobject_cast<SearchResultsModel*>(m_searchResultsView->model());
+        QPointer<Entry> entry = model->entryFromIndex(index);
+        m_searchWidget->clearSearch();
+        m_ui->tabWidget->selectEntry(entry);
+    });
+
     m_countDefaultAttributes = m_ui->menuEntryCopyAttribute->actions().size();
 
     m_entryContextMenu = new QMenu(this);
@@ -1009,6 +1047,12 @@ void MainWindow::updateMenuActionState()
     m_searchWidgetAction->setEnabled(inDatabase);
 }
 
+void MainWindow::setSearchResultsVisible(bool visible)
+{
+    m_searchResultsView->setVisible(visible);
+    m_ui->tabWidget->setVisible(!visible);
+}
+
 void MainWindow::updateToolbarSeparatorVisibility()
 {
     if (!m_showToolbarSeparator) {
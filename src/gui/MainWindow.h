@@ -36,6 +36,7 @@ namespace Ui
 }
 
 class InactivityTimer;
+class QTreeView;
 class SearchWidget;
 class MainWindowEventFilter;
 
@@ -170,6 +171,7 @@ private:
 
     void initViewMenu();
     void initActionCollection();
+    void setSearchResultsVisible(bool visible);
 
     const QScopedPointer<Ui::MainWindow> m_ui;
     SignalMultiplexer m_actionMultiplexer;
@@ -186,6 +188,7 @@ private:
     QPointer<QSystemTrayIcon> m_trayIcon;
     QPointer<ScreenLockListener> m_screenLockListener;
     QPointer<SearchWidget> m_searchWidget;
+    QPointer<QTreeView> m_searchResultsView;
     QPointer<QProgressBar> m_progressBar;
     QPointer<QLabel> m_progressBarLabel;
     QPointer<QLabel> m_statusBarLabel;
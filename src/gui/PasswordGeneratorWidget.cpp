@@ -26,6 +26,7 @@
 
 #include "core/Config.h"
 #include "core/PasswordHealth.h"
+#include "core/PasswordStrengthEstimator.h"
 #include "core/Resources.h"
 #include "gui/Clipboard.h"
 #include "gui/FileDialog.h"
@@ -38,6 +39,7 @@ PasswordGeneratorWidget::PasswordGeneratorWidget(QWidget* parent)
     , m_passwordGenerator(new PasswordGenerator())
     , m_dicewareGenerator(new PassphraseGenerator())
     , m_ui(new Ui::PasswordGeneratorWidget())
+    , m_strengthEstimator(new PasswordStrengthEstimator(this))
 {
     m_ui->setupUi(this);
 
@@ -57,6 +59,7 @@ PasswordGeneratorWidget::PasswordGeneratorWidget(QWidget* parent)
 
     connect(m_ui->editNewPassword, SIGNAL(textChanged(QString)), SLOT(updateButtonsEnabled(QString)));
     connect(m_ui->editNewPassword, SIGNAL(textChanged(QString)), SLOT(updatePasswordStrength()));
+    connect(m_strengthEstimator, SIGNAL(estimated(double)), SLOT(showPasswordStrength(double)));
     connect(m_ui->editNewPassword, SIGNAL(textChanged(QString)), SLOT(updatePasswordLengthLabel(QString)));
     connect(m_ui->buttonAdvancedMode, SIGNAL(toggled(bool)), SLOT(setAdvancedMode(bool)));
     connect(m_ui->buttonAddHex, SIGNAL(clicked()), SLOT(excludeHexChars()));
@@ -273,13 +276,18 @@ void PasswordGeneratorWidget::updateButtonsEnabled(const QString& password)
 
 void PasswordGeneratorWidget::updatePasswordStrength()
 {
-    // Calculate the password / passphrase health
-    PasswordHealth passwordHealth(0);
+    // The passphrase entropy is known from the generator, passwords are estimated in the background
     if (m_ui->tabWidget->currentIndex() == Diceware) {
-        passwordHealth.init(m_dicewareGenerator->estimateEntropy());
+        m_strengthEstimator->cancel();
+        showPasswordStrength(m_dicewareGenerator->estimateEntropy());
     } else {
-        passwordHealth = PasswordHealth(m_ui->editNewPassword->text());
+        m_strengthEstimator->estimate(m_ui->editNewPassword->text());
     }
+}
+
+void PasswordGeneratorWidget::showPasswordStrength(double entropy)
+{
+    PasswordHealth passwordHealth(entropy);
 
     // Update the entropy text labels
     m_ui->entropyLabel->setText(tr("Entropy: %1 bit").arg(QString::number(passwordHealth.entropy(), 'f', 2)));
@@ -32,6 +32,7 @@ namespace Ui
 
 class PasswordGenerator;
 class PasswordHealth;
+class PasswordStrengthEstimator;
 class PassphraseGenerator;
 
 class PasswordGeneratorWidget : public QWidget
@@ -76,6 +77,7 @@ protected:
 private slots:
     void updateButtonsEnabled(const QString& password);
     void updatePasswordStrength();
+    void showPasswordStrength(double entropy);
     void updatePasswordLengthLabel(const QString& password);
     void setAdvancedMode(bool advanced);
     void excludeHexChars();
@@ -96,6 +98,7 @@ private:
     const QScopedPointer<PasswordGenerator> m_passwordGenerator;
     const QScopedPointer<PassphraseGenerator> m_dicewareGenerator;
     const QScopedPointer<Ui::PasswordGeneratorWidget> m_ui;
+    PasswordStrengthEstimator* const m_strengthEstimator;
 };
 
 #endif // KEEPASSX_PASSWORDGENERATORWIDGET_H
@@ -21,6 +21,7 @@
 
 #include "core/Config.h"
 #include "core/PasswordHealth.h"
+#include "core/PasswordStrengthEstimator.h"
 #include "gui/Font.h"
 #include "gui/Icons.h"
 #include "gui/PasswordGeneratorWidget.h"
@@ -91,6 +92,8 @@ PasswordWidget::PasswordWidget(QWidget* parent)
     m_capslockAction->setVisible(false);
 
     // Reset the password strength bar, hidden by default
+    m_strengthEstimator = new PasswordStrengthEstimator(this);
+    connect(m_strengthEstimator, &PasswordStrengthEstimator::estimated, this, &PasswordWidget::showPasswordStrength);
     updatePasswordStrength("");
     m_ui->qualityProgressBar->setVisible(false);
 
@@ -107,6 +110,7 @@ PasswordWidget::~PasswordWidget()
 void PasswordWidget::setQualityVisible(bool state)
 {
     m_ui->qualityProgressBar->setVisible(state);
+    updatePasswordStrength(text());
 }
 
 QString PasswordWidget::text()
@@ -265,12 +269,25 @@ void PasswordWidget::checkCapslockState()
 void PasswordWidget::updatePasswordStrength(const QString& password)
 {
     if (password.isEmpty()) {
+        m_strengthEstimator->cancel();
         m_ui->qualityProgressBar->setValue(0);
         m_ui->qualityProgressBar->setToolTip((tr("")));
         return;
     }
 
-    PasswordHealth health(password);
+    // Nothing to estimate while the strength bar is hidden
+    if (m_ui->qualityProgressBar->isHidden()) {
+        m_strengthEstimator->cancel();
+        return;
+    }
+
+    // Estimating long passwords is expensive, the strength bar is updated once the input settles
+    m_strengthEstimator->estimate(password);
+}
+
+void PasswordWidget::showPasswordStrength(double entropy)
+{
+    PasswordHealth health(entropy);
 
     m_ui->qualityProgressBar->setValue(std::min(int(health.entropy()), m_ui->qualityProgressBar->maximum()));
 
@@ -29,6 +29,8 @@ namespace Ui
     class PasswordWidget;
 }
 
+class PasswordStrengthEstimator;
+
 class PasswordWidget : public QWidget
 {
     Q_OBJECT
@@ -63,6 +65,7 @@ private slots:
     void popupPasswordGenerator();
     void updateRepeatStatus();
     void updatePasswordStrength(const QString& password);
+    void showPasswordStrength(double entropy);
 
 private:
     void checkCapslockState();
@@ -77,6 +80,7 @@ private:
     QPointer<QAction> m_capslockAction;
     QPointer<PasswordWidget> m_repeatPasswordWidget;
     QPointer<PasswordWidget> m_parentPasswordWidget;
+    QPointer<PasswordStrengthEstimator> m_strengthEstimator;
 
     bool m_capslockState = false;
 };
@@ -69,6 +69,13 @@ SearchWidget::SearchWidget(QWidget* parent)
     m_actionLimitGroup->setCheckable(true);
     m_actionLimitGroup->setChecked(config()->get(Config::SearchLimitGroup).toBool());
 
+    m_actionSearchAllDatabases =
+        m_searchMenu->addAction(tr("Search all open databases"), this, SLOT(updateSearchAllDatabases()));
+    m_actionSearchAllDatabases->setObjectName("actionSearchAllDatabases");
+    m_actionSearchAllDatabases->setCheckable(true);
+    m_actionSearchAllDatabases->setChecked(config()->get(Config::SearchAllDatabases).toBool());
+    m_actionLimitGroup->setEnabled(!m_actionSearchAllDatabases->isChecked());
+
     m_ui->searchIcon->setIcon(icons()->icon("system-search"));
     m_ui->searchEdit->addAction(m_ui->searchIcon, QLineEdit::LeadingPosition);
 
@@ -183,6 +190,13 @@ void SearchWidget::startSearch()
         m_searchTimer->stop();
     }
 
+    if (m_actionSearchAllDatabases->isChecked()) {
+        // Saved searches belong to a single database
+        m_ui->saveIcon->setVisible(false);
+        emit searchAllDatabases(m_ui->searchEdit->text());
+        return;
+    }
+
     m_ui->saveIcon->setVisible(true);
     search(m_ui->searchEdit->text());
 }
@@ -218,6 +232,35 @@ void SearchWidget::setLimitGroup(bool state)
     updateLimitGroup();
 }
 
+void SearchWidget::updateSearchAllDatabases()
+{
+    const bool state = m_actionSearchAllDatabases->isChecked();
+    config()->set(Config::SearchAllDatabases, state);
+    m_actionLimitGroup->setEnabled(!state);
+    emit searchAllDatabasesChanged(state);
+
+    // Move the current search between the active database and all databases
+    if (!m_ui->searchEdit->text().isEmpty()) {
+        if (state) {
+            search({});
+        } else {
+            emit searchAllDatabases({});
+        }
+        startSearch();
+    }
+}
+
+void SearchWidget::setSearchAllDatabases(bool state)
+{
+    m_actionSearchAllDatabases->setChecked(state);
+    updateSearchAllDatabases();
+}
+
+bool SearchWidget::isSearchAllDatabases() const
+{
+    return m_actionSearchAllDatabases->isChecked();
+}
+
 void SearchWidget::focusSearch()
 {
     m_ui->searchEdit->setFocus();
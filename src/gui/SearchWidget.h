@@ -46,6 +46,8 @@ public:
     void connectSignals(SignalMultiplexer& mx);
     void setCaseSensitive(bool state);
     void setLimitGroup(bool state);
+    void setSearchAllDatabases(bool state);
+    bool isSearchAllDatabases() const;
 
 protected:
     // Filter key presses in the search field
@@ -53,9 +55,11 @@ protected:
 
 signals:
     void search(const QString& text);
+    void searchAllDatabases(const QString& text);
     void searchCanceled();
     void caseSensitiveChanged(bool state);
     void limitGroupChanged(bool state);
+    void searchAllDatabasesChanged(bool state);
     void escapePressed();
     void downPressed();
     void enterPressed();
@@ -72,6 +76,7 @@ private slots:
     void startSearch();
     void updateCaseSensitive();
     void updateLimitGroup();
+    void updateSearchAllDatabases();
     void toggleHelp();
     void showSearchMenu();
     void resetSearchClearTimer();
@@ -83,6 +88,7 @@ private:
     QTimer* m_clearSearchTimer;
     QAction* m_actionCaseSensitive;
     QAction* m_actionLimitGroup;
+    QAction* m_actionSearchAllDatabases;
     QMenu* m_searchMenu;
 };
 
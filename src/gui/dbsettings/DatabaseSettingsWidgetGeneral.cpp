@@ -22,6 +22,7 @@
 #include <QDialogButtonBox>
 #include <QInputDialog>
 #include <QListView>
+#include <QRegularExpression>
 
 #include "core/Clock.h"
 #include "core/Group.h"
@@ -56,6 +57,7 @@ void DatabaseSettingsWidgetGeneral::initialize()
     m_ui->dbDescriptionEdit->setText(meta->description());
     m_ui->recycleBinEnabledCheckBox->setChecked(meta->recycleBinEnabled());
     m_ui->defaultUsernameEdit->setText(meta->defaultUserName());
+    m_ui->passwordDictionaryEdit->setText(meta->passwordDictionary().join(", "));
     m_ui->compressionCheckbox->setChecked(m_db->compressionAlgorithm() != Database::CompressionNone);
 
     m_ui->dbPublicName->setText(m_db->publicName());
@@ -129,6 +131,8 @@ bool DatabaseSettingsWidgetGeneral::saveSettings()
     meta->setName(m_ui->dbNameEdit->text());
     meta->setDescription(m_ui->dbDescriptionEdit->text());
     meta->setDefaultUserName(m_ui->defaultUsernameEdit->text());
+    meta->setPasswordDictionary(
+        m_ui->passwordDictionaryEdit->text().split(QRegularExpression("[,\\s]+"), Qt::SkipEmptyParts));
     meta->setRecycleBinEnabled(m_ui->recycleBinEnabledCheckBox->isChecked());
     meta->setSettingsChanged(Clock::currentDateTimeUtc());
 
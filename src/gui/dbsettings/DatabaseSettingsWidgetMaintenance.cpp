@@ -46,8 +46,16 @@ DatabaseSettingsWidgetMaintenance::~DatabaseSettingsWidgetMaintenance() = defaul
 
 void DatabaseSettingsWidgetMaintenance::populateIcons(QSharedPointer<Database> db)
 {
-    m_customIconModel->setIcons(Icons::customIconsPixmaps(db.data(), IconSize::Default),
-                                db->metadata()->customIconsOrder());
+    const auto metadata = db->metadata();
+    const auto iconsOrder = metadata->customIconsOrder();
+
+    QHash<QUuid, int> useCounts;
+    for (const auto& iconUuid : iconsOrder) {
+        useCounts.insert(iconUuid, metadata->customIconUseCount(iconUuid));
+    }
+
+    m_customIconModel->setIcons(Icons::customIconsPixmaps(db.data(), IconSize::Default), iconsOrder);
+    m_customIconModel->setUseCounts(useCounts);
     m_ui->deleteButton->setEnabled(false);
 }
 
@@ -79,44 +87,26 @@ void DatabaseSettingsWidgetMaintenance::removeCustomIcon()
 
     m_deletionDecision = MessageBox::NoButton;
 
+    QList<QUuid> removedIcons;
     QList<QModelIndex> indexes = m_ui->customIconsView->selectionModel()->selectedIndexes();
     for (auto index : indexes) {
-        removeSingleCustomIcon(database, index);
+        QUuid iconUuid = m_customIconModel->uuidFromIndex(index);
+        if (removeSingleCustomIcon(database, iconUuid)) {
+            removedIcons << iconUuid;
+        }
     }
 
+    // Remove the icons from the database
+    database->metadata()->removeCustomIcons(removedIcons);
+
     populateIcons(database);
 }
 
-void DatabaseSettingsWidgetMaintenance::removeSingleCustomIcon(QSharedPointer<Database> database, QModelIndex index)
+bool DatabaseSettingsWidgetMaintenance::removeSingleCustomIcon(QSharedPointer<Database> database, const QUuid& iconUuid)
 {
-    QUuid iconUuid = m_customIconModel->uuidFromIndex(index);
-
-    const QList<Entry*> allEntries = database->rootGroup()->entriesRecursive(true);
-    QList<Entry*> entriesWithSelectedIcon;
-    QList<Entry*> historicEntriesWithSelectedIcon;
-
-    for (Entry* entry : allEntries) {
-        if (iconUuid == entry->iconUuid()) {
-            // Check if this is a history entry (no assigned group)
-            if (!entry->group()) {
-                historicEntriesWithSelectedIcon << entry;
-            } else {
-                entriesWithSelectedIcon << entry;
-            }
-        }
-    }
+    const auto usage = database->metadata()->customIconUsage(iconUuid);
 
-    const QList<Group*> allGroups = database->rootGroup()->groupsRecursive(true);
-    QList<Group*> groupsWithSameIcon;
-
-    for (Group* group : allGroups) {
-        if (iconUuid == group->iconUuid()) {
-            groupsWithSameIcon << group;
-        }
-    }
-
-    int iconUseCount = entriesWithSelectedIcon.size() + groupsWithSameIcon.size();
-    if (iconUseCount > 0) {
+    if (!usage.entries.isEmpty() || !usage.groups.isEmpty()) {
         if (m_deletionDecision == MessageBox::NoButton) {
             m_deletionDecision = MessageBox::question(
                 this,
@@ -130,29 +120,32 @@ void DatabaseSettingsWidgetMaintenance::removeSingleCustomIcon(QSharedPointer<Da
 
         if (m_deletionDecision == MessageBox::Skip) {
             // Early out, nothing is changed
-            return;
+            return false;
         } else {
             // Revert matched entries to the default entry icon
-            for (Entry* entry : asConst(entriesWithSelectedIcon)) {
+            for (Entry* entry : usage.entries) {
                 entry->setIcon(Entry::DefaultIconNumber);
             }
 
             // Revert matched groups to the default group icon
-            for (Group* group : asConst(groupsWithSameIcon)) {
+            for (Group* group : usage.groups) {
                 group->setIcon(Group::DefaultIconNumber);
             }
         }
     }
 
     // Remove the icon from history entries
-    for (Entry* entry : asConst(historicEntriesWithSelectedIcon)) {
+    resetHistoryIcons(usage.historyItems);
+    return true;
+}
+
+void DatabaseSettingsWidgetMaintenance::resetHistoryIcons(const QSet<Entry*>& historyItems)
+{
+    for (Entry* entry : historyItems) {
         entry->setUpdateTimeinfo(false);
         entry->setIcon(0);
         entry->setUpdateTimeinfo(true);
     }
-
-    // Remove the icon from the database
-    database->metadata()->removeCustomIcon(iconUuid);
 }
 
 void DatabaseSettingsWidgetMaintenance::purgeUnusedCustomIcons()
@@ -162,51 +155,9 @@ void DatabaseSettingsWidgetMaintenance::purgeUnusedCustomIcons()
         return;
     }
 
-    QList<Entry*> historyEntries;
-    QSet<QUuid> historicIcons;
-    QSet<QUuid> iconsInUse;
-
-    const QList<Entry*> allEntries = database->rootGroup()->entriesRecursive(true);
-    for (Entry* entry : allEntries) {
-        if (!entry->group()) {
-            // Icons exclusively in use by historic entries (no
-            // group assigned) are also purged from the database
-            historyEntries << entry;
-            historicIcons << entry->iconUuid();
-        } else {
-            iconsInUse << entry->iconUuid();
-        }
-    }
-
-    const QList<Group*> allGroups = database->rootGroup()->groupsRecursive(true);
-    for (Group* group : allGroups) {
-        iconsInUse.insert(group->iconUuid());
-    }
-
-    int purgeCounter = 0;
-    QList<QUuid> customIcons = database->metadata()->customIconsOrder();
-    for (QUuid iconUuid : customIcons) {
-        if (iconsInUse.contains(iconUuid)) {
-            continue;
-        }
-
-        if (historicIcons.contains(iconUuid)) {
-            // Remove the icon from history entries using this icon
-            for (Entry* historicEntry : asConst(historyEntries)) {
-                if (historicEntry->iconUuid() != iconUuid) {
-                    continue;
-                }
-                historicEntry->setUpdateTimeinfo(false);
-                historicEntry->setIcon(0);
-                historicEntry->setUpdateTimeinfo(true);
-            }
-        }
-
-        ++purgeCounter;
-        database->metadata()->removeCustomIcon(iconUuid);
-    }
-
-    if (0 == purgeCounter) {
+    auto metadata = database->metadata();
+    const QList<QUuid> unusedIcons = metadata->unusedCustomIcons();
+    if (unusedIcons.isEmpty()) {
         MessageBox::information(this,
                                 tr("Custom Icons Are In Use"),
                                 tr("All custom icons are in use by at least one entry or group."),
@@ -214,8 +165,16 @@ void DatabaseSettingsWidgetMaintenance::purgeUnusedCustomIcons()
         return;
     }
 
+    // Icons exclusively in use by historic entries are also purged from the database
+    for (const QUuid& iconUuid : unusedIcons) {
+        resetHistoryIcons(metadata->customIconUsage(iconUuid).historyItems);
+    }
+    metadata->removeCustomIcons(unusedIcons);
+
     populateIcons(database);
 
-    MessageBox::information(
-        this, tr("Purged Unused Icons"), tr("Purged %n icon(s) from the database.", "", purgeCounter), MessageBox::Ok);
+    MessageBox::information(this,
+                            tr("Purged Unused Icons"),
+                            tr("Purged %n icon(s) from the database.", "", unusedIcons.size()),
+                            MessageBox::Ok);
 }
@@ -20,9 +20,12 @@
 
 #include "DatabaseSettingsWidget.h"
 
+#include <QUuid>
+
 class QItemSelection;
 class CustomIconModel;
 class Database;
+class Entry;
 namespace Ui
 {
     class DatabaseSettingsWidgetMaintenance;
@@ -52,7 +55,8 @@ private slots:
 
 private:
     void populateIcons(QSharedPointer<Database> db);
-    void removeSingleCustomIcon(QSharedPointer<Database> database, QModelIndex index);
+    bool removeSingleCustomIcon(QSharedPointer<Database> database, const QUuid& iconUuid);
+    void resetHistoryIcons(const QSet<Entry*>& historyItems);
 
 protected:
     const QScopedPointer<Ui::DatabaseSettingsWidgetMaintenance> m_ui;
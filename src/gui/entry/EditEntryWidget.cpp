@@ -121,6 +121,7 @@ EditEntryWidget::EditEntryWidget(QWidget* parent)
         }
     });
 
+    connect(this, &EditWidget::currentPageChanged, this, &EditEntryWidget::populatePage);
     connect(this, SIGNAL(accepted()), SLOT(acceptEntry()));
     connect(this, SIGNAL(rejected()), SLOT(cancel()));
     connect(this, SIGNAL(apply()), SLOT(commitEntry()));
@@ -653,6 +654,10 @@ void EditEntryWidget::updateSSHAgentAttachment()
 
 void EditEntryWidget::updateSSHAgentAttachments()
 {
+    if (!m_populatedPages.contains(m_sshAgentWidget)) {
+        return;
+    }
+
     // detect if KeeAgent.settings was removed by hand and reset settings
     if (m_entry && KeeAgentSettings::inEntryAttachments(m_entry->attachments())
         && !KeeAgentSettings::inEntryAttachments(m_attachments.data())) {
@@ -941,6 +946,16 @@ void EditEntryWidget::loadEntry(Entry* entry,
 
 void EditEntryWidget::setForms(Entry* entry, bool restore)
 {
+    // Costly pages are filled when they are shown for the first time
+    m_populatedPages.remove(m_autoTypeWidget);
+#ifdef WITH_XC_SSHAGENT
+    m_populatedPages.remove(m_sshAgentWidget);
+#endif
+    if (!m_history && !restore) {
+        m_populatedPages.remove(m_historyWidget);
+        m_historyModel->clear();
+    }
+
     m_attachments->copyDataFrom(entry->attachments());
     m_customData->copyDataFrom(entry->customData());
 
@@ -1040,17 +1055,8 @@ void EditEntryWidget::setForms(Entry* entry, bool restore)
     if (m_autoTypeAssoc->size() != 0) {
         m_autoTypeUi->assocView->setCurrentIndex(m_autoTypeAssocModel->index(0, 0));
     }
-    if (!m_history) {
-        m_autoTypeUi->windowTitleCombo->refreshWindowList();
-    }
     updateAutoTypeEnabled();
 
-#ifdef WITH_XC_SSHAGENT
-    if (sshAgent()->isEnabled()) {
-        updateSSHAgent();
-    }
-#endif
-
 #ifdef WITH_XC_BROWSER
     if (config()->get(Config::Browser_Enabled).toBool()) {
         if (!hasPage(m_browserWidget)) {
@@ -1122,10 +1128,6 @@ void EditEntryWidget::setForms(Entry* entry, bool restore)
 
     m_editWidgetProperties->setFields(entry->timeInfo(), entry->uuid());
 
-    if (!m_history && !restore) {
-        m_historyModel->setEntries(entry->historyItems(), entry);
-        m_historyUi->historyView->sortByColumn(0, Qt::DescendingOrder);
-    }
     if (m_historyModel->rowCount() > 0) {
         m_historyUi->deleteAllButton->setEnabled(true);
     } else {
@@ -1134,9 +1136,49 @@ void EditEntryWidget::setForms(Entry* entry, bool restore)
 
     updateHistoryButtons(m_historyUi->historyView->currentIndex(), QModelIndex());
 
+    populatePage(currentPage());
+
     m_mainUi->titleEdit->setFocus();
 }
 
+/**
+ * Fill a page the first time it is shown after loading an entry. The Auto-Type
+ * window list, the SSH Agent key details and the entry history are costly to
+ * build and are not needed unless the user opens these pages.
+ */
+void EditEntryWidget::populatePage(int index)
+{
+    if (!m_entry || index < 0) {
+        return;
+    }
+
+    if (index == pageIndex(m_autoTypeWidget) && !m_populatedPages.contains(m_autoTypeWidget)) {
+        m_populatedPages.insert(m_autoTypeWidget);
+        if (!m_history) {
+            m_autoTypeUi->windowTitleCombo->refreshWindowList();
+        }
+    }
+
+#ifdef WITH_XC_SSHAGENT
+    if (index == pageIndex(m_sshAgentWidget) && !m_populatedPages.contains(m_sshAgentWidget)) {
+        m_populatedPages.insert(m_sshAgentWidget);
+        if (sshAgent()->isEnabled()) {
+            updateSSHAgent();
+        }
+    }
+#endif
+
+    if (index == pageIndex(m_historyWidget) && !m_populatedPages.contains(m_historyWidget)) {
+        m_populatedPages.insert(m_historyWidget);
+        if (!m_history) {
+            m_historyModel->setEntries(m_entry->historyItems(), m_entry);
+            m_historyUi->historyView->sortByColumn(0, Qt::DescendingOrder);
+        }
+        m_historyUi->deleteAllButton->setEnabled(m_historyModel->rowCount() > 0);
+        updateHistoryButtons(m_historyUi->historyView->currentIndex(), QModelIndex());
+    }
+}
+
 /**
  * Commit the form values to in-memory database representation
  *
@@ -1208,7 +1250,9 @@ bool EditEntryWidget::commitEntry()
     m_autoTypeAssoc->removeEmpty();
 
 #ifdef WITH_XC_SSHAGENT
-    toKeeAgentSettings(m_sshAgentSettings);
+    if (m_populatedPages.contains(m_sshAgentWidget)) {
+        toKeeAgentSettings(m_sshAgentSettings);
+    }
 #endif
 
     // Begin entry update
@@ -1229,8 +1273,10 @@ bool EditEntryWidget::commitEntry()
     }
     // End entry update
 
-    m_historyModel->setEntries(m_entry->historyItems(), m_entry);
+    m_populatedPages.remove(m_historyWidget);
+    m_historyModel->clear();
     setPageHidden(m_historyWidget, m_history || m_entry->historyItems().count() < 1);
+    populatePage(currentPage());
     m_advancedUi->attachmentsWidget->linkAttachments(m_entry->attachments());
 
     showMessage(tr("Entry updated successfully."), MessageWidget::Positive);
@@ -1305,7 +1351,8 @@ void EditEntryWidget::updateEntryData(Entry* entry) const
     entry->autoTypeAssociations()->copyDataFrom(m_autoTypeAssoc);
 
 #ifdef WITH_XC_SSHAGENT
-    if (sshAgent()->isEnabled()) {
+    // The settings are only read back if the user has seen the SSH Agent page
+    if (sshAgent()->isEnabled() && m_populatedPages.contains(m_sshAgentWidget)) {
         m_sshAgentSettings.toEntry(entry);
     }
 #endif
@@ -1375,6 +1422,7 @@ void EditEntryWidget::clear()
 
     m_entry = nullptr;
     m_db.reset();
+    m_populatedPages.clear();
 
     m_mainUi->titleEdit->setText("");
     m_mainUi->passwordEdit->setText("");
@@ -23,6 +23,7 @@
 #include <QCheckBox>
 #include <QCompleter>
 #include <QPointer>
+#include <QSet>
 #include <QTimer>
 
 #include "config-keepassx.h"
@@ -124,6 +125,7 @@ private slots:
     void useExpiryPreset(QAction* action);
     void toggleHideNotes(bool visible);
     void pickColor();
+    void populatePage(int index);
 #ifdef WITH_XC_SSHAGENT
     void toKeeAgentSettings(KeeAgentSettings& settings) const;
     void setSSHAgentSettings();
@@ -221,6 +223,7 @@ private:
     QCompleter* const m_usernameCompleter;
     QStringListModel* const m_usernameCompleterModel;
     QTimer m_entryModifiedTimer;
+    QSet<const QWidget*> m_populatedPages;
 
     Q_DISABLE_COPY(EditEntryWidget)
 };
@@ -17,6 +17,7 @@
 
 #include "EntryHistoryModel.h"
 
+#include "core/AsyncTask.h"
 #include "core/Clock.h"
 #include "core/Entry.h"
 #include "core/Global.h"
@@ -24,9 +25,130 @@
 
 #include <QFont>
 
+namespace
+{
+    // Copy of the compared fields of an entry. The containers are implicitly
+    // shared, so taking a snapshot is cheap and the comparison itself can run
+    // outside the GUI thread without touching the entry.
+    struct EntrySnapshot
+    {
+        QMap<QString, QString> attributes;
+        QSet<QString> protectedAttributes;
+        int iconNumber;
+        QUuid iconUuid;
+        QString foregroundColor;
+        QString backgroundColor;
+        bool expires;
+        QDateTime expiryTime;
+        QString totp;
+        QMap<QString, QString> customData;
+        QMap<QString, QByteArray> attachments;
+        QList<AutoTypeAssociations::Association> autoTypeAssociations;
+        bool autoTypeEnabled;
+        QString defaultAutoTypeSequence;
+        QString tags;
+    };
+
+    EntrySnapshot takeSnapshot(const Entry* entry)
+    {
+        EntrySnapshot snapshot;
+        const auto attributes = entry->attributes();
+        for (const auto& key : attributes->keys()) {
+            snapshot.attributes.insert(key, attributes->value(key));
+            if (attributes->isProtected(key)) {
+                snapshot.protectedAttributes.insert(key);
+            }
+        }
+        snapshot.iconNumber = entry->iconNumber();
+        snapshot.iconUuid = entry->iconUuid();
+        snapshot.foregroundColor = entry->foregroundColor();
+        snapshot.backgroundColor = entry->backgroundColor();
+        snapshot.expires = entry->timeInfo().expires();
+        snapshot.expiryTime = entry->timeInfo().expiryTime();
+        snapshot.totp = entry->totp();
+        for (const auto& key : entry->customData()->keys()) {
+            snapshot.customData.insert(key, entry->customData()->value(key));
+        }
+        for (const auto& key : entry->attachments()->keys()) {
+            snapshot.attachments.insert(key, entry->attachments()->value(key));
+        }
+        snapshot.autoTypeAssociations = entry->autoTypeAssociations()->getAll();
+        snapshot.autoTypeEnabled = entry->autoTypeEnabled();
+        snapshot.defaultAutoTypeSequence = entry->defaultAutoTypeSequence();
+        snapshot.tags = entry->tags();
+        return snapshot;
+    }
+
+    QString calculateModifications(const EntrySnapshot& curr, const EntrySnapshot& compare)
+    {
+        QStringList modifiedFields;
+
+        if (curr.attributes != compare.attributes || curr.protectedAttributes != compare.protectedAttributes) {
+            bool foundAttribute = false;
+            const auto changed = [&](const QString& key) {
+                return curr.attributes.value(key) != compare.attributes.value(key);
+            };
+
+            if (changed(EntryAttributes::TitleKey)) {
+                modifiedFields << EntryHistoryModel::tr("Title");
+                foundAttribute = true;
+            }
+            if (changed(EntryAttributes::UserNameKey)) {
+                modifiedFields << EntryHistoryModel::tr("Username");
+                foundAttribute = true;
+            }
+            if (changed(EntryAttributes::PasswordKey)) {
+                modifiedFields << EntryHistoryModel::tr("Password");
+                foundAttribute = true;
+            }
+            if (changed(EntryAttributes::URLKey)) {
+                modifiedFields << EntryHistoryModel::tr("URL");
+                foundAttribute = true;
+            }
+            if (changed(EntryAttributes::NotesKey)) {
+                modifiedFields << EntryHistoryModel::tr("Notes");
+                foundAttribute = true;
+            }
+
+            if (!foundAttribute) {
+                modifiedFields << EntryHistoryModel::tr("Custom Attributes");
+            }
+        }
+        if (curr.iconNumber != compare.iconNumber || curr.iconUuid != compare.iconUuid) {
+            modifiedFields << EntryHistoryModel::tr("Icon");
+        }
+        if (curr.foregroundColor != compare.foregroundColor || curr.backgroundColor != compare.backgroundColor) {
+            modifiedFields << EntryHistoryModel::tr("Color");
+        }
+        if (curr.expires != compare.expires || curr.expiryTime != compare.expiryTime) {
+            modifiedFields << EntryHistoryModel::tr("Expiration");
+        }
+        if (curr.totp != compare.totp) {
+            modifiedFields << EntryHistoryModel::tr("TOTP");
+        }
+        if (curr.customData != compare.customData) {
+            modifiedFields << EntryHistoryModel::tr("Custom Data");
+        }
+        if (curr.attachments != compare.attachments) {
+            modifiedFields << EntryHistoryModel::tr("Attachments");
+        }
+        if (curr.autoTypeAssociations != compare.autoTypeAssociations || curr.autoTypeEnabled != compare.autoTypeEnabled
+            || curr.defaultAutoTypeSequence != compare.defaultAutoTypeSequence) {
+            modifiedFields << EntryHistoryModel::tr("Auto-Type");
+        }
+        if (curr.tags != compare.tags) {
+            modifiedFields << EntryHistoryModel::tr("Tags");
+        }
+
+        return modifiedFields.join(", ");
+    }
+} // namespace
+
 EntryHistoryModel::EntryHistoryModel(QObject* parent)
     : QAbstractTableModel(parent)
     , m_systemLocale(QLocale::system())
+    , m_parentEntry(nullptr)
+    , m_generation(0)
 {
 }
 
@@ -82,11 +204,26 @@ QVariant EntryHistoryModel::data(const QModelIndex& index, int role) const
             }
             return seconds;
         }
-        case 2:
-            if (index.row() < m_historyModifications.size()) {
-                return m_historyModifications[index.row()];
+        case 2: {
+            // Calculated on demand for the rows that are actually shown
+            const auto pair = modificationPair(index.row());
+            if (!pair.first) {
+                return {};
+            }
+            auto it = m_modifications.constFind(pair);
+            if (it != m_modifications.constEnd()) {
+                return it.value();
+            }
+            if (!m_runningModifications.contains(pair)) {
+                if (m_requestedModifications.isEmpty()) {
+                    QMetaObject::invokeMethod(const_cast<EntryHistoryModel*>(this),
+                                              "calculatePendingModifications",
+                                              Qt::QueuedConnection);
+                }
+                m_requestedModifications.insert(pair);
             }
             return {};
+        }
         case 3:
             if (role == Qt::DisplayRole) {
                 return Tools::humanReadableFileSize(entry->size(), 0);
@@ -131,7 +268,7 @@ void EntryHistoryModel::setEntries(const QList<Entry*>& entries, Entry* parentEn
         return lhs->timeInfo().lastModificationTime() > rhs->timeInfo().lastModificationTime();
     });
     m_deletedHistoryEntries.clear();
-    calculateHistoryModifications();
+    resetModifications();
     endResetModel();
 }
 
@@ -141,6 +278,7 @@ void EntryHistoryModel::clear()
 
     m_historyEntries.clear();
     m_deletedHistoryEntries.clear();
+    resetModifications();
 
     endResetModel();
 }
@@ -162,8 +300,13 @@ void EntryHistoryModel::deleteIndex(QModelIndex index)
         beginRemoveRows(QModelIndex(), index.row(), index.row());
         m_historyEntries.removeAt(index.row());
         m_deletedHistoryEntries << entry;
-        calculateHistoryModifications();
         endRemoveRows();
+
+        // The newer neighbour is now compared against a different entry
+        if (index.row() > 0) {
+            auto neighbour = this->index(index.row() - 1, 2);
+            emit dataChanged(neighbour, neighbour);
+        }
     }
 }
 
@@ -182,78 +325,74 @@ void EntryHistoryModel::deleteAll()
     endRemoveRows();
 }
 
-void EntryHistoryModel::calculateHistoryModifications()
+bool EntryHistoryModel::hasPendingModifications() const
 {
-    m_historyModifications.clear();
+    return !m_requestedModifications.isEmpty() || !m_runningModifications.isEmpty();
+}
 
-    Entry* compare = nullptr;
-    for (const auto curr : m_historyEntries) {
-        if (!compare) {
-            compare = curr;
+/**
+ * Compare the requested pairs of consecutive history items on a worker thread
+ * and cache the results.
+ */
+void EntryHistoryModel::calculatePendingModifications()
+{
+    QList<QPair<EntryPair, QPair<EntrySnapshot, EntrySnapshot>>> work;
+    const auto entries = Tools::asSet(m_historyEntries);
+    for (const auto& pair : asConst(m_requestedModifications)) {
+        if (m_modifications.contains(pair) || m_runningModifications.contains(pair) || !entries.contains(pair.first)
+            || !entries.contains(pair.second)) {
             continue;
         }
+        m_runningModifications.insert(pair);
+        work.append({pair, {takeSnapshot(pair.first), takeSnapshot(pair.second)}});
+    }
+    m_requestedModifications.clear();
+    if (work.isEmpty()) {
+        return;
+    }
 
-        QStringList modifiedFields;
-
-        if (*curr->attributes() != *compare->attributes()) {
-            bool foundAttribute = false;
-
-            if (curr->title() != compare->title()) {
-                modifiedFields << tr("Title");
-                foundAttribute = true;
+    const auto generation = m_generation;
+    AsyncTask::runThenCallback(
+        [work] {
+            QList<QPair<EntryPair, QString>> results;
+            for (const auto& item : work) {
+                results.append({item.first, calculateModifications(item.second.first, item.second.second)});
             }
-            if (curr->username() != compare->username()) {
-                modifiedFields << tr("Username");
-                foundAttribute = true;
+            return results;
+        },
+        this,
+        [this, generation](const QList<QPair<EntryPair, QString>>& results) {
+            if (generation != m_generation) {
+                // The entries were replaced in the meantime
+                return;
             }
-            if (curr->password() != compare->password()) {
-                modifiedFields << tr("Password");
-                foundAttribute = true;
+            for (const auto& result : results) {
+                m_runningModifications.remove(result.first);
+                m_modifications.insert(result.first, result.second);
             }
-            if (curr->url() != compare->url()) {
-                modifiedFields << tr("URL");
-                foundAttribute = true;
-            }
-            if (curr->notes() != compare->notes()) {
-                modifiedFields << tr("Notes");
-                foundAttribute = true;
+            if (!m_historyEntries.isEmpty()) {
+                emit dataChanged(index(0, 2), index(m_historyEntries.size() - 1, 2));
             }
+            emit modificationsCalculated();
+        });
+}
 
-            if (!foundAttribute) {
-                modifiedFields << tr("Custom Attributes");
-            }
-        }
-        if (curr->iconNumber() != compare->iconNumber() || curr->iconUuid() != compare->iconUuid()) {
-            modifiedFields << tr("Icon");
-        }
-        if (curr->foregroundColor() != compare->foregroundColor()
-            || curr->backgroundColor() != compare->backgroundColor()) {
-            modifiedFields << tr("Color");
-        }
-        if (curr->timeInfo().expires() != compare->timeInfo().expires()
-            || curr->timeInfo().expiryTime() != compare->timeInfo().expiryTime()) {
-            modifiedFields << tr("Expiration");
-        }
-        if (curr->totp() != compare->totp()) {
-            modifiedFields << tr("TOTP");
-        }
-        if (*curr->customData() != *compare->customData()) {
-            modifiedFields << tr("Custom Data");
-        }
-        if (*curr->attachments() != *compare->attachments()) {
-            modifiedFields << tr("Attachments");
-        }
-        if (*curr->autoTypeAssociations() != *compare->autoTypeAssociations()
-            || curr->autoTypeEnabled() != compare->autoTypeEnabled()
-            || curr->defaultAutoTypeSequence() != compare->defaultAutoTypeSequence()) {
-            modifiedFields << tr("Auto-Type");
-        }
-        if (curr->tags() != compare->tags()) {
-            modifiedFields << tr("Tags");
-        }
-
-        m_historyModifications << modifiedFields.join(", ");
-
-        compare = curr;
+/**
+ * The entries whose differences are shown in the given row: the item of
+ * the row and the next older one.
+ */
+EntryHistoryModel::EntryPair EntryHistoryModel::modificationPair(int row) const
+{
+    if (row < 0 || row + 1 >= m_historyEntries.size()) {
+        return {nullptr, nullptr};
     }
+    return {m_historyEntries.at(row + 1), m_historyEntries.at(row)};
+}
+
+void EntryHistoryModel::resetModifications()
+{
+    ++m_generation;
+    m_modifications.clear();
+    m_requestedModifications.clear();
+    m_runningModifications.clear();
 }
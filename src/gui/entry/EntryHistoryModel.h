@@ -19,7 +19,9 @@
 #define KEEPASSX_ENTRYHISTORYMODEL_H
 
 #include <QAbstractTableModel>
+#include <QHash>
 #include <QLocale>
+#include <QSet>
 
 class Entry;
 
@@ -43,14 +45,30 @@ public:
     void deleteIndex(QModelIndex index);
     void deleteAll();
 
+    bool hasPendingModifications() const;
+
+signals:
+    void modificationsCalculated();
+
+private slots:
+    void calculatePendingModifications();
+
 private:
-    void calculateHistoryModifications();
+    using EntryPair = QPair<Entry*, Entry*>;
+
+    EntryPair modificationPair(int row) const;
+    void resetModifications();
 
     QLocale m_systemLocale;
     QList<Entry*> m_historyEntries;
     QList<Entry*> m_deletedHistoryEntries;
-    QStringList m_historyModifications;
     const Entry* m_parentEntry;
+
+    // Differences between consecutive items, keyed by (older, newer) entry
+    QHash<EntryPair, QString> m_modifications;
+    mutable QSet<EntryPair> m_requestedModifications;
+    QSet<EntryPair> m_runningModifications;
+    quint64 m_generation;
 };
 
 #endif // KEEPASSX_ENTRYHISTORYMODEL_H
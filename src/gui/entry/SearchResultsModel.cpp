@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "SearchResultsModel.h"
+
+#include <QFileInfo>
+
+#include "core/Config.h"
+#include "core/Entry.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "core/MultiDatabaseSearcher.h"
+#include "gui/Icons.h"
+
+SearchResultsModel::SearchResultsModel(MultiDatabaseSearcher* searcher, QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_searcher(searcher)
+{
+    // Results are merged by rank as each database finishes, so rows are not stable between updates
+    connect(m_searcher, &MultiDatabaseSearcher::resultsChanged, this, &SearchResultsModel::resultsChanged);
+}
+
+Entry* SearchResultsModel::entryFromIndex(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.row() >= m_searcher->results().size()) {
+        return nullptr;
+    }
+    return m_searcher->results().at(index.row()).entry;
+}
+
+Database* SearchResultsModel::databaseFromIndex(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.row() >= m_searcher->results().size()) {
+        return nullptr;
+    }
+    return m_searcher->results().at(index.row()).database;
+}
+
+int SearchResultsModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_searcher->results().size();
+}
+
+int SearchResultsModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return 5;
+}
+
+QVariant SearchResultsModel::data(const QModelIndex& index, int role) const
+{
+    auto entry = entryFromIndex(index);
+    auto db = databaseFromIndex(index);
+    if (!entry || !db) {
+        return {};
+    }
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case Title:
+            return entry->resolveMultiplePlaceholders(entry->title());
+        case Username:
+            if (config()->get(Config::GUI_HideUsernames).toBool()) {
+                return QString("\u25cf").repeated(6);
+            }
+            return entry->resolveMultiplePlaceholders(entry->username());
+        case Url:
+            return entry->resolveMultiplePlaceholders(entry->displayUrl());
+        case ParentGroupPath:
+            if (entry->group()) {
+                return entry->group()->hierarchy().join("/");
+            }
+            break;
+        case DatabaseName:
+            if (!db->metadata()->name().isEmpty()) {
+                return db->metadata()->name();
+            }
+            return QFileInfo(db->filePath()).fileName();
+        }
+    } else if (role == Qt::DecorationRole && index.column() == Title) {
+        return Icons::entryIconPixmap(entry);
+    } else if (role == Qt::ToolTipRole && index.column() == DatabaseName) {
+        return db->filePath();
+    }
+
+    return {};
+}
+
+QVariant SearchResultsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+
+    switch (section) {
+    case Title:
+        return tr("Title");
+    case Username:
+        return tr("Username");
+    case Url:
+        return tr("URL");
+    case ParentGroupPath:
+        return tr("Group");
+    case DatabaseName:
+        return tr("Database");
+    }
+
+    return {};
+}
+
+void SearchResultsModel::resultsChanged()
+{
+    beginResetModel();
+    endResetModel();
+}
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef KEEPASSXC_SEARCHRESULTSMODEL_H
+#define KEEPASSXC_SEARCHRESULTSMODEL_H
+
+#include <QAbstractTableModel>
+
+class Database;
+class Entry;
+class MultiDatabaseSearcher;
+
+/**
+ * Flat list of the results of a search across all open databases,
+ * including the database and group each entry belongs to.
+ */
+class SearchResultsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum ModelColumn
+    {
+        Title = 0,
+        Username = 1,
+        Url = 2,
+        ParentGroupPath = 3,
+        DatabaseName = 4
+    };
+
+    explicit SearchResultsModel(MultiDatabaseSearcher* searcher, QObject* parent = nullptr);
+
+    Entry* entryFromIndex(const QModelIndex& index) const;
+    Database* databaseFromIndex(const QModelIndex& index) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private slots:
+    void resultsChanged();
+
+private:
+    MultiDatabaseSearcher* m_searcher;
+};
+
+#endif // KEEPASSXC_SEARCHRESULTSMODEL_H
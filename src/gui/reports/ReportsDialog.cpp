@@ -18,6 +18,7 @@
 #include "ReportsDialog.h"
 #include "ui_ReportsDialog.h"
 
+#include "ReportsPageDuplicates.h"
 #include "ReportsPageHealthcheck.h"
 #include "ReportsPageHibp.h"
 #include "ReportsPageStatistics.h"
@@ -29,6 +30,7 @@
 #include "ReportsPagePasskeys.h"
 #include "ReportsWidgetPasskeys.h"
 #endif
+#include "ReportsWidgetDuplicates.h"
 #include "ReportsWidgetHealthcheck.h"
 #include "ReportsWidgetHibp.h"
 
@@ -61,6 +63,7 @@ ReportsDialog::ReportsDialog(QWidget* parent)
     : DialogyWidget(parent)
     , m_ui(new Ui::ReportsDialog())
     , m_healthPage(new ReportsPageHealthcheck())
+    , m_duplicatesPage(new ReportsPageDuplicates())
     , m_hibpPage(new ReportsPageHibp())
     , m_statPage(new ReportsPageStatistics())
 #ifdef WITH_XC_BROWSER
@@ -76,6 +79,7 @@ ReportsDialog::ReportsDialog(QWidget* parent)
     connect(m_ui->buttonBox, SIGNAL(rejected()), SLOT(reject()));
     addPage(m_statPage);
     addPage(m_healthPage);
+    addPage(m_duplicatesPage);
 #ifdef WITH_XC_BROWSER_PASSKEYS
     addPage(m_passkeysPage);
 #endif
@@ -94,6 +98,9 @@ ReportsDialog::ReportsDialog(QWidget* parent)
     connect(m_ui->categoryList, SIGNAL(categoryChanged(int)), m_ui->stackedWidget, SLOT(setCurrentIndex(int)));
     connect(m_healthPage->m_healthWidget, SIGNAL(entryActivated(Entry*)), SLOT(entryActivationSignalReceived(Entry*)));
     connect(m_hibpPage->m_hibpWidget, SIGNAL(entryActivated(Entry*)), SLOT(entryActivationSignalReceived(Entry*)));
+    connect(m_duplicatesPage->m_duplicatesWidget,
+            SIGNAL(entryActivated(Entry*)),
+            SLOT(entryActivationSignalReceived(Entry*)));
 #ifdef WITH_XC_BROWSER
     connect(m_browserStatPage->m_browserWidget,
             SIGNAL(entryActivated(Entry*)),
@@ -175,6 +182,8 @@ void ReportsDialog::switchToMainView(bool previousDialogAccepted)
             m_healthPage->m_healthWidget->calculateHealth();
         } else if (m_sender == m_hibpPage->m_hibpWidget) {
             m_hibpPage->m_hibpWidget->refreshAfterEdit();
+        } else if (m_sender == m_duplicatesPage->m_duplicatesWidget) {
+            m_duplicatesPage->m_duplicatesWidget->findDuplicates();
         }
 #ifdef WITH_XC_BROWSER
         if (m_sender == m_browserStatPage->m_browserWidget) {
@@ -26,6 +26,7 @@ class Database;
 class Entry;
 class Group;
 class QTabWidget;
+class ReportsPageDuplicates;
 class ReportsPageHealthcheck;
 class ReportsPageHibp;
 class ReportsPageStatistics;
@@ -78,6 +79,7 @@ private:
     QSharedPointer<Database> m_db;
     const QScopedPointer<Ui::ReportsDialog> m_ui;
     const QSharedPointer<ReportsPageHealthcheck> m_healthPage;
+    const QSharedPointer<ReportsPageDuplicates> m_duplicatesPage;
     const QSharedPointer<ReportsPageHibp> m_hibpPage;
     const QSharedPointer<ReportsPageStatistics> m_statPage;
 #ifdef WITH_XC_BROWSER
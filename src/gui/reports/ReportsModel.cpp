@@ -0,0 +1,235 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReportsModel.h"
+
+#include "core/Group.h"
+#include "gui/Icons.h"
+
+#include <QBrush>
+
+ReportsModel::ReportsModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void ReportsModel::setHeaders(const QStringList& headers)
+{
+    m_headers = headers;
+    if (!m_rows.isEmpty()) {
+        emit headerDataChanged(Qt::Horizontal, 0, m_headers.size() - 1);
+    }
+}
+
+void ReportsModel::setCellData(const CellData& cellData)
+{
+    m_cellData = cellData;
+}
+
+/**
+ * Replace all rows of the report.
+ *
+ * @param rows new report rows
+ * @param emptyMessage header text to show if there are no rows
+ */
+void ReportsModel::setRows(QVector<Row> rows, const QString& emptyMessage)
+{
+    beginResetModel();
+    m_rows = std::move(rows);
+    m_message = emptyMessage;
+    m_note.clear();
+    m_paths.clear();
+    endResetModel();
+}
+
+/**
+ * Remove all rows and only show the given message as header.
+ */
+void ReportsModel::setMessage(const QString& message)
+{
+    setRows({}, message);
+}
+
+/**
+ * Show an additional row with the given text (e.g. an error) below the report rows.
+ */
+void ReportsModel::setNote(const QString& note)
+{
+    beginResetModel();
+    m_note = note;
+    endResetModel();
+}
+
+const ReportsModel::Row* ReportsModel::row(int row) const
+{
+    if (row < 0 || row >= m_rows.size()) {
+        return nullptr;
+    }
+    return &m_rows[row];
+}
+
+Entry* ReportsModel::entry(const QModelIndex& index) const
+{
+    auto reportRow = row(index.row());
+    return reportRow ? reportRow->entry.data() : nullptr;
+}
+
+/**
+ * Standard title column: entry icon and title, marked if excluded or expired.
+ */
+QVariant ReportsModel::titleData(int row, int role) const
+{
+    const auto& reportRow = m_rows.at(row);
+    switch (role) {
+    case Qt::DisplayRole:
+    case SortRole: {
+        auto title = reportRow.entry->title();
+        if (reportRow.excluded) {
+            title.append(tr(" (Excluded)"));
+        }
+        if (reportRow.entry->isExpired()) {
+            title.append(tr(" (Expired)"));
+        }
+        return title;
+    }
+    case Qt::DecorationRole:
+        return Icons::entryIconPixmap(reportRow.entry);
+    case Qt::ToolTipRole:
+        if (reportRow.excluded) {
+            return tr("This entry is being excluded from reports");
+        }
+        break;
+    }
+    return {};
+}
+
+/**
+ * Standard path column: group icon and group path. Paths are cached per group.
+ */
+QVariant ReportsModel::pathData(int row, int role) const
+{
+    const auto& reportRow = m_rows.at(row);
+    if (!reportRow.group) {
+        return {};
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case SortRole: {
+        auto path = m_paths.constFind(reportRow.group);
+        if (path == m_paths.constEnd()) {
+            path = m_paths.insert(reportRow.group, reportRow.group->hierarchy().join("/"));
+        }
+        return path.value();
+    }
+    case Qt::DecorationRole:
+        return Icons::groupIconPixmap(reportRow.group);
+    }
+    return {};
+}
+
+int ReportsModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rows.size() + (m_note.isEmpty() ? 0 : 1);
+}
+
+int ReportsModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rows.isEmpty() && !m_message.isEmpty() ? 1 : m_headers.size();
+}
+
+QVariant ReportsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) {
+        return {};
+    }
+
+    if (index.row() >= m_rows.size()) {
+        // Trailing note row
+        if (index.column() == 0) {
+            if (role == Qt::DisplayRole) {
+                return m_note;
+            } else if (role == Qt::ForegroundRole) {
+                return QBrush(QColor("red"));
+            }
+        }
+        return {};
+    }
+
+    if (!m_rows.at(index.row()).entry || !m_cellData) {
+        return {};
+    }
+
+    auto value = m_cellData(index.row(), index.column(), role);
+    if (role == SortRole && !value.isValid()) {
+        value = m_cellData(index.row(), index.column(), Qt::DisplayRole);
+    }
+    return value;
+}
+
+QVariant ReportsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        if (m_rows.isEmpty() && !m_message.isEmpty()) {
+            return m_message;
+        }
+        if (section >= 0 && section < m_headers.size()) {
+            return m_headers.at(section);
+        }
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+ReportsFilterProxyModel::ReportsFilterProxyModel(QObject* parent)
+    : QSortFilterProxyModel(parent)
+{
+    setSortRole(ReportsModel::SortRole);
+    setSortLocaleAware(true);
+}
+
+void ReportsFilterProxyModel::setRowFilter(const RowFilter& filter)
+{
+    m_filter = filter;
+    invalidateFilter();
+}
+
+/**
+ * Re-apply the row filter, e.g. after a report option changed.
+ */
+void ReportsFilterProxyModel::refilter()
+{
+    invalidateFilter();
+}
+
+bool ReportsFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
+{
+    Q_UNUSED(sourceParent);
+
+    auto model = qobject_cast<const ReportsModel*>(sourceModel());
+    const auto row = model ? model->row(sourceRow) : nullptr;
+    if (!row || !m_filter) {
+        // Notes and messages are always shown
+        return true;
+    }
+    return row->entry && m_filter(*row);
+}
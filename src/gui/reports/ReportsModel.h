@@ -0,0 +1,111 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_REPORTSMODEL_H
+#define KEEPASSXC_REPORTSMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QPointer>
+#include <QSortFilterProxyModel>
+#include <QVector>
+#include <functional>
+
+class Entry;
+class Group;
+
+/**
+ * Table model shared by the database reports.
+ *
+ * Rows are kept in a flat vector of entries with a precomputed, report
+ * specific score and flags. Cell contents (icons, paths, tooltips) are only
+ * computed when a view asks for them, i.e. for visible rows.
+ */
+class ReportsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles
+    {
+        SortRole = Qt::UserRole + 1
+    };
+
+    struct Row
+    {
+        QPointer<Group> group;
+        QPointer<Entry> entry;
+        int score = 0;
+        quint32 flags = 0;
+        bool excluded = false;
+    };
+
+    // Provides the report specific cell contents of the given row, column and role
+    typedef std::function<QVariant(int row, int column, int role)> CellData;
+
+    explicit ReportsModel(QObject* parent = nullptr);
+
+    void setHeaders(const QStringList& headers);
+    void setCellData(const CellData& cellData);
+    void setRows(QVector<Row> rows, const QString& emptyMessage = {});
+    void setMessage(const QString& message);
+    void setNote(const QString& note);
+
+    const Row* row(int row) const;
+    Entry* entry(const QModelIndex& index) const;
+
+    QVariant titleData(int row, int role) const;
+    QVariant pathData(int row, int role) const;
+
+    int rowCount(const QModelIndex& parent = {}) const override;
+    int columnCount(const QModelIndex& parent = {}) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList m_headers;
+    CellData m_cellData;
+    QVector<Row> m_rows;
+    QString m_message;
+    QString m_note;
+    mutable QHash<const Group*, QString> m_paths;
+};
+
+/**
+ * Sort and filter proxy for ReportsModel. Report options such as showing
+ * expired or excluded entries are applied here instead of rebuilding the model.
+ */
+class ReportsFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<bool(const ReportsModel::Row& row)> RowFilter;
+
+    explicit ReportsFilterProxyModel(QObject* parent = nullptr);
+
+    void setRowFilter(const RowFilter& filter);
+    void refilter();
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    RowFilter m_filter;
+};
+
+#endif // KEEPASSXC_REPORTSMODEL_H
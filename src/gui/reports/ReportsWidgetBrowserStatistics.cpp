@@ -24,16 +24,20 @@
 #include "core/Metadata.h"
 #include "gui/GuiTools.h"
 #include "gui/Icons.h"
-#include "gui/styles/StateColorPalette.h"
+#include "gui/reports/ReportsModel.h"
 
 #include <QJsonDocument>
 #include <QMenu>
 #include <QShortcut>
-#include <QSortFilterProxyModel>
-#include <QStandardItemModel>
 
 namespace
 {
+    enum RowFlags
+    {
+        HasUrls = 1,
+        HasSettings = 2
+    };
+
     class BrowserStatistics
     {
     public:
@@ -94,13 +98,22 @@ BrowserStatistics::BrowserStatistics(QSharedPointer<Database> db)
 ReportsWidgetBrowserStatistics::ReportsWidgetBrowserStatistics(QWidget* parent)
     : QWidget(parent)
     , m_ui(new Ui::ReportsWidgetBrowserStatistics())
-    , m_referencesModel(new QStandardItemModel(this))
-    , m_modelProxy(new QSortFilterProxyModel(this))
+    , m_referencesModel(new ReportsModel(this))
+    , m_modelProxy(new ReportsFilterProxyModel(this))
 {
     m_ui->setupUi(this);
 
+    m_referencesModel->setHeaders(QStringList() << tr("Title") << tr("Path") << tr("URLs") << tr("Allowed URLs")
+                                                << tr("Denied URLs"));
+    m_referencesModel->setCellData([this](int row, int column, int role) { return statisticsData(row, column, role); });
     m_modelProxy->setSourceModel(m_referencesModel.data());
-    m_modelProxy->setSortLocaleAware(true);
+    m_modelProxy->setRowFilter([this](const ReportsModel::Row& row) {
+        // Exclude expired entries if not requested, entries without URLs and
+        // entries without Browser Integration settings if requested
+        return (m_ui->showExpired->isChecked() || !row.entry->isExpired())
+               && (!m_ui->showEntriesWithUrlOnlyCheckBox->isChecked() || (row.flags & HasUrls))
+               && (!m_ui->showAllowDenyCheckBox->isChecked() || (row.flags & HasSettings));
+    });
     m_ui->browserStatisticsTableView->setModel(m_modelProxy.data());
     m_ui->browserStatisticsTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
     m_ui->browserStatisticsTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
@@ -110,9 +123,13 @@ ReportsWidgetBrowserStatistics::ReportsWidgetBrowserStatistics(QWidget* parent)
             SLOT(customMenuRequested(QPoint)));
     connect(
         m_ui->browserStatisticsTableView, SIGNAL(doubleClicked(QModelIndex)), SLOT(emitEntryActivated(QModelIndex)));
-    connect(m_ui->showEntriesWithUrlOnlyCheckBox, SIGNAL(stateChanged(int)), this, SLOT(calculateBrowserStatistics()));
-    connect(m_ui->showAllowDenyCheckBox, SIGNAL(stateChanged(int)), this, SLOT(calculateBrowserStatistics()));
-    connect(m_ui->showExpired, SIGNAL(stateChanged(int)), this, SLOT(calculateBrowserStatistics()));
+    connect(m_ui->showEntriesWithUrlOnlyCheckBox,
+            &QCheckBox::stateChanged,
+            m_modelProxy.data(),
+            &ReportsFilterProxyModel::refilter);
+    connect(
+        m_ui->showAllowDenyCheckBox, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
+    connect(m_ui->showExpired, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
 
     new QShortcut(Qt::Key_Delete, this, SLOT(deleteSelectedEntries()));
 }
@@ -121,62 +138,48 @@ ReportsWidgetBrowserStatistics::~ReportsWidgetBrowserStatistics()
 {
 }
 
-void ReportsWidgetBrowserStatistics::addStatisticsRow(bool hasUrls,
-                                                      bool hasSettings,
-                                                      Group* group,
-                                                      Entry* entry,
-                                                      bool excluded)
+QVariant ReportsWidgetBrowserStatistics::statisticsData(int row, int column, int role) const
 {
-    StateColorPalette statePalette;
-
-    auto urlList = entry->getAllUrls();
-    auto urlToolTip = hasUrls ? tr("List of entry URLs") : tr("Entry has no URLs set");
-
-    auto browserConfig = getBrowserConfigFromEntry(entry);
-    auto allowedUrlsList = browserConfig["Allow"];
-    auto deniedUrlsList = browserConfig["Deny"];
-
-    auto allowedUrlsToolTip = hasSettings ? tr("Allowed URLs") : tr("Entry has no Browser Integration settings");
-    auto deniedUrlsToolTip = hasSettings ? tr("Denied URLs") : tr("Entry has no Browser Integration settings");
-
-    auto title = entry->title();
-    if (excluded) {
-        title.append(tr(" (Excluded)"));
+    switch (column) {
+    case 0:
+        return m_referencesModel->titleData(row, role);
+    case 1:
+        return m_referencesModel->pathData(row, role);
     }
-    if (entry->isExpired()) {
-        title.append(tr(" (Expired)"));
+
+    const auto reportRow = m_referencesModel->row(row);
+    const bool hasSettings = reportRow->flags & HasSettings;
+    if (column == 2) {
+        if (role == Qt::DisplayRole) {
+            return reportRow->entry->getAllUrls().join('\n');
+        } else if (role == Qt::ToolTipRole) {
+            return (reportRow->flags & HasUrls) ? tr("List of entry URLs") : tr("Entry has no URLs set");
+        }
+        return {};
     }
 
-    auto row = QList<QStandardItem*>();
-    row << new QStandardItem(Icons::entryIconPixmap(entry), title);
-    row << new QStandardItem(Icons::groupIconPixmap(group), group->hierarchy().join("/"));
-    row << new QStandardItem(urlList.join('\n'));
-    row << new QStandardItem(allowedUrlsList.join('\n'));
-    row << new QStandardItem(deniedUrlsList.join('\n'));
-
-    // Set tooltips
-    row[2]->setToolTip(urlToolTip);
-    row[3]->setToolTip(allowedUrlsToolTip);
-    row[4]->setToolTip(deniedUrlsToolTip);
-    if (excluded) {
-        row[0]->setToolTip(tr("This entry is being excluded from reports"));
+    if (role == Qt::ToolTipRole) {
+        if (!hasSettings) {
+            return tr("Entry has no Browser Integration settings");
+        }
+        return column == 3 ? tr("Allowed URLs") : tr("Denied URLs");
+    } else if (role != Qt::DisplayRole || !hasSettings) {
+        return {};
     }
 
-    // Store entry pointer per table row (used in double click handler)
-    m_referencesModel->appendRow(row);
-    m_rowToEntry.append({group, entry});
+    auto config = m_browserConfigs.find(row);
+    if (config == m_browserConfigs.end()) {
+        config = m_browserConfigs.insert(row, getBrowserConfigFromEntry(reportRow->entry));
+    }
+    return config.value().value(column == 3 ? "Allow" : "Deny").join('\n');
 }
 
 void ReportsWidgetBrowserStatistics::loadSettings(QSharedPointer<Database> db)
 {
     m_db = std::move(db);
     m_statisticsCalculated = false;
-    m_referencesModel->clear();
-    m_rowToEntry.clear();
-
-    auto row = QList<QStandardItem*>();
-    row << new QStandardItem(tr("Please wait, browser statistics is being calculated…"));
-    m_referencesModel->appendRow(row);
+    m_referencesModel->setMessage(tr("Please wait, browser statistics is being calculated…"));
+    m_browserConfigs.clear();
 }
 
 void ReportsWidgetBrowserStatistics::showEvent(QShowEvent* event)
@@ -192,46 +195,27 @@ void ReportsWidgetBrowserStatistics::showEvent(QShowEvent* event)
 
 void ReportsWidgetBrowserStatistics::calculateBrowserStatistics()
 {
-    m_referencesModel->clear();
-
     // Perform the statistics check
     const QScopedPointer<BrowserStatistics> browserStatistics(
         AsyncTask::runAndWaitForFuture([this] { return new BrowserStatistics(m_db); }));
 
-    const auto showExpired = m_ui->showExpired->isChecked();
-    const auto showEntriesWithUrlOnly = m_ui->showEntriesWithUrlOnlyCheckBox->isChecked();
-    const auto showOnlyEntriesWithSettings = m_ui->showAllowDenyCheckBox->isChecked();
-
-    // Display the entries
-    m_rowToEntry.clear();
+    // Display all entries, the report options are applied by the proxy model
+    QVector<ReportsModel::Row> rows;
+    rows.reserve(browserStatistics->items().size());
     for (const auto& item : browserStatistics->items()) {
-        // Check if the entry should be displayed
-        if (!showExpired && item->entry->isExpired()) {
-            continue;
-        }
-
-        // Exclude this entry if URL are not set
-        if (showEntriesWithUrlOnly && !item->hasUrls) {
-            continue;
-        }
-
-        // Exclude this entry if it doesn't have any Browser Integration settings
-        if (showOnlyEntriesWithSettings
-            && !item->entry->customData()->contains(BrowserService::KEEPASSXCBROWSER_NAME)) {
-            continue;
-        }
-
-        // Show the entry in the report
-        addStatisticsRow(item->hasUrls, item->hasSettings, item->group, item->entry, item->exclude);
+        ReportsModel::Row row;
+        row.group = item->group;
+        row.entry = item->entry;
+        row.flags = (item->hasUrls ? HasUrls : 0) | (item->hasSettings ? HasSettings : 0);
+        row.excluded = item->exclude;
+        rows.append(row);
     }
 
-    // Set the table header
-    if (m_referencesModel->rowCount() == 0) {
-        m_referencesModel->setHorizontalHeaderLabels(
-            QStringList() << tr("No entries with a URL, or none has browser extension settings saved."));
-    } else {
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("Title") << tr("Path") << tr("URLs")
-                                                                   << tr("Allowed URLs") << tr("Denied URLs"));
+    const bool empty = rows.isEmpty();
+    m_browserConfigs.clear();
+    m_referencesModel->setRows(std::move(rows),
+                               tr("No entries with a URL, or none has browser extension settings saved."));
+    if (!empty) {
         m_ui->browserStatisticsTableView->sortByColumn(0, Qt::AscendingOrder);
     }
 
@@ -244,13 +228,9 @@ void ReportsWidgetBrowserStatistics::emitEntryActivated(const QModelIndex& index
         return;
     }
 
-    auto mappedIndex = m_modelProxy->mapToSource(index);
-    const auto row = m_rowToEntry[mappedIndex.row()];
-    const auto group = row.first;
-    const auto entry = row.second;
-
-    if (group && entry) {
-        emit entryActivated(const_cast<Entry*>(entry));
+    auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+    if (entry) {
+        emit entryActivated(entry);
     }
 }
 
@@ -269,9 +249,10 @@ void ReportsWidgetBrowserStatistics::customMenuRequested(QPoint pos)
         const auto edit = new QAction(icons()->icon("entry-edit"), tr("Edit Entry…"), this);
         menu->addAction(edit);
         connect(edit, &QAction::triggered, edit, [this, selected] {
-            auto row = m_modelProxy->mapToSource(selected[0]).row();
-            auto entry = m_rowToEntry[row].second;
-            emit entryActivated(entry);
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(selected[0]));
+            if (entry) {
+                emit entryActivated(entry);
+            }
         });
     }
 
@@ -300,8 +281,7 @@ void ReportsWidgetBrowserStatistics::customMenuRequested(QPoint pos)
 
     bool isExcluded = false;
     for (auto index : selected) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row].second;
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry && entry->excludeFromReports()) {
             // If at least one entry is excluded switch to inclusion
             isExcluded = true;
@@ -314,8 +294,7 @@ void ReportsWidgetBrowserStatistics::customMenuRequested(QPoint pos)
     menu->addAction(exclude);
     connect(exclude, &QAction::toggled, exclude, [this, selected](bool state) {
         for (auto index : selected) {
-            auto row = m_modelProxy->mapToSource(index).row();
-            auto entry = m_rowToEntry[row].second;
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
             if (entry) {
                 entry->setExcludeFromReports(state);
             }
@@ -336,8 +315,7 @@ QList<Entry*> ReportsWidgetBrowserStatistics::getSelectedEntries()
 {
     QList<Entry*> selectedEntries;
     for (auto index : m_ui->browserStatisticsTableView->selectionModel()->selectedRows()) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row].second;
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry) {
             selectedEntries << entry;
         }
@@ -418,8 +396,7 @@ QList<Entry*> ReportsWidgetBrowserStatistics::getSelectedEntries() const
 {
     QList<Entry*> selectedEntries;
     for (auto index : m_ui->browserStatisticsTableView->selectionModel()->selectedRows()) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row].second;
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry) {
             selectedEntries << entry;
         }
@@ -19,14 +19,15 @@
 #define KEEPASSXC_REPORTSWIDGETBROWSERSTATISTICS_H
 
 #include "gui/entry/EntryModel.h"
+#include <QHash>
 #include <QWidget>
 
 class Database;
 class Entry;
 class Group;
 class PasswordHealth;
-class QSortFilterProxyModel;
-class QStandardItemModel;
+class ReportsFilterProxyModel;
+class ReportsModel;
 
 namespace Ui
 {
@@ -59,17 +60,18 @@ public slots:
     void deletePluginDataFromSelectedEntries();
 
 private:
-    void addStatisticsRow(bool hasUrls, bool hasSettings, Group*, Entry*, bool);
+    QVariant statisticsData(int row, int column, int role) const;
     QList<Entry*> getSelectedEntries() const;
     QMap<QString, QStringList> getBrowserConfigFromEntry(Entry* entry) const;
 
     QScopedPointer<Ui::ReportsWidgetBrowserStatistics> m_ui;
 
     bool m_statisticsCalculated = false;
-    QScopedPointer<QStandardItemModel> m_referencesModel;
-    QScopedPointer<QSortFilterProxyModel> m_modelProxy;
+    QScopedPointer<ReportsModel> m_referencesModel;
+    QScopedPointer<ReportsFilterProxyModel> m_modelProxy;
     QSharedPointer<Database> m_db;
-    QList<QPair<Group*, Entry*>> m_rowToEntry;
+    // Parsed browser settings per model row, filled on first display
+    mutable QHash<int, QMap<QString, QStringList>> m_browserConfigs;
 };
 
 #endif // KEEPASSXC_REPORTSWIDGETBROWSERSTATISTICS_H
@@ -0,0 +1,326 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReportsWidgetDuplicates.h"
+#include "ui_ReportsWidgetDuplicates.h"
+
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "gui/GuiTools.h"
+#include "gui/Icons.h"
+#include "gui/MessageBox.h"
+#include "gui/reports/ReportsModel.h"
+
+#include <QMap>
+#include <QMenu>
+#include <QSet>
+#include <QShortcut>
+#include <QTimer>
+
+ReportsWidgetDuplicates::ReportsWidgetDuplicates(QWidget* parent)
+    : QWidget(parent)
+    , m_ui(new Ui::ReportsWidgetDuplicates())
+    , m_referencesModel(new ReportsModel(this))
+    , m_modelProxy(new ReportsFilterProxyModel(this))
+{
+    m_ui->setupUi(this);
+
+    m_referencesModel->setHeaders(QStringList() << tr("Title") << tr("Path") << tr("Username") << tr("Match"));
+    m_referencesModel->setCellData([this](int row, int column, int role) { return duplicatesData(row, column, role); });
+    m_modelProxy->setSourceModel(m_referencesModel.data());
+    m_modelProxy->setRowFilter([this](const ReportsModel::Row& row) {
+        return (m_ui->showExcluded->isChecked() || !row.excluded)
+               && (m_ui->showExpired->isChecked() || !row.entry->isExpired());
+    });
+    m_ui->duplicatesTableView->setModel(m_modelProxy.data());
+    m_ui->duplicatesTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    m_ui->duplicatesTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    connect(m_ui->duplicatesTableView, SIGNAL(customContextMenuRequested(QPoint)), SLOT(customMenuRequested(QPoint)));
+    connect(m_ui->duplicatesTableView, SIGNAL(doubleClicked(QModelIndex)), SLOT(emitEntryActivated(QModelIndex)));
+    connect(m_ui->duplicatesTableView->selectionModel(),
+            SIGNAL(selectionChanged(QItemSelection, QItemSelection)),
+            this,
+            SLOT(selectionChanged()));
+    connect(m_ui->showExcluded, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
+    connect(m_ui->showExpired, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
+    connect(m_ui->mergeButton, SIGNAL(clicked(bool)), this, SLOT(mergeSelectedDuplicates()));
+
+    m_ui->mergeButton->setEnabled(false);
+
+    new QShortcut(Qt::Key_Delete, this, SLOT(deleteSelectedEntries()));
+}
+
+ReportsWidgetDuplicates::~ReportsWidgetDuplicates() = default;
+
+QVariant ReportsWidgetDuplicates::duplicatesData(int row, int column, int role) const
+{
+    switch (column) {
+    case 0:
+        return m_referencesModel->titleData(row, role);
+    case 1:
+        return m_referencesModel->pathData(row, role);
+    }
+
+    const auto reportRow = m_referencesModel->row(row);
+    switch (column) {
+    case 2:
+        if (role == Qt::DisplayRole) {
+            return reportRow->entry->username();
+        }
+        break;
+    case 3: {
+        // Keep the entries of a set next to each other
+        if (role == ReportsModel::SortRole) {
+            return reportRow->score;
+        }
+        const auto& duplicates = m_duplicates.at(reportRow->score);
+        if (role == Qt::DisplayRole) {
+            switch (duplicates.match) {
+            case DuplicateFinder::Match::Login:
+                return tr("Login: %1").arg(duplicates.description);
+            case DuplicateFinder::Match::Totp:
+                return tr("Same TOTP secret");
+            case DuplicateFinder::Match::Passkey:
+                return tr("Passkey: %1").arg(duplicates.description);
+            }
+        } else if (role == Qt::ToolTipRole) {
+            return tr("%n entries describe the same account", "", duplicates.entries.size());
+        }
+        break;
+    }
+    }
+    return {};
+}
+
+void ReportsWidgetDuplicates::loadSettings(QSharedPointer<Database> db)
+{
+    m_db = std::move(db);
+    m_finder.reset(m_db ? new DuplicateFinder(m_db.data()) : nullptr);
+    m_duplicatesFound = false;
+    m_referencesModel->setMessage(tr("Please wait, duplicate entries are being searched…"));
+    m_duplicates.clear();
+}
+
+void ReportsWidgetDuplicates::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+
+    if (!m_duplicatesFound) {
+        // Perform the search on next event loop to allow widget to appear
+        m_duplicatesFound = true;
+        QTimer::singleShot(0, this, SLOT(findDuplicates()));
+    }
+}
+
+void ReportsWidgetDuplicates::findDuplicates()
+{
+    if (!m_finder) {
+        return;
+    }
+
+    // The finder keeps its index between calls, only changed entries are signed again. It reads the
+    // entries of the database, so it runs on the GUI thread like any other access to them.
+    auto duplicates = m_finder->duplicates();
+
+    QVector<ReportsModel::Row> rows;
+    bool anyExcluded = false;
+    for (int i = 0; i < duplicates.size(); ++i) {
+        for (auto entry : asConst(duplicates.at(i).entries)) {
+            ReportsModel::Row row;
+            row.group = entry->group();
+            row.entry = entry;
+            row.score = i;
+            row.excluded = entry->excludeFromReports();
+            anyExcluded |= row.excluded;
+            rows.append(row);
+        }
+    }
+
+    m_duplicates = std::move(duplicates);
+    const bool empty = rows.isEmpty();
+    m_referencesModel->setRows(std::move(rows), tr("No duplicate entries found."));
+    if (!empty) {
+        m_ui->duplicatesTableView->sortByColumn(3, Qt::AscendingOrder);
+    }
+
+    m_ui->duplicatesTableView->resizeColumnsToContents();
+
+    // Only show the "show excluded" checkbox if there are any excluded entries in the database
+    m_ui->showExcluded->setVisible(anyExcluded);
+}
+
+void ReportsWidgetDuplicates::emitEntryActivated(const QModelIndex& index)
+{
+    if (!index.isValid()) {
+        return;
+    }
+
+    auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+    if (entry) {
+        emit entryActivated(entry);
+    }
+}
+
+void ReportsWidgetDuplicates::customMenuRequested(QPoint pos)
+{
+    auto selected = m_ui->duplicatesTableView->selectionModel()->selectedRows();
+    if (selected.isEmpty()) {
+        return;
+    }
+
+    // Create the context menu
+    const auto menu = new QMenu(this);
+
+    // Create the "edit entry" menu item (only if 1 row is selected)
+    if (selected.size() == 1) {
+        const auto edit = new QAction(icons()->icon("entry-edit"), tr("Edit Entry…"), this);
+        menu->addAction(edit);
+        connect(edit, &QAction::triggered, edit, [this, selected] {
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(selected[0]));
+            if (entry) {
+                emit entryActivated(entry);
+            }
+        });
+    }
+
+    // Create the "merge duplicates" menu item
+    const auto merge = new QAction(icons()->icon("entry-clone"), tr("Merge Duplicates…"), this);
+    menu->addAction(merge);
+    connect(merge, &QAction::triggered, this, &ReportsWidgetDuplicates::mergeSelectedDuplicates);
+
+    // Create the "delete entry" menu item
+    const auto delEntry = new QAction(icons()->icon("entry-delete"), tr("Delete Entry(s)…", "", selected.size()), this);
+    menu->addAction(delEntry);
+    connect(delEntry, &QAction::triggered, this, &ReportsWidgetDuplicates::deleteSelectedEntries);
+
+    // Create the "exclude from reports" menu item
+    const auto exclude = new QAction(icons()->icon("reports-exclude"), tr("Exclude from reports"), this);
+
+    bool isExcluded = false;
+    for (auto index : selected) {
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+        if (entry && entry->excludeFromReports()) {
+            // If at least one entry is excluded switch to inclusion
+            isExcluded = true;
+            break;
+        }
+    }
+    exclude->setCheckable(true);
+    exclude->setChecked(isExcluded);
+
+    menu->addAction(exclude);
+    connect(exclude, &QAction::toggled, exclude, [this, selected](bool state) {
+        for (auto index : selected) {
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+            if (entry) {
+                entry->setExcludeFromReports(state);
+            }
+        }
+        findDuplicates();
+    });
+
+    // Show the context menu
+    menu->popup(m_ui->duplicatesTableView->viewport()->mapToGlobal(pos));
+}
+
+void ReportsWidgetDuplicates::saveSettings()
+{
+    // Nothing to do - the tab is passive
+}
+
+/**
+ * Merge every duplicate set with a selected entry into its most recently modified entry.
+ */
+void ReportsWidgetDuplicates::mergeSelectedDuplicates()
+{
+    QSet<int> selectedSets;
+    for (auto index : m_ui->duplicatesTableView->selectionModel()->selectedRows()) {
+        auto row = m_referencesModel->row(m_modelProxy->mapToSource(index).row());
+        if (row) {
+            selectedSets.insert(row->score);
+        }
+    }
+    if (selectedSets.isEmpty()) {
+        return;
+    }
+
+    const bool permanent = !m_db->metadata()->recycleBinEnabled();
+    const auto message = permanent ? tr("The most recently modified entry of each selected set is kept. The other "
+                                        "entries are added to its history and then permanently deleted, because the "
+                                        "recycle bin is disabled. Do you want to continue?")
+                                   : tr("The most recently modified entry of each selected set is kept. The other "
+                                        "entries are added to its history and then moved to the recycle bin. Do you "
+                                        "want to continue?");
+    auto answer = MessageBox::question(
+        this, tr("Merge Duplicates"), message, MessageBox::Merge | MessageBox::Cancel, MessageBox::Cancel);
+    if (answer != MessageBox::Merge) {
+        return;
+    }
+
+    // Collect the entries through the model, it does not hold on to deleted entries
+    QMap<int, QList<QPointer<Entry>>> sets;
+    for (int i = 0; i < m_referencesModel->rowCount(); ++i) {
+        auto row = m_referencesModel->row(i);
+        if (row && row->entry && selectedSets.contains(row->score)) {
+            sets[row->score].append(row->entry);
+        }
+    }
+
+    for (const auto& set : asConst(sets)) {
+        // An entry can be part of several sets and may already be merged into another one
+        QList<Entry*> entries;
+        for (const auto& entry : set) {
+            if (entry && !entry->isRecycled()) {
+                entries.append(entry);
+            }
+        }
+        DuplicateFinder::merge(entries, permanent);
+    }
+
+    findDuplicates();
+}
+
+void ReportsWidgetDuplicates::deleteSelectedEntries()
+{
+    auto selectedEntries = getSelectedEntries();
+    bool permanent = !m_db->metadata()->recycleBinEnabled();
+
+    if (GuiTools::confirmDeleteEntries(this, selectedEntries, permanent)) {
+        GuiTools::deleteEntriesResolveReferences(this, selectedEntries, permanent);
+    }
+
+    findDuplicates();
+}
+
+QList<Entry*> ReportsWidgetDuplicates::getSelectedEntries()
+{
+    QList<Entry*> selectedEntries;
+    for (auto index : m_ui->duplicatesTableView->selectionModel()->selectedRows()) {
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+        if (entry) {
+            selectedEntries << entry;
+        }
+    }
+
+    return selectedEntries;
+}
+
+void ReportsWidgetDuplicates::selectionChanged()
+{
+    m_ui->mergeButton->setEnabled(!m_ui->duplicatesTableView->selectionModel()->selectedIndexes().isEmpty());
+}
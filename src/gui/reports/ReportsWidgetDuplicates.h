@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_REPORTSWIDGETDUPLICATES_H
+#define KEEPASSXC_REPORTSWIDGETDUPLICATES_H
+
+#include "core/DuplicateFinder.h"
+
+#include <QWidget>
+
+class Database;
+class Entry;
+class ReportsFilterProxyModel;
+class ReportsModel;
+
+namespace Ui
+{
+    class ReportsWidgetDuplicates;
+}
+
+class ReportsWidgetDuplicates : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ReportsWidgetDuplicates(QWidget* parent = nullptr);
+    ~ReportsWidgetDuplicates() override;
+
+    void loadSettings(QSharedPointer<Database> db);
+    void saveSettings();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
+signals:
+    void entryActivated(Entry*);
+
+public slots:
+    void findDuplicates();
+    void emitEntryActivated(const QModelIndex& index);
+    void customMenuRequested(QPoint);
+    void mergeSelectedDuplicates();
+    void deleteSelectedEntries();
+
+private slots:
+    void selectionChanged();
+
+private:
+    QVariant duplicatesData(int row, int column, int role) const;
+    QList<Entry*> getSelectedEntries();
+
+    QScopedPointer<Ui::ReportsWidgetDuplicates> m_ui;
+
+    bool m_duplicatesFound = false;
+    QScopedPointer<ReportsModel> m_referencesModel;
+    QScopedPointer<ReportsFilterProxyModel> m_modelProxy;
+    QSharedPointer<Database> m_db;
+    QScopedPointer<DuplicateFinder> m_finder;
+    // Duplicate sets, row.score of the model is the index of the set of a row
+    QList<DuplicateFinder::Duplicates> m_duplicates;
+};
+
+#endif // KEEPASSXC_REPORTSWIDGETDUPLICATES_H
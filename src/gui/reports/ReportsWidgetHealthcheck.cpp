@@ -24,12 +24,11 @@
 #include "core/PasswordHealth.h"
 #include "gui/GuiTools.h"
 #include "gui/Icons.h"
+#include "gui/reports/ReportsModel.h"
 #include "gui/styles/StateColorPalette.h"
 
 #include <QMenu>
 #include <QShortcut>
-#include <QSortFilterProxyModel>
-#include <QStandardItemModel>
 
 namespace
 {
@@ -75,27 +74,6 @@ namespace
         QList<QSharedPointer<Item>> m_items;
         bool m_anyExcludedEntries = false;
     };
-
-    class ReportSortProxyModel : public QSortFilterProxyModel
-    {
-    public:
-        ReportSortProxyModel(QObject* parent)
-            : QSortFilterProxyModel(parent){};
-        ~ReportSortProxyModel() override = default;
-
-    protected:
-        bool lessThan(const QModelIndex& left, const QModelIndex& right) const override
-        {
-            // Check if the display data is a number, convert and compare if so
-            bool ok = false;
-            int leftInt = sourceModel()->data(left).toString().toInt(&ok);
-            if (ok) {
-                return leftInt < sourceModel()->data(right).toString().toInt();
-            }
-            // Otherwise use default sorting
-            return QSortFilterProxyModel::lessThan(left, right);
-        }
-    };
 } // namespace
 
 Health::Health(QSharedPointer<Database> db)
@@ -139,105 +117,109 @@ Health::Health(QSharedPointer<Database> db)
 ReportsWidgetHealthcheck::ReportsWidgetHealthcheck(QWidget* parent)
     : QWidget(parent)
     , m_ui(new Ui::ReportsWidgetHealthcheck())
-    , m_referencesModel(new QStandardItemModel(this))
-    , m_modelProxy(new ReportSortProxyModel(this))
+    , m_referencesModel(new ReportsModel(this))
+    , m_modelProxy(new ReportsFilterProxyModel(this))
 {
     m_ui->setupUi(this);
 
+    m_referencesModel->setHeaders(QStringList() << tr("") << tr("Title") << tr("Path") << tr("Score") << tr("Reason"));
+    m_referencesModel->setCellData([this](int row, int column, int role) { return healthData(row, column, role); });
     m_modelProxy->setSourceModel(m_referencesModel.data());
-    m_modelProxy->setSortLocaleAware(true);
+    m_modelProxy->setRowFilter([this](const ReportsModel::Row& row) {
+        return (m_ui->showExcluded->isChecked() || !row.excluded)
+               && (m_ui->showExpired->isChecked() || !row.entry->isExpired());
+    });
     m_ui->healthcheckTableView->setModel(m_modelProxy.data());
     m_ui->healthcheckTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
     m_ui->healthcheckTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
 
     connect(m_ui->healthcheckTableView, SIGNAL(customContextMenuRequested(QPoint)), SLOT(customMenuRequested(QPoint)));
     connect(m_ui->healthcheckTableView, SIGNAL(doubleClicked(QModelIndex)), SLOT(emitEntryActivated(QModelIndex)));
-    connect(m_ui->showExcluded, SIGNAL(stateChanged(int)), this, SLOT(calculateHealth()));
-    connect(m_ui->showExpired, SIGNAL(stateChanged(int)), this, SLOT(calculateHealth()));
+    connect(m_ui->showExcluded, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
+    connect(m_ui->showExpired, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
 
     new QShortcut(Qt::Key_Delete, this, SLOT(deleteSelectedEntries()));
 }
 
 ReportsWidgetHealthcheck::~ReportsWidgetHealthcheck() = default;
 
-void ReportsWidgetHealthcheck::addHealthRow(QSharedPointer<PasswordHealth> health,
-                                            Group* group,
-                                            Entry* entry,
-                                            bool excluded)
+QVariant ReportsWidgetHealthcheck::healthData(int row, int column, int role) const
 {
-    QString tip;
-    QString iconName = "lock-question";
-    QColor qualityColor;
-    StateColorPalette statePalette;
-    const auto quality = health->quality();
-    switch (quality) {
-    case PasswordHealth::Quality::Bad:
-        tip = tr("Bad — password must be changed");
-        iconName = "lock-open-alert";
-        qualityColor = statePalette.color(StateColorPalette::HealthCritical);
-        break;
-    case PasswordHealth::Quality::Poor:
-        tip = tr("Poor — password should be changed");
-        iconName = "lock-open-alert";
-        qualityColor = statePalette.color(StateColorPalette::HealthBad);
-        break;
+    const auto& health = m_rowHealth.at(row);
+    switch (column) {
+    case 0: {
+        if (role == ReportsModel::SortRole) {
+            return health->score();
+        }
+        if (role != Qt::DecorationRole && role != Qt::ForegroundRole && role != Qt::ToolTipRole) {
+            break;
+        }
 
-    case PasswordHealth::Quality::Weak:
-        tip = tr("Weak — consider changing the password");
-        iconName = "lock-open";
-        qualityColor = statePalette.color(StateColorPalette::HealthWeak);
-        break;
+        QString tip;
+        QString iconName = "lock-question";
+        QColor qualityColor;
+        StateColorPalette statePalette;
+        switch (health->quality()) {
+        case PasswordHealth::Quality::Bad:
+            tip = tr("Bad — password must be changed");
+            iconName = "lock-open-alert";
+            qualityColor = statePalette.color(StateColorPalette::HealthCritical);
+            break;
+        case PasswordHealth::Quality::Poor:
+            tip = tr("Poor — password should be changed");
+            iconName = "lock-open-alert";
+            qualityColor = statePalette.color(StateColorPalette::HealthBad);
+            break;
 
-    case PasswordHealth::Quality::Good:
-    case PasswordHealth::Quality::Excellent:
-        iconName = "lock";
-        qualityColor = statePalette.color(StateColorPalette::HealthOk);
-        break;
-    }
+        case PasswordHealth::Quality::Weak:
+            tip = tr("Weak — consider changing the password");
+            iconName = "lock-open";
+            qualityColor = statePalette.color(StateColorPalette::HealthWeak);
+            break;
 
-    auto title = entry->title();
-    if (excluded) {
-        title.append(tr(" (Excluded)"));
-    }
-    if (entry->isExpired()) {
-        title.append(tr(" (Expired)"));
-    }
+        case PasswordHealth::Quality::Good:
+        case PasswordHealth::Quality::Excellent:
+            iconName = "lock";
+            qualityColor = statePalette.color(StateColorPalette::HealthOk);
+            break;
+        }
 
-    auto row = QList<QStandardItem*>();
-    row << new QStandardItem(Icons::instance()->icon(iconName, true, qualityColor), "");
-    row << new QStandardItem(Icons::entryIconPixmap(entry), title);
-    row << new QStandardItem(Icons::groupIconPixmap(group), group->hierarchy().join("/"));
-    row << new QStandardItem(QString::number(health->score()));
-    row << new QStandardItem(health->scoreReason());
-
-    // Set background color of first column according to password quality.
-    // Set the same as foreground color so the description is usually
-    // invisible, it's just for screen readers etc.
-    QBrush brush(qualityColor);
-    row[0]->setForeground(brush);
-
-    // Set tooltips
-    row[0]->setToolTip(tip);
-    if (excluded) {
-        row[1]->setToolTip(tr("This entry is being excluded from reports"));
+        if (role == Qt::DecorationRole) {
+            return Icons::instance()->icon(iconName, true, qualityColor);
+        } else if (role == Qt::ForegroundRole) {
+            // Same as the icon color so the (empty) description is invisible
+            return QBrush(qualityColor);
+        }
+        return tip;
     }
-    row[4]->setToolTip(health->scoreDetails());
-
-    // Store entry pointer per table row (used in double click handler)
-    m_referencesModel->appendRow(row);
-    m_rowToEntry.append({group, entry});
+    case 1:
+        return m_referencesModel->titleData(row, role);
+    case 2:
+        return m_referencesModel->pathData(row, role);
+    case 3:
+        if (role == Qt::DisplayRole) {
+            return QString::number(health->score());
+        } else if (role == ReportsModel::SortRole) {
+            return health->score();
+        }
+        break;
+    case 4:
+        if (role == Qt::DisplayRole) {
+            return health->scoreReason();
+        } else if (role == Qt::ToolTipRole) {
+            return health->scoreDetails();
+        }
+        break;
+    }
+    return {};
 }
 
 void ReportsWidgetHealthcheck::loadSettings(QSharedPointer<Database> db)
 {
     m_db = std::move(db);
     m_healthCalculated = false;
-    m_referencesModel->clear();
-    m_rowToEntry.clear();
-
-    auto row = QList<QStandardItem*>();
-    row << new QStandardItem(tr("Please wait, health data is being calculated…"));
-    m_referencesModel->appendRow(row);
+    m_referencesModel->setMessage(tr("Please wait, health data is being calculated…"));
+    m_rowHealth.clear();
 }
 
 void ReportsWidgetHealthcheck::showEvent(QShowEvent* event)
@@ -253,30 +235,27 @@ void ReportsWidgetHealthcheck::showEvent(QShowEvent* event)
 
 void ReportsWidgetHealthcheck::calculateHealth()
 {
-    m_referencesModel->clear();
-
     // Perform the health check
     const QScopedPointer<Health> health(AsyncTask::runAndWaitForFuture([this] { return new Health(m_db); }));
 
-    // Display the entries
-    m_rowToEntry.clear();
+    // Display all entries, the report options are applied by the proxy model
+    QVector<ReportsModel::Row> rows;
+    QVector<QSharedPointer<PasswordHealth>> rowHealth;
+    rows.reserve(health->items().size());
+    rowHealth.reserve(health->items().size());
     for (const auto& item : health->items()) {
-        // Check if the entry should be displayed
-        if ((!m_ui->showExcluded->isChecked() && item->exclude)
-            || (!m_ui->showExpired->isChecked() && item->entry->isExpired())) {
-            continue;
-        }
-
-        // Show the entry in the report
-        addHealthRow(item->health, item->group, item->entry, item->exclude);
+        ReportsModel::Row row;
+        row.group = item->group;
+        row.entry = item->entry;
+        row.score = item->health->score();
+        row.excluded = item->exclude;
+        rows.append(row);
+        rowHealth.append(item->health);
     }
 
-    // Set the table header
-    if (m_referencesModel->rowCount() == 0) {
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("Congratulations, everything is healthy!"));
-    } else {
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("") << tr("Title") << tr("Path") << tr("Score")
-                                                                   << tr("Reason"));
+    m_rowHealth = std::move(rowHealth);
+    m_referencesModel->setRows(std::move(rows), tr("Congratulations, everything is healthy!"));
+    if (!m_rowHealth.isEmpty()) {
         m_ui->healthcheckTableView->sortByColumn(0, Qt::AscendingOrder);
     }
 
@@ -293,12 +272,9 @@ void ReportsWidgetHealthcheck::emitEntryActivated(const QModelIndex& index)
         return;
     }
 
-    auto mappedIndex = m_modelProxy->mapToSource(index);
-    const auto row = m_rowToEntry[mappedIndex.row()];
-    const auto group = row.first;
-    const auto entry = row.second;
-    if (group && entry) {
-        emit entryActivated(const_cast<Entry*>(entry));
+    auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+    if (entry) {
+        emit entryActivated(entry);
     }
 }
 
@@ -317,9 +293,10 @@ void ReportsWidgetHealthcheck::customMenuRequested(QPoint pos)
         const auto edit = new QAction(icons()->icon("entry-edit"), tr("Edit Entry…"), this);
         menu->addAction(edit);
         connect(edit, &QAction::triggered, edit, [this, selected] {
-            auto row = m_modelProxy->mapToSource(selected[0]).row();
-            auto entry = m_rowToEntry[row].second;
-            emit entryActivated(entry);
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(selected[0]));
+            if (entry) {
+                emit entryActivated(entry);
+            }
         });
     }
 
@@ -338,8 +315,7 @@ void ReportsWidgetHealthcheck::customMenuRequested(QPoint pos)
 
     bool isExcluded = false;
     for (auto index : selected) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row].second;
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry && entry->excludeFromReports()) {
             // If at least one entry is excluded switch to inclusion
             isExcluded = true;
@@ -352,8 +328,7 @@ void ReportsWidgetHealthcheck::customMenuRequested(QPoint pos)
     menu->addAction(exclude);
     connect(exclude, &QAction::toggled, exclude, [this, selected](bool state) {
         for (auto index : selected) {
-            auto row = m_modelProxy->mapToSource(index).row();
-            auto entry = m_rowToEntry[row].second;
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
             if (entry) {
                 entry->setExcludeFromReports(state);
             }
@@ -374,8 +349,7 @@ QList<Entry*> ReportsWidgetHealthcheck::getSelectedEntries()
 {
     QList<Entry*> selectedEntries;
     for (auto index : m_ui->healthcheckTableView->selectionModel()->selectedRows()) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row].second;
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry) {
             selectedEntries << entry;
         }
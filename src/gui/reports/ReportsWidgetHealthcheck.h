@@ -25,8 +25,8 @@ class Database;
 class Entry;
 class Group;
 class PasswordHealth;
-class QSortFilterProxyModel;
-class QStandardItemModel;
+class ReportsFilterProxyModel;
+class ReportsModel;
 
 namespace Ui
 {
@@ -58,15 +58,15 @@ public slots:
     void deleteSelectedEntries();
 
 private:
-    void addHealthRow(QSharedPointer<PasswordHealth>, Group*, Entry*, bool excluded);
+    QVariant healthData(int row, int column, int role) const;
 
     QScopedPointer<Ui::ReportsWidgetHealthcheck> m_ui;
 
     bool m_healthCalculated = false;
-    QScopedPointer<QStandardItemModel> m_referencesModel;
-    QScopedPointer<QSortFilterProxyModel> m_modelProxy;
+    QScopedPointer<ReportsModel> m_referencesModel;
+    QScopedPointer<ReportsFilterProxyModel> m_modelProxy;
     QSharedPointer<Database> m_db;
-    QList<QPair<Group*, Entry*>> m_rowToEntry;
+    QVector<QSharedPointer<PasswordHealth>> m_rowHealth;
 };
 
 #endif // KEEPASSXC_REPORTSWIDGETHEALTHCHECK_H
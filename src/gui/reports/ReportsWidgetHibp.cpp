@@ -23,54 +23,33 @@
 #include "core/Metadata.h"
 #include "gui/GuiTools.h"
 #include "gui/Icons.h"
+#include "gui/reports/ReportsModel.h"
 
 #include <QMenu>
 #include <QShortcut>
-#include <QSortFilterProxyModel>
-#include <QStandardItemModel>
-
-#include <algorithm>
-
-namespace
-{
-    class ReportSortProxyModel : public QSortFilterProxyModel
-    {
-    public:
-        ReportSortProxyModel(QObject* parent)
-            : QSortFilterProxyModel(parent){};
-        ~ReportSortProxyModel() override = default;
-
-    protected:
-        bool lessThan(const QModelIndex& left, const QModelIndex& right) const override
-        {
-            // Sort count column by user data
-            if (left.column() == 2) {
-                return sourceModel()->data(left, Qt::UserRole).toInt()
-                       < sourceModel()->data(right, Qt::UserRole).toInt();
-            }
-            // Otherwise use default sorting
-            return QSortFilterProxyModel::lessThan(left, right);
-        }
-    };
-} // namespace
 
 ReportsWidgetHibp::ReportsWidgetHibp(QWidget* parent)
     : QWidget(parent)
     , m_ui(new Ui::ReportsWidgetHibp())
-    , m_referencesModel(new QStandardItemModel(this))
-    , m_modelProxy(new ReportSortProxyModel(this))
+    , m_referencesModel(new ReportsModel(this))
+    , m_modelProxy(new ReportsFilterProxyModel(this))
 {
     m_ui->setupUi(this);
 
+    m_referencesModel->setHeaders(QStringList() << tr("Title") << tr("Path") << tr("Password exposed…"));
+    m_referencesModel->setCellData([this](int row, int column, int role) { return hibpData(row, column, role); });
     m_modelProxy->setSourceModel(m_referencesModel.data());
-    m_modelProxy->setSortLocaleAware(true);
+    // Hide entries marked as "known bad" unless explicitly requested
+    m_modelProxy->setRowFilter(
+        [this](const ReportsModel::Row& row) { return m_ui->showKnownBadCheckBox->isChecked() || !row.excluded; });
     m_ui->hibpTableView->setModel(m_modelProxy.data());
     m_ui->hibpTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
     m_ui->hibpTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
 
     connect(m_ui->hibpTableView, SIGNAL(doubleClicked(QModelIndex)), SLOT(emitEntryActivated(QModelIndex)));
     connect(m_ui->hibpTableView, SIGNAL(customContextMenuRequested(QPoint)), SLOT(customMenuRequested(QPoint)));
-    connect(m_ui->showKnownBadCheckBox, SIGNAL(stateChanged(int)), this, SLOT(makeHibpTable()));
+    connect(
+        m_ui->showKnownBadCheckBox, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
 #ifdef WITH_XC_NETWORKING
     connect(&m_downloader, SIGNAL(hibpResult(QString, int)), SLOT(addHibpResult(QString, int)));
     connect(&m_downloader, SIGNAL(fetchFailed(QString)), SLOT(fetchFailed(QString)));
@@ -87,10 +66,9 @@ void ReportsWidgetHibp::loadSettings(QSharedPointer<Database> db)
 {
     // Re-initialize
     m_db = std::move(db);
-    m_referencesModel->clear();
+    m_referencesModel->setRows({});
     m_pwndPasswords.clear();
     m_error.clear();
-    m_rowToEntry.clear();
     m_editedEntry = nullptr;
 #ifdef WITH_XC_NETWORKING
     m_ui->stackedWidget->setCurrentIndex(0);
@@ -108,90 +86,42 @@ void ReportsWidgetHibp::loadSettings(QSharedPointer<Database> db)
  */
 void ReportsWidgetHibp::makeHibpTable()
 {
-    // Reset the table
-    m_referencesModel->clear();
-    m_rowToEntry.clear();
-
     // If there were no findings, display a motivational message
     if (m_pwndPasswords.isEmpty() && m_error.isEmpty()) {
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("Congratulations, no exposed passwords!"));
+        m_referencesModel->setMessage(tr("Congratulations, no exposed passwords!"));
         m_ui->stackedWidget->setCurrentIndex(1);
         return;
     }
 
-    // Standard header labels for found issues
-    m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("Title") << tr("Path") << tr("Password exposed…"));
-
-    // Search database for passwords that we've found so far
-    QList<QPair<Entry*, int>> items;
+    // Search database for passwords that we've found so far, entries
+    // marked as "known bad" are hidden by the proxy model
+    QVector<ReportsModel::Row> rows;
+    bool anyExcluded = false;
     for (auto entry : m_db->rootGroup()->entriesRecursive()) {
         if (!entry->isRecycled()) {
             const auto found = m_pwndPasswords.find(entry->password());
             if (found != m_pwndPasswords.end()) {
-                items.append({entry, found.value()});
+                ReportsModel::Row row;
+                row.group = entry->group();
+                row.entry = entry;
+                row.score = found.value();
+                row.excluded = entry->excludeFromReports();
+                anyExcluded |= row.excluded;
+                rows.append(row);
             }
         }
     }
 
-    // Sort descending by the number the password has been exposed
-    std::sort(items.begin(), items.end(), [](QPair<Entry*, int>& lhs, QPair<Entry*, int>& rhs) {
-        return lhs.second > rhs.second;
-    });
-
-    // Display entries that are marked as "known bad"?
-    const auto showExcluded = m_ui->showKnownBadCheckBox->isChecked();
-
-    // The colors for table cells
-    const auto red = QBrush("red");
-
-    // Build the table
-    bool anyExcluded = false;
-    for (const auto& item : items) {
-        const auto entry = item.first;
-        const auto group = entry->group();
-        const auto count = item.second;
-        auto title = entry->title();
-
-        // Hide entry if excluded unless explicitly requested
-        if (entry->excludeFromReports()) {
-            anyExcluded = true;
-            if (!showExcluded) {
-                continue;
-            }
-
-            title.append(tr(" (Excluded)"));
-        }
-
-        auto row = QList<QStandardItem*>();
-        row << new QStandardItem(Icons::entryIconPixmap(entry), title)
-            << new QStandardItem(Icons::groupIconPixmap(group), group->hierarchy().join("/"))
-            << new QStandardItem(countToText(count));
-
-        if (entry->excludeFromReports()) {
-            row[1]->setToolTip(tr("This entry is being excluded from reports"));
-        }
-
-        row[2]->setForeground(red);
-        row[2]->setData(count, Qt::UserRole);
-        m_referencesModel->appendRow(row);
-
-        // Store entry pointer per table row (used in double click handler)
-        m_rowToEntry.append(entry);
-    }
-
-    // If there was an error, append the error message to the table
+    // Build the table, if there was an error append the error message to it
+    m_referencesModel->setRows(std::move(rows));
     if (!m_error.isEmpty()) {
-        auto row = QList<QStandardItem*>();
-        row << new QStandardItem(m_error);
-        m_referencesModel->appendRow(row);
-        row[0]->setForeground(QBrush(QColor("red")));
+        m_referencesModel->setNote(m_error);
     }
 
     // If we're done and everything is good, display a motivational message
 #ifdef WITH_XC_NETWORKING
     if (m_downloader.passwordsRemaining() == 0 && m_pwndPasswords.isEmpty() && m_error.isEmpty()) {
-        m_referencesModel->clear();
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("Congratulations, no exposed passwords!"));
+        m_referencesModel->setMessage(tr("Congratulations, no exposed passwords!"));
     }
 #endif
 
@@ -209,6 +139,29 @@ void ReportsWidgetHibp::makeHibpTable()
     m_ui->stackedWidget->setCurrentIndex(1);
 }
 
+QVariant ReportsWidgetHibp::hibpData(int row, int column, int role) const
+{
+    switch (column) {
+    case 0:
+        return m_referencesModel->titleData(row, role);
+    case 1:
+        return m_referencesModel->pathData(row, role);
+    case 2: {
+        // Sort by the number the password has been exposed
+        const auto count = m_referencesModel->row(row)->score;
+        if (role == Qt::DisplayRole) {
+            return countToText(count);
+        } else if (role == ReportsModel::SortRole) {
+            return count;
+        } else if (role == Qt::ForegroundRole) {
+            return QBrush("red");
+        }
+        break;
+    }
+    }
+    return {};
+}
+
 /*
  * Invoked when the downloader has finished checking one password.
  */
@@ -309,14 +262,13 @@ void ReportsWidgetHibp::emitEntryActivated(const QModelIndex& index)
     }
 
     // Find which database entry was double-clicked
-    auto mappedIndex = m_modelProxy->mapToSource(index);
-    const auto entry = m_rowToEntry[mappedIndex.row()];
+    const auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
     if (entry) {
         // Found it, invoke entry editor
         m_editedEntry = entry;
         m_editedPassword = entry->password();
         m_editedExcluded = entry->excludeFromReports();
-        emit entryActivated(const_cast<Entry*>(entry));
+        emit entryActivated(entry);
     }
 }
 
@@ -368,9 +320,10 @@ void ReportsWidgetHibp::customMenuRequested(QPoint pos)
         const auto edit = new QAction(icons()->icon("entry-edit"), tr("Edit Entry…"), this);
         menu->addAction(edit);
         connect(edit, &QAction::triggered, edit, [this, selected] {
-            auto row = m_modelProxy->mapToSource(selected[0]).row();
-            auto entry = m_rowToEntry[row];
-            emit entryActivated(entry);
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(selected[0]));
+            if (entry) {
+                emit entryActivated(entry);
+            }
         });
     }
 
@@ -389,8 +342,7 @@ void ReportsWidgetHibp::customMenuRequested(QPoint pos)
 
     bool isExcluded = false;
     for (auto index : selected) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row];
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry && entry->excludeFromReports()) {
             // If at least one entry is excluded switch to inclusion
             isExcluded = true;
@@ -403,8 +355,7 @@ void ReportsWidgetHibp::customMenuRequested(QPoint pos)
     menu->addAction(exclude);
     connect(exclude, &QAction::toggled, exclude, [this, selected](bool state) {
         for (auto index : selected) {
-            auto row = m_modelProxy->mapToSource(index).row();
-            auto entry = m_rowToEntry[row];
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
             if (entry) {
                 entry->setExcludeFromReports(state);
             }
@@ -420,8 +371,7 @@ QList<Entry*> ReportsWidgetHibp::getSelectedEntries()
 {
     QList<Entry*> selectedEntries;
     for (auto index : m_ui->hibpTableView->selectionModel()->selectedRows()) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row];
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry) {
             selectedEntries << entry;
         }
@@ -30,8 +30,8 @@
 class Database;
 class Entry;
 class Group;
-class QSortFilterProxyModel;
-class QStandardItemModel;
+class ReportsFilterProxyModel;
+class ReportsModel;
 
 namespace Ui
 {
@@ -64,16 +64,16 @@ public slots:
 
 private:
     void startValidation();
+    QVariant hibpData(int row, int column, int role) const;
     static QString countToText(int count);
 
     QScopedPointer<Ui::ReportsWidgetHibp> m_ui;
-    QScopedPointer<QStandardItemModel> m_referencesModel;
-    QScopedPointer<QSortFilterProxyModel> m_modelProxy;
+    QScopedPointer<ReportsModel> m_referencesModel;
+    QScopedPointer<ReportsFilterProxyModel> m_modelProxy;
     QSharedPointer<Database> m_db;
 
     QMap<QString, int> m_pwndPasswords; // Passwords we found to have been pwned (value is pwn count)
     QString m_error; // Error message if download failed, else empty
-    QList<Entry*> m_rowToEntry; // List index is table row
     QPointer<Entry> m_editedEntry; // The entry we're currently editing
     QString m_editedPassword; // The old password of the entry we're editing
     bool m_editedExcluded; // The old "known bad" flag of the entry we're editing
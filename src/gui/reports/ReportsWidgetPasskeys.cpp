@@ -29,12 +29,10 @@
 #include "gui/MessageBox.h"
 #include "gui/passkeys/PasskeyExporter.h"
 #include "gui/passkeys/PasskeyImporter.h"
-#include "gui/styles/StateColorPalette.h"
+#include "gui/reports/ReportsModel.h"
 
 #include <QMenu>
 #include <QShortcut>
-#include <QSortFilterProxyModel>
-#include <QStandardItemModel>
 
 namespace
 {
@@ -89,13 +87,17 @@ PasskeyList::PasskeyList(const QSharedPointer<Database>& db)
 ReportsWidgetPasskeys::ReportsWidgetPasskeys(QWidget* parent)
     : QWidget(parent)
     , m_ui(new Ui::ReportsWidgetPasskeys())
-    , m_referencesModel(new QStandardItemModel(this))
-    , m_modelProxy(new QSortFilterProxyModel(this))
+    , m_referencesModel(new ReportsModel(this))
+    , m_modelProxy(new ReportsFilterProxyModel(this))
 {
     m_ui->setupUi(this);
 
+    m_referencesModel->setHeaders(QStringList() << tr("Title") << tr("Path") << tr("Username") << tr("Relying Party")
+                                                << tr("URLs"));
+    m_referencesModel->setCellData([this](int row, int column, int role) { return passkeyData(row, column, role); });
     m_modelProxy->setSourceModel(m_referencesModel.data());
-    m_modelProxy->setSortLocaleAware(true);
+    m_modelProxy->setRowFilter(
+        [this](const ReportsModel::Row& row) { return m_ui->showExpired->isChecked() || !row.entry->isExpired(); });
     m_ui->passkeysTableView->setModel(m_modelProxy.data());
     m_ui->passkeysTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
     m_ui->passkeysTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
@@ -106,7 +108,7 @@ ReportsWidgetPasskeys::ReportsWidgetPasskeys(QWidget* parent)
             SIGNAL(selectionChanged(QItemSelection, QItemSelection)),
             this,
             SLOT(selectionChanged()));
-    connect(m_ui->showExpired, SIGNAL(stateChanged(int)), this, SLOT(updateEntries()));
+    connect(m_ui->showExpired, &QCheckBox::stateChanged, m_modelProxy.data(), &ReportsFilterProxyModel::refilter);
     connect(m_ui->exportButton, SIGNAL(clicked(bool)), this, SLOT(exportPasskey()));
     connect(m_ui->importButton, SIGNAL(clicked(bool)), this, SLOT(importPasskey()));
 
@@ -119,43 +121,43 @@ ReportsWidgetPasskeys::~ReportsWidgetPasskeys()
 {
 }
 
-void ReportsWidgetPasskeys::addPasskeyRow(Group* group, Entry* entry)
+QVariant ReportsWidgetPasskeys::passkeyData(int row, int column, int role) const
 {
-    StateColorPalette statePalette;
-
-    auto urlList = entry->getAllUrls();
-    auto urlToolTip = tr("List of entry URLs");
-
-    auto title = entry->title();
-    if (entry->isExpired()) {
-        title.append(tr(" (Expired)"));
+    switch (column) {
+    case 0:
+        return m_referencesModel->titleData(row, role);
+    case 1:
+        return m_referencesModel->pathData(row, role);
     }
 
-    auto row = QList<QStandardItem*>();
-    row << new QStandardItem(Icons::entryIconPixmap(entry), title);
-    row << new QStandardItem(Icons::groupIconPixmap(group), group->hierarchy().join("/"));
-    row << new QStandardItem(passkeyUtils()->getUsernameFromEntry(entry));
-    row << new QStandardItem(entry->attributes()->value(EntryAttributes::KPEX_PASSKEY_RELYING_PARTY));
-    row << new QStandardItem(urlList.join('\n'));
-
-    // Set tooltips
-    row[2]->setToolTip(urlToolTip);
-
-    // Store entry pointer per table row (used in double click handler)
-    m_referencesModel->appendRow(row);
-    m_rowToEntry.append({group, entry});
+    const auto entry = m_referencesModel->row(row)->entry;
+    switch (column) {
+    case 2:
+        if (role == Qt::DisplayRole) {
+            return passkeyUtils()->getUsernameFromEntry(entry);
+        } else if (role == Qt::ToolTipRole) {
+            return tr("List of entry URLs");
+        }
+        break;
+    case 3:
+        if (role == Qt::DisplayRole) {
+            return entry->attributes()->value(EntryAttributes::KPEX_PASSKEY_RELYING_PARTY);
+        }
+        break;
+    case 4:
+        if (role == Qt::DisplayRole) {
+            return entry->getAllUrls().join('\n');
+        }
+        break;
+    }
+    return {};
 }
 
 void ReportsWidgetPasskeys::loadSettings(QSharedPointer<Database> db)
 {
     m_db = std::move(db);
     m_entriesUpdated = false;
-    m_referencesModel->clear();
-    m_rowToEntry.clear();
-
-    auto row = QList<QStandardItem*>();
-    row << new QStandardItem(tr("Please wait, list of entries with passkeys is being updated…"));
-    m_referencesModel->appendRow(row);
+    m_referencesModel->setMessage(tr("Please wait, list of entries with passkeys is being updated…"));
 }
 
 void ReportsWidgetPasskeys::showEvent(QShowEvent* event)
@@ -171,29 +173,23 @@ void ReportsWidgetPasskeys::showEvent(QShowEvent* event)
 
 void ReportsWidgetPasskeys::updateEntries()
 {
-    m_referencesModel->clear();
-
     // Perform the statistics check
     const QScopedPointer<PasskeyList> browserStatistics(
         AsyncTask::runAndWaitForFuture([this] { return new PasskeyList(m_db); }));
 
-    // Display the entries
-    m_rowToEntry.clear();
+    // Display all entries, expired ones are hidden by the proxy model if not requested
+    QVector<ReportsModel::Row> rows;
+    rows.reserve(browserStatistics->items().size());
     for (const auto& item : browserStatistics->items()) {
-        // Exclude expired entries from report if not requested
-        if (!m_ui->showExpired->isChecked() && item->entry->isExpired()) {
-            continue;
-        }
-
-        addPasskeyRow(item->group, item->entry);
+        ReportsModel::Row row;
+        row.group = item->group;
+        row.entry = item->entry;
+        rows.append(row);
     }
 
-    // Set the table header
-    if (m_referencesModel->rowCount() == 0) {
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("No entries with passkeys."));
-    } else {
-        m_referencesModel->setHorizontalHeaderLabels(QStringList() << tr("Title") << tr("Path") << tr("Username")
-                                                                   << tr("Relying Party") << tr("URLs"));
+    const bool empty = rows.isEmpty();
+    m_referencesModel->setRows(std::move(rows), tr("No entries with passkeys."));
+    if (!empty) {
         m_ui->passkeysTableView->sortByColumn(0, Qt::AscendingOrder);
     }
 
@@ -206,12 +202,8 @@ void ReportsWidgetPasskeys::emitEntryActivated(const QModelIndex& index)
         return;
     }
 
-    auto mappedIndex = m_modelProxy->mapToSource(index);
-    const auto row = m_rowToEntry[mappedIndex.row()];
-    const auto group = row.first;
-    const auto entry = row.second;
-
-    if (group && entry) {
+    auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
+    if (entry) {
         emit entryActivated(entry);
     }
 }
@@ -231,9 +223,10 @@ void ReportsWidgetPasskeys::customMenuRequested(QPoint pos)
         const auto edit = new QAction(icons()->icon("entry-edit"), tr("Edit Entry…"), this);
         menu->addAction(edit);
         connect(edit, &QAction::triggered, edit, [this, selected] {
-            auto row = m_modelProxy->mapToSource(selected[0]).row();
-            auto entry = m_rowToEntry[row].second;
-            emit entryActivated(entry);
+            auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(selected[0]));
+            if (entry) {
+                emit entryActivated(entry);
+            }
         });
     }
 
@@ -267,8 +260,7 @@ QList<Entry*> ReportsWidgetPasskeys::getSelectedEntries()
 {
     QList<Entry*> selectedEntries;
     for (auto index : m_ui->passkeysTableView->selectionModel()->selectedRows()) {
-        auto row = m_modelProxy->mapToSource(index).row();
-        auto entry = m_rowToEntry[row].second;
+        auto entry = m_referencesModel->entry(m_modelProxy->mapToSource(index));
         if (entry) {
             selectedEntries << entry;
         }
@@ -25,8 +25,8 @@ class Database;
 class Entry;
 class Group;
 class PasswordHealth;
-class QSortFilterProxyModel;
-class QStandardItemModel;
+class ReportsFilterProxyModel;
+class ReportsModel;
 
 namespace Ui
 {
@@ -61,16 +61,15 @@ private slots:
     void exportPasskey();
 
 private:
-    void addPasskeyRow(Group*, Entry*);
+    QVariant passkeyData(int row, int column, int role) const;
     QList<Entry*> getSelectedEntries();
 
     QScopedPointer<Ui::ReportsWidgetPasskeys> m_ui;
 
     bool m_entriesUpdated = false;
-    QScopedPointer<QStandardItemModel> m_referencesModel;
-    QScopedPointer<QSortFilterProxyModel> m_modelProxy;
+    QScopedPointer<ReportsModel> m_referencesModel;
+    QScopedPointer<ReportsFilterProxyModel> m_modelProxy;
     QSharedPointer<Database> m_db;
-    QList<QPair<Group*, Entry*>> m_rowToEntry;
 };
 
 #endif // KEEPASSXC_REPORTSWIDGETPASSKEYS_H
@@ -17,6 +17,12 @@
 
 #include "SymmetricCipherStream.h"
 
+namespace
+{
+    // CBC ciphertext is read in chunks of this size and decrypted in parallel segments
+    const int ParallelDecryptChunkSize = 4 * 1024 * 1024;
+} // namespace
+
 SymmetricCipherStream::SymmetricCipherStream(QIODevice* baseDevice)
     : LayeredStream(baseDevice)
     , m_cipher(new SymmetricCipher())
@@ -26,6 +32,7 @@ SymmetricCipherStream::SymmetricCipherStream(QIODevice* baseDevice)
     , m_isInitialized(false)
     , m_dataWritten(false)
     , m_streamCipher(false)
+    , m_parallelDecrypt(false)
 {
 }
 
@@ -45,6 +52,14 @@ bool SymmetricCipherStream::init(SymmetricCipher::Mode mode,
         return false;
     }
     m_streamCipher = m_cipher->blockSize(m_cipher->mode()) == 1;
+    m_parallelDecrypt = direction == SymmetricCipher::Decrypt
+                        && (mode == SymmetricCipher::Aes128_CBC || mode == SymmetricCipher::Aes256_CBC
+                            || mode == SymmetricCipher::Twofish_CBC);
+    if (m_parallelDecrypt) {
+        m_key = key;
+        m_iv = iv;
+        m_chunkIv = iv;
+    }
     return true;
 }
 
@@ -55,6 +70,8 @@ void SymmetricCipherStream::resetInternalState()
     m_bufferFilling = false;
     m_error = false;
     m_dataWritten = false;
+    m_chunkIv = m_iv;
+    m_pendingCiphertext.clear();
     m_cipher->reset();
 }
 
@@ -123,6 +140,10 @@ qint64 SymmetricCipherStream::readData(char* data, qint64 maxSize)
 
 bool SymmetricCipherStream::readBlock()
 {
+    if (m_parallelDecrypt) {
+        return readChunk();
+    }
+
     QByteArray newData;
 
     if (m_bufferFilling) {
@@ -166,6 +187,61 @@ bool SymmetricCipherStream::readBlock()
     }
 }
 
+/**
+ * Read and decrypt a large chunk of CBC ciphertext at once, split into
+ * segments that are decrypted concurrently. Encryption stays serial.
+ *
+ * Until the base device reports its end, the last complete block is held
+ * back with any partial block, so that padding is only validated on the
+ * final chunk.
+ */
+bool SymmetricCipherStream::readChunk()
+{
+    QByteArray chunk = m_pendingCiphertext;
+    m_pendingCiphertext.clear();
+
+    int chunkSize = chunk.size();
+    chunk.resize(qMax(chunkSize, ParallelDecryptChunkSize));
+    while (chunkSize < chunk.size()) {
+        const qint64 readResult = m_baseDevice->read(chunk.data() + chunkSize, chunk.size() - chunkSize);
+        if (readResult == -1) {
+            m_error = true;
+            setErrorString(m_baseDevice->errorString());
+            return false;
+        } else if (readResult == 0) {
+            break;
+        }
+        chunkSize += static_cast<int>(readResult);
+    }
+    chunk.resize(chunkSize);
+
+    const bool lastChunk = m_baseDevice->atEnd();
+    if (!lastChunk) {
+        const int holdBack = qMin(chunk.size(), chunk.size() % blockSize() + blockSize());
+        m_pendingCiphertext = chunk.right(holdBack);
+        chunk.chop(holdBack);
+    }
+
+    m_buffer.clear();
+    m_bufferPos = 0;
+    m_bufferFilling = false;
+    if (chunk.isEmpty()) {
+        return false;
+    }
+
+    const auto nextIv = chunk.right(blockSize());
+    QString error;
+    if (!SymmetricCipher::decryptCbcParallel(m_cipher->mode(), m_key, m_chunkIv, chunk, &error, 0, lastChunk)) {
+        m_error = true;
+        setErrorString(error);
+        return false;
+    }
+    m_chunkIv = nextIv;
+    m_buffer = chunk;
+
+    return !m_buffer.isEmpty();
+}
+
 qint64 SymmetricCipherStream::writeData(const char* data, qint64 maxSize)
 {
     Q_ASSERT(maxSize >= 0);
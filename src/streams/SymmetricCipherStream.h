@@ -44,17 +44,24 @@ protected:
 private:
     void resetInternalState();
     bool readBlock();
+    bool readChunk();
     bool writeBlock(bool lastBlock);
     int blockSize() const;
 
     const QScopedPointer<SymmetricCipher> m_cipher;
     QByteArray m_buffer;
+    // CBC decryption state for chunks decrypted by SymmetricCipher::decryptCbcParallel()
+    QByteArray m_key;
+    QByteArray m_iv;
+    QByteArray m_chunkIv;
+    QByteArray m_pendingCiphertext;
     int m_bufferPos;
     bool m_bufferFilling;
     bool m_error;
     bool m_isInitialized;
     bool m_dataWritten;
     bool m_streamCipher;
+    bool m_parallelDecrypt;
 };
 
 #endif // KEEPASSX_SYMMETRICCIPHERSTREAM_H
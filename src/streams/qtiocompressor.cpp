@@ -76,7 +76,7 @@ public:
     QIODevice *device;
     bool manageDevice;
     z_stream zlibStream;
-    const int compressionLevel;
+    int compressionLevel;
     const ZlibSize bufferSize;
     ZlibByte *buffer;
     State state;
@@ -295,6 +295,71 @@ QtIOCompressor::StreamFormat QtIOCompressor::streamFormat() const
     return d->streamFormat;
 }
 
+/*!
+    Returns the current compression level.
+    \sa setCompressionLevel()
+*/
+int QtIOCompressor::compressionLevel() const
+{
+    Q_D(const QtIOCompressor);
+    return d->compressionLevel;
+}
+
+/*!
+    Sets the compression level to \a level, in the range 0 to 9.
+
+    The level can be changed while the QtIOCompressor is open for writing, data written afterwards
+    is compressed with the new level. Level 0 emits stored deflate blocks, which is the fastest way
+    to pass already compressed data through. The stream stays readable by any inflate implementation.
+
+    Returns false if the level could not be changed, the QtIOCompressor is then in an error state.
+*/
+bool QtIOCompressor::setCompressionLevel(int level)
+{
+    Q_D(QtIOCompressor);
+    if (level == d->compressionLevel)
+        return true;
+
+    if (isOpen() && (openMode() & WriteOnly)) {
+        if (d->state == QtIOCompressorPrivate::Error)
+            return false;
+
+        // Compress the pending input with the old level first, deflateParams()
+        // only has the output space of one buffer to do that itself.
+        // Z_BUF_ERROR means there was nothing left to compress.
+        d->zlibStream.next_in = nullptr;
+        d->zlibStream.avail_in = 0;
+        int status;
+        do {
+            d->zlibStream.next_out = d->buffer;
+            d->zlibStream.avail_out = d->bufferSize;
+            status = deflate(&d->zlibStream, Z_BLOCK);
+            if (status != Z_OK && status != Z_BUF_ERROR) {
+                d->state = QtIOCompressorPrivate::Error;
+                d->setZlibError(QT_TRANSLATE_NOOP("QtIOCompressor", "Internal zlib error when compressing: "), status);
+                return false;
+            }
+            if (!d->writeBytes(d->buffer, d->bufferSize - d->zlibStream.avail_out))
+                return false;
+        } while (d->zlibStream.avail_out == 0);
+
+        d->zlibStream.next_out = d->buffer;
+        d->zlibStream.avail_out = d->bufferSize;
+        status = deflateParams(&d->zlibStream, level, Z_DEFAULT_STRATEGY);
+        if (status != Z_OK) {
+            d->state = QtIOCompressorPrivate::Error;
+            d->setZlibError(QT_TRANSLATE_NOOP("QtIOCompressor", "Internal zlib error when compressing: "), status);
+            return false;
+        }
+
+        if (!d->writeBytes(d->buffer, d->bufferSize - d->zlibStream.avail_out))
+            return false;
+    }
+
+    d->compressionLevel = level;
+    return true;
+}
+
 /*!
     Returns true if the zlib library in use supports the gzip format, false otherwise.
 */
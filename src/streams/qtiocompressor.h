@@ -59,6 +59,8 @@ enum StreamFormat { ZlibFormat, GzipFormat, RawZipFormat };
     ~QtIOCompressor() override;
     void setStreamFormat(StreamFormat format);
     StreamFormat streamFormat() const;
+    int compressionLevel() const;
+    bool setCompressionLevel(int level);
     static bool isGzipSupported();
     bool isSequential() const override;
     bool open(OpenMode mode) override;
@@ -146,6 +146,16 @@ void TestAutoType::testSingleAutoType()
              QString("myuser%1mypass%2").arg(m_test->keyToString(Qt::Key_Tab)).arg(m_test->keyToString(Qt::Key_Enter)));
 }
 
+void TestAutoType::testActiveWindowChanged()
+{
+    // Typing stops at the key after the focus moved, not at the end of a chunk
+    m_test->setActiveWindowChangeAfter(3);
+    m_autoType->performAutoType(m_entry1);
+
+    QCOMPARE(m_test->actionCount(), 3);
+    QCOMPARE(m_test->actionChars(), QString("myu"));
+}
+
 void TestAutoType::testGlobalAutoTypeWithNoMatch()
 {
     m_test->setActiveWindowTitle("nomatch");
@@ -40,6 +40,7 @@ private slots:
 
     void testInternal();
     void testSingleAutoType();
+    void testActiveWindowChanged();
     void testGlobalAutoTypeWithNoMatch();
     void testGlobalAutoTypeWithOneMatch();
     void testGlobalAutoTypeTitleMatch();
@@ -17,12 +17,15 @@
 
 #include "TestBrowser.h"
 
+#include "browser/BrowserDatabaseListing.h"
 #include "browser/BrowserMessageBuilder.h"
 #include "browser/BrowserSettings.h"
 #include "core/Group.h"
 #include "core/Tools.h"
 #include "crypto/Crypto.h"
 
+#include <QElapsedTimer>
+#include <QJsonArray>
 #include <QJsonObject>
 #include <QTest>
 
@@ -144,6 +147,42 @@ void TestBrowser::testBuildResponse()
     QCOMPARE(firstArr["test"].toBool(), true);
 }
 
+void TestBrowser::testSessionKey()
+{
+    // The precomputed shared key must produce the same box as the key pair
+    const auto sharedKey = browserMessageBuilder()->getSharedKey(PUBLICKEY, SERVERSECRETKEY);
+    QCOMPARE(sharedKey.size(), static_cast<int>(crypto_box_BEFORENMBYTES));
+    QCOMPARE(browserMessageBuilder()->getSharedKey(SERVERPUBLICKEY, SECRETKEY), sharedKey);
+
+    const QJsonObject message{{"action", "test-action"}};
+    const auto encrypted = browserMessageBuilder()->encryptMessage(message, NONCE, sharedKey);
+    QCOMPARE(encrypted, browserMessageBuilder()->encryptMessage(message, NONCE, PUBLICKEY, SERVERSECRETKEY));
+    QCOMPARE(browserMessageBuilder()->decryptMessage(encrypted, NONCE, SERVERPUBLICKEY, SECRETKEY), message);
+
+    // Invalid keys and tampered messages are rejected
+    QVERIFY(browserMessageBuilder()->getSharedKey("", SERVERSECRETKEY).isEmpty());
+    QVERIFY(browserMessageBuilder()->getSharedKey("AAAA", SERVERSECRETKEY).isEmpty());
+    QVERIFY(browserMessageBuilder()->encryptMessage(message, NONCE, QByteArray()).isEmpty());
+    auto tampered = QByteArray::fromBase64(encrypted.toLatin1());
+    tampered[0] = static_cast<char>(tampered[0] ^ 1);
+    QVERIFY(browserMessageBuilder()->decryptMessage(tampered.toBase64(), NONCE, sharedKey).isEmpty());
+    QVERIFY(browserMessageBuilder()->decryptMessage("AAAA", NONCE, sharedKey).isEmpty());
+
+    // Changing the public keys replaces the session key
+    QJsonObject json;
+    json["action"] = "change-public-keys";
+    json["publicKey"] = PUBLICKEY;
+    json["nonce"] = NONCE;
+    auto response = m_browserAction->processClientMessage(nullptr, json);
+    const auto serverPublicKey = response["publicKey"].toString();
+    const auto firstSessionKey = m_browserAction->m_sharedKey;
+    QCOMPARE(firstSessionKey, browserMessageBuilder()->getSharedKey(serverPublicKey, SECRETKEY));
+
+    m_browserAction->processClientMessage(nullptr, json);
+    QVERIFY(!m_browserAction->m_sharedKey.isEmpty());
+    QVERIFY(m_browserAction->m_sharedKey != firstSessionKey);
+}
+
 void TestBrowser::testSortPriority()
 {
     QFETCH(QString, entryUrl);
@@ -736,3 +775,220 @@ void TestBrowser::testRestrictBrowserKey()
     QCOMPARE(sorted[2]->url(), QString("https://example.com/2"));
     QCOMPARE(sorted[3]->url(), QString("https://example.com/0"));
 }
+
+void TestBrowser::testDatabaseListing()
+{
+    auto db = QSharedPointer<Database>::create();
+    QStringList urls;
+    for (int i = 0; i < 10; ++i) {
+        urls << QString("https://site%1.example.com").arg(i);
+    }
+    auto entries = createEntries(urls, db->rootGroup());
+    auto group = new Group();
+    group->setUuid(QUuid::createUuid());
+    group->setName("Sub");
+    group->setParent(db->rootGroup());
+
+    BrowserDatabaseListing listing;
+    listing.update(db.data());
+    const auto generation = listing.generation();
+
+    BrowserDatabaseListing::EntryQuery query;
+    auto result = listing.entries(query);
+    QCOMPARE(result["entries"].toArray().size(), 10);
+    QCOMPARE(result["total"].toInt(), 10);
+    QVERIFY(!result.contains("removed"));
+
+    // Paging
+    query.offset = 4;
+    query.limit = 3;
+    result = listing.entries(query);
+    auto page = result["entries"].toArray();
+    QCOMPARE(page.size(), 3);
+    QCOMPARE(result["total"].toInt(), 10);
+    QCOMPARE(page.at(0).toObject()["uuid"].toString(), entries.at(4)->uuidToHex());
+    QCOMPARE(page.at(2).toObject()["uuid"].toString(), entries.at(6)->uuidToHex());
+
+    // Filtering by title or URL
+    query = {};
+    query.filter = "SITE3.example";
+    result = listing.entries(query);
+    QCOMPARE(result["total"].toInt(), 1);
+    QCOMPARE(result["entries"].toArray().at(0).toObject()["url"].toString(), urls.at(3));
+
+    // Unchanged database is not listed again
+    listing.update(db.data());
+    QCOMPARE(listing.generation(), generation);
+    QCOMPARE(listing.groups()["groups"].toArray().size(), 1);
+    QCOMPARE(listing.groups()["groups"].toArray().at(0).toObject()["children"].toArray().size(), 1);
+    QCOMPARE(listing.groups(generation)["groups"].toArray().size(), 0);
+
+    // Changes since a generation
+    const auto removedUuid = entries.at(5)->uuidToHex();
+    entries.at(2)->setTitle("Changed");
+    delete entries.at(5);
+    listing.update(db.data());
+    QVERIFY(listing.generation() > generation);
+
+    query = {};
+    query.since = generation;
+    result = listing.entries(query);
+    QCOMPARE(result["total"].toInt(), 1);
+    QCOMPARE(result["entries"].toArray().at(0).toObject()["title"].toString(), QString("Changed"));
+    QCOMPARE(result["removed"].toArray(), QJsonArray({removedUuid}));
+    QCOMPARE(listing.groups(generation)["groups"].toArray().size(), 0);
+
+    query.since = listing.generation();
+    result = listing.entries(query);
+    QCOMPARE(result["total"].toInt(), 0);
+    QCOMPARE(result["removed"].toArray().size(), 0);
+    QCOMPARE(static_cast<quint64>(result["generation"].toDouble()), listing.generation());
+
+    // A generation of another listing, as after a restart, results in a complete listing
+    BrowserDatabaseListing otherListing;
+    otherListing.update(db.data());
+    QVERIFY(otherListing.generation() != listing.generation());
+    query.since = generation;
+    result = otherListing.entries(query);
+    QCOMPARE(result["total"].toInt(), 9);
+    QVERIFY(!result.contains("removed"));
+
+    // A generation of another database results in a complete listing
+    auto otherDb = QSharedPointer<Database>::create();
+    QStringList otherUrls{"https://other.example.com"};
+    createEntries(otherUrls, otherDb->rootGroup());
+    listing.update(otherDb.data());
+    query.since = generation;
+    result = listing.entries(query);
+    QCOMPARE(result["total"].toInt(), 1);
+    QVERIFY(!result.contains("removed"));
+    QCOMPARE(listing.groups(generation)["groups"].toArray().size(), 1);
+
+    listing.update(nullptr);
+    QVERIFY(listing.entries({}).isEmpty());
+    QVERIFY(listing.groups().isEmpty());
+}
+
+void TestBrowser::benchmarkGetLogins()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    auto db = QSharedPointer<Database>::create();
+    QStringList urls;
+    for (int i = 0; i < 2000; ++i) {
+        urls << QString("https://site%1.example.com/login").arg(i % 200);
+    }
+    createEntries(urls, db->rootGroup());
+
+    QJsonObject keyRequest;
+    keyRequest["action"] = "change-public-keys";
+    keyRequest["publicKey"] = PUBLICKEY;
+    keyRequest["nonce"] = NONCE;
+    const auto serverPublicKey = m_browserAction->processClientMessage(nullptr, keyRequest)["publicKey"].toString();
+    const auto clientSharedKey = browserMessageBuilder()->getSharedKey(serverPublicKey, SECRETKEY);
+
+    // Encrypt the requests up front, as the browser extension would
+    const int requestCount = 1000;
+    QList<QJsonObject> requests;
+    for (int i = 0; i < requestCount; ++i) {
+        const auto nonce = browserMessageBuilder()->getRandomBytesAsBase64(crypto_box_NONCEBYTES);
+        const QJsonObject message{{"action", "get-logins"},
+                                  {"url", QString("https://site%1.example.com").arg(i % 200)},
+                                  {"submitUrl", QString("https://site%1.example.com/login").arg(i % 200)}};
+        QJsonObject request;
+        request["action"] = "get-logins";
+        request["nonce"] = nonce;
+        request["message"] = browserMessageBuilder()->encryptMessage(message, nonce, clientSharedKey);
+        requests << request;
+    }
+
+    // Decrypt, look up and encrypt the response like BrowserAction::handleGetLogins
+    int found = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK_ONCE
+    {
+        for (const auto& request : asConst(requests)) {
+            const auto browserRequest = m_browserAction->decodeRequest(request);
+            const auto siteUrl = browserRequest.getString("url");
+            const auto entries = m_browserService->searchEntries(db, siteUrl, browserRequest.getString("submitUrl"));
+            found += entries.size();
+
+            QJsonArray result;
+            for (const auto* entry : entries) {
+                result.append(QJsonObject{{"login", entry->username()}, {"password", entry->password()}});
+            }
+            const Parameters params{{"count", result.count()}, {"entries", result}, {"hash", browserRequest.hash}};
+            QVERIFY(!m_browserAction->buildResponse("get-logins", browserRequest.incrementedNonce, params)
+                         .value("message")
+                         .toString()
+                         .isEmpty());
+        }
+    };
+    qInfo("get-logins: %.0f requests per second", requestCount * 1000.0 / qMax<qint64>(1, timer.elapsed()));
+
+    QCOMPARE(found, requestCount * 10);
+}
+
+void TestBrowser::benchmarkGetDatabaseEntries()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    auto db = QSharedPointer<Database>::create();
+    QStringList urls;
+    for (int i = 0; i < 50000; ++i) {
+        urls << QString("https://site%1.example.com/login").arg(i);
+    }
+    auto entries = createEntries(urls, db->rootGroup());
+
+    const auto sharedKey = browserMessageBuilder()->getSharedKey(PUBLICKEY, SERVERSECRETKEY);
+    auto respond = [&](const QJsonObject& result) {
+        const Parameters params{{"entries", result["entries"].toArray()},
+                                {"total", result["total"].toInt()},
+                                {"generation", result["generation"].toVariant()}};
+        return browserMessageBuilder()->buildResponse("get-database-entries", NONCE, params, sharedKey);
+    };
+
+    // Uncached full listing, as every request was served before
+    BrowserDatabaseListing listing;
+    QJsonObject response;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK_ONCE
+    {
+        listing.update(db.data());
+        response = respond(listing.entries({}));
+    }
+    const auto fullSize = response["message"].toString().size();
+    qInfo("full listing: %lld ms, %d bytes", timer.elapsed(), fullSize);
+
+    // Cached page
+    BrowserDatabaseListing::EntryQuery query;
+    query.limit = 500;
+    timer.restart();
+    listing.update(db.data());
+    response = respond(listing.entries(query));
+    qInfo("cached page of %d: %lld ms, %d bytes", query.limit, timer.elapsed(), response["message"].toString().size());
+
+    // Changes since the last listing
+    const auto generation = listing.generation();
+    entries.at(100)->setTitle("Changed");
+    query = {};
+    query.since = generation;
+    timer.restart();
+    listing.update(db.data());
+    auto result = listing.entries(query);
+    response = respond(result);
+    const auto deltaSize = response["message"].toString().size();
+    qInfo("changes since generation: %lld ms, %d bytes", timer.elapsed(), deltaSize);
+    QCOMPARE(result["total"].toInt(), 1);
+
+    // A single change is a tiny fraction of the full listing
+    QVERIFY(deltaSize * 1000 < fullSize);
+}
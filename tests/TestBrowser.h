@@ -37,6 +37,7 @@ private slots:
     void testGetBase64FromKey();
     void testIncrementNonce();
     void testBuildResponse();
+    void testSessionKey();
     void testSortPriority();
     void testSortPriority_data();
     void testSearchEntries();
@@ -50,6 +51,9 @@ private slots:
     void testBestMatchingCredentials();
     void testBestMatchingWithAdditionalURLs();
     void testRestrictBrowserKey();
+    void testDatabaseListing();
+    void benchmarkGetLogins();
+    void benchmarkGetDatabaseEntries();
 
 private:
     QList<Entry*> createEntries(QStringList& urls, Group* root) const;
@@ -50,6 +50,7 @@
 #include "cli/Open.h"
 #include "cli/Remove.h"
 #include "cli/RemoveGroup.h"
+#include "cli/Run.h"
 #include "cli/Search.h"
 #include "cli/Show.h"
 #include "cli/Utils.h"
@@ -245,10 +246,11 @@ void TestCli::testBatchCommands()
     QVERIFY(Commands::getCommand("open"));
     QVERIFY(Commands::getCommand("rm"));
     QVERIFY(Commands::getCommand("rmdir"));
+    QVERIFY(Commands::getCommand("run"));
     QVERIFY(Commands::getCommand("show"));
     QVERIFY(Commands::getCommand("search"));
     QVERIFY(!Commands::getCommand("doesnotexist"));
-    QCOMPARE(Commands::getCommands().size(), 26);
+    QCOMPARE(Commands::getCommands().size(), 27);
 }
 
 void TestCli::testInteractiveCommands()
@@ -448,6 +450,21 @@ void TestCli::testAnalyze()
     QVERIFY(output.contains("123"));
     m_stderr->readLine(); // Skip password prompt
     QCOMPARE(m_stderr->readAll(), QByteArray());
+
+    // Duplicate entries only, the HIBP check is skipped
+    Add addCmd;
+    for (const auto& path : {"/duplicate-entry", "/duplicate-entry2"}) {
+        setInput("a");
+        execCmd(addCmd, {"add", "-q", "-u", "alice", "--url", "https://login.example.com", m_dbFile->fileName(), path});
+    }
+
+    setInput("a");
+    execCmd(analyzeCmd, {"analyze", "--duplicates", m_dbFile->fileName()});
+    output = m_stdout->readAll();
+    QVERIFY(output.contains("Duplicate login for example.com / alice:\n  duplicate-entry\n  duplicate-entry2\n"));
+    QVERIFY(!output.contains("leaked"));
+    m_stderr->readLine(); // Skip password prompt
+    QCOMPARE(m_stderr->readAll(), QByteArray());
 }
 
 void TestCli::testAttachmentExport()
@@ -1311,6 +1328,37 @@ void TestCli::testExport()
     QVERIFY(csvData.contains(QByteArray(
         "\"NewDatabase\",\"Sample Entry\",\"User Name\",\"Password\",\"http://www.somesite.com/\",\"Notes\"")));
 
+    // Streaming to a file with chunked flushing and progress reporting
+    TemporaryFile exportFile;
+    QVERIFY(exportFile.open());
+    exportFile.close();
+    setInput("a");
+    execCmd(exportCmd,
+            {"export", "--chunk", "1", "--progress", "-o", exportFile.fileName(), m_dbFile->fileName()});
+    QCOMPARE(m_stdout->readAll(), QByteArray());
+    m_stderr->readLine(); // Skip password prompt
+    QByteArray progress = m_stderr->readAll();
+    QVERIFY(progress.startsWith("Exported 1 of "));
+    QVERIFY(progress.endsWith(" entries\n"));
+
+    QScopedPointer<Database> dbStreamed(new Database());
+    QVERIFY(dbStreamed->import(exportFile.fileName()));
+    QVERIFY(dbStreamed->rootGroup()->findEntryByPath("/Sample Entry"));
+
+    setInput("a");
+    execCmd(exportCmd, {"export", "-f", "csv", "-o", exportFile.fileName(), m_dbFile->fileName()});
+    QCOMPARE(m_stdout->readAll(), QByteArray());
+    QVERIFY(exportFile.open(QIODevice::ReadOnly));
+    QCOMPARE(exportFile.readLine(), csvHeader);
+    QCOMPARE(exportFile.readAll(), csvData);
+    exportFile.close();
+
+    // Invalid chunk size
+    setInput("a");
+    execCmd(exportCmd, {"export", "--chunk", "0", m_dbFile->fileName()});
+    m_stderr->readLine(); // Skip password prompt
+    QCOMPARE(m_stderr->readLine(), QByteArray("Invalid chunk size 0.\n"));
+
     // test invalid format
     setInput("a");
     execCmd(exportCmd, {"export", "-f", "yaml", m_dbFile->fileName()});
@@ -1482,6 +1530,45 @@ void TestCli::testImport()
 
     db = readDatabase(databaseFilenameQuiet, "a");
     QVERIFY(db);
+
+    // Progress reporting
+    QString databaseFilenameProgress = testDirQuiet->path() + "/testImportProgress.kdbx";
+    setInput({"a", "a"});
+    execCmd(importCmd, {"import", "-p", "--progress", m_xmlFile->fileName(), databaseFilenameProgress});
+
+    QCOMPARE(m_stderr->readLine(), QByteArray("Enter password to encrypt database (optional): \n"));
+    QCOMPARE(m_stderr->readLine(), QByteArray("Repeat password: \n"));
+    QByteArray progress = m_stderr->readAll();
+    QVERIFY(progress.contains("% of the XML export\n"));
+    QVERIFY(progress.endsWith("Encrypting and writing database\n"));
+    QCOMPARE(m_stdout->readLine(), QByteArray("Successfully imported database.\n"));
+
+    db = readDatabase(databaseFilenameProgress, "a");
+    QVERIFY(db);
+
+    // The XML export cannot share standard input with the password prompt
+    QString databaseFilenameStdin = testDirQuiet->path() + "/testImportStdin.kdbx";
+    execCmd(importCmd, {"import", "-p", "-", databaseFilenameStdin});
+    QCOMPARE(m_stderr->readAll(),
+             QByteArray("Cannot read the XML export from standard input together with --set-password.\n"));
+    QVERIFY(!QFile::exists(databaseFilenameStdin));
+
+    // Reading the XML export from standard input with a key file
+    QFile xmlFile(m_xmlFile->fileName());
+    QVERIFY(xmlFile.open(QIODevice::ReadOnly));
+    auto pos = m_stdin->pos();
+    m_stdin->write(xmlFile.readAll());
+    m_stdin->seek(pos);
+    execCmd(importCmd, {"import", "--set-key-file", keyfilePath, "-", databaseFilenameStdin});
+    QCOMPARE(m_stdout->readLine(), QByteArray("Successfully imported database.\n"));
+
+    auto fileKey = QSharedPointer<FileKey>::create();
+    QVERIFY(fileKey->load(keyfilePath));
+    auto stdinKey = QSharedPointer<CompositeKey>::create();
+    stdinKey->addKey(fileKey);
+    db = QSharedPointer<Database>::create();
+    QVERIFY(db->open(databaseFilenameStdin, stdinKey));
+    QVERIFY(db->rootGroup()->findEntryByPath("/Sample Entry 1"));
 }
 
 void TestCli::testKeyFileOption()
@@ -1987,6 +2074,90 @@ void TestCli::testRemoveQuiet()
     QVERIFY(!db->rootGroup()->findEntryByPath(QString("/%1/Sample Entry").arg(Group::tr("Recycle Bin"))));
 }
 
+void TestCli::testRun()
+{
+#ifdef Q_OS_WIN
+    QSKIP("Requires a POSIX shell");
+#endif
+    Run runCmd;
+    QVERIFY(!runCmd.name.isEmpty());
+    QVERIFY(runCmd.getDescriptionLine().contains(runCmd.name));
+
+    TemporaryFile output;
+    QVERIFY(output.open());
+    output.close();
+
+    // All placeholders are resolved with a single unlock
+    const auto script = QString("printf '%s|%s|' \"$SECRET\" \"$LOGIN\" > \"%1\" && cat \"$SECRET_FILE\" >> \"%1\"")
+                            .arg(output.fileName());
+    setInput("a");
+    int ret = execCmd(runCmd,
+                      {"run",
+                       "-e",
+                       "SECRET={{/Sample Entry}}",
+                       "-e",
+                       "LOGIN=user={{/Sample Entry#username}}",
+                       "-f",
+                       "SECRET_FILE={{/Sample Entry#Password}}:{{/Sample Entry#URL}}",
+                       m_dbFile->fileName(),
+                       "--",
+                       "sh",
+                       "-c",
+                       script});
+    QCOMPARE(ret, EXIT_SUCCESS);
+    m_stderr->readLine(); // skip password prompt
+    QCOMPARE(m_stderr->readAll(), QByteArray());
+    QVERIFY(output.open());
+    QCOMPARE(output.readAll(), QByteArray("Password|user=User Name|Password:http://www.somesite.com/"));
+    output.close();
+
+    // The exit code of the command is passed on
+    setInput("a");
+    ret = execCmd(runCmd, {"run", m_dbFile->fileName(), "--", "sh", "-c", "exit 3"});
+    QCOMPARE(ret, 3);
+
+    // Options after the database belong to the command, -- is optional
+    setInput("a");
+    ret = execCmd(runCmd, {"run", m_dbFile->fileName(), "sh", "-c", "exit 4"});
+    QCOMPARE(ret, 4);
+    m_stderr->readLine(); // skip password prompt
+    QCOMPARE(m_stderr->readAll(), QByteArray());
+
+    // Nothing is run unless all placeholders resolve
+    setInput("a");
+    ret = execCmd(runCmd,
+                  {"run",
+                   "-e",
+                   "SECRET={{/Missing Entry}}",
+                   "-e",
+                   "OTHER={{/Sample Entry#missing}}",
+                   m_dbFile->fileName(),
+                   "--",
+                   "sh",
+                   "-c",
+                   QString("echo ran > \"%1\"").arg(output.fileName())});
+    QCOMPARE(ret, EXIT_FAILURE);
+    m_stderr->readLine(); // skip password prompt
+    QCOMPARE(m_stderr->readAll(),
+             QByteArray("Could not find entry with path /Missing Entry.\n"
+                        "ERROR: unknown attribute missing.\n"));
+    QVERIFY(output.open());
+    QCOMPARE(output.readAll(), QByteArray("Password|user=User Name|Password:http://www.somesite.com/"));
+    output.close();
+
+    setInput("a");
+    ret = execCmd(runCmd, {"run", "-e", "1X=value", m_dbFile->fileName(), "--", "true"});
+    QCOMPARE(ret, EXIT_FAILURE);
+    m_stderr->readLine(); // skip password prompt
+    QCOMPARE(m_stderr->readAll(), QByteArray("Invalid assignment 1X=value, expected NAME=template.\n"));
+
+    setInput("a");
+    ret = execCmd(runCmd, {"run", m_dbFile->fileName(), "keepassxc-cli-test-missing-command"});
+    QCOMPARE(ret, EXIT_FAILURE);
+    m_stderr->readLine(); // skip password prompt
+    QVERIFY(m_stderr->readAll().startsWith("Failed to run keepassxc-cli-test-missing-command"));
+}
+
 void TestCli::testSearch()
 {
     Search searchCmd;
@@ -2055,6 +2226,25 @@ void TestCli::testSearch()
     setInput("a");
     execCmd(searchCmd, {"search", tmpFile.fileName(), "u:User Name"});
     QCOMPARE(m_stdout->readAll(), QByteArray("/Sample Entry\n/Homebanking/Subgroup/Subgroup Entry\n"));
+
+    // Search several databases at once, each result is prefixed with its database
+    setInput({"a", "a"});
+    execCmd(searchCmd, {"search", m_dbFile->fileName(), "--with", tmpFile.fileName(), "title:Entry"});
+    QCOMPARE(m_stdout->readAll(),
+             QString("%1:/Sample Entry\n%1:/Homebanking/Subgroup/Subgroup Entry\n"
+                     "%2:/Sample Entry\n%2:/General/New Entry\n%2:/Homebanking/Subgroup/Subgroup Entry\n")
+                 .arg(m_dbFile->fileName(), tmpFile.fileName())
+                 .toUtf8());
+
+    // Results are ranked by title across databases
+    setInput("a");
+    execCmd(searchCmd, {"search", "-s", m_dbFile->fileName(), "--with", tmpFile.fileName(), "New Entry"});
+    QCOMPARE(m_stdout->readAll(), QString("%1:/General/New Entry\n").arg(tmpFile.fileName()).toUtf8());
+
+    setInput("a");
+    execCmd(searchCmd, {"search", "-s", m_dbFile->fileName(), "--with", "/nonexistent.kdbx", "Entry"});
+    QVERIFY(m_stderr->readAll().contains("/nonexistent.kdbx"));
+    QCOMPARE(m_stdout->readAll(), QByteArray());
 }
 
 void TestCli::testShow()
@@ -76,6 +76,7 @@ private slots:
     void testRemove();
     void testRemoveGroup();
     void testRemoveQuiet();
+    void testRun();
     void testSearch();
     void testShow();
     void testInvalidDbFiles();
@@ -0,0 +1,303 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestDuplicateFinder.h"
+
+#include <QPointer>
+#include <QTest>
+
+#include "core/Clock.h"
+#include "core/DuplicateFinder.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "core/Totp.h"
+#include "crypto/Crypto.h"
+
+QTEST_GUILESS_MAIN(TestDuplicateFinder)
+
+namespace
+{
+    Entry* newEntry(Group* group, const QString& title, const QString& url, const QString& username)
+    {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(title);
+        entry->setUrl(url);
+        entry->setUsername(username);
+        entry->setGroup(group);
+        return entry;
+    }
+
+    void setModificationTime(Entry* entry, const QDateTime& time)
+    {
+        auto timeInfo = entry->timeInfo();
+        timeInfo.setLastModificationTime(time);
+        entry->setTimeInfo(timeInfo);
+    }
+} // namespace
+
+void TestDuplicateFinder::initTestCase()
+{
+    QVERIFY(Crypto::init());
+}
+
+void TestDuplicateFinder::testRegistrableDomain_data()
+{
+    QTest::addColumn<QString>("url");
+    QTest::addColumn<QString>("domain");
+
+    QTest::newRow("Empty") << "" << "";
+    QTest::newRow("Plain domain") << "example.com" << "example.com";
+    QTest::newRow("Subdomain") << "https://login.accounts.example.com/path?x=1" << "example.com";
+    QTest::newRow("Upper case") << "HTTPS://WWW.Example.COM" << "example.com";
+    QTest::newRow("Country code second level") << "https://shop.example.co.uk" << "example.co.uk";
+    QTest::newRow("Country code") << "https://www.example.de" << "example.de";
+    QTest::newRow("IPv4") << "http://192.168.1.1:8080/admin" << "192.168.1.1";
+    QTest::newRow("Single label") << "http://router/" << "router";
+}
+
+void TestDuplicateFinder::testRegistrableDomain()
+{
+    QFETCH(QString, url);
+    QFETCH(QString, domain);
+
+    QCOMPARE(DuplicateFinder::registrableDomain(url), domain);
+}
+
+void TestDuplicateFinder::testLoginDuplicates()
+{
+    Database db;
+    auto root = db.rootGroup();
+    auto group = new Group();
+    group->setUuid(QUuid::createUuid());
+    group->setParent(root);
+
+    auto first = newEntry(root, "Example", "https://www.example.com/login", "alice");
+    auto second = newEntry(group, "Example (imported)", "example.com", "Alice ");
+    newEntry(root, "Other user", "https://example.com", "bob");
+    newEntry(root, "Other site", "https://example.org", "alice");
+    newEntry(root, "No username", "https://example.com", "");
+    newEntry(root, "No username 2", "https://example.com", "");
+
+    DuplicateFinder finder(&db);
+    auto duplicates = finder.duplicates();
+    QCOMPARE(duplicates.size(), 1);
+    QCOMPARE(duplicates.first().match, DuplicateFinder::Match::Login);
+    QCOMPARE(duplicates.first().description, QString("example.com / alice"));
+    QCOMPARE(duplicates.first().entries, QList<Entry*>({first, second}));
+
+    // Recycled entries are not duplicates
+    db.recycleEntry(second);
+    QVERIFY(finder.duplicates().isEmpty());
+}
+
+void TestDuplicateFinder::testTotpAndPasskeyDuplicates()
+{
+    Database db;
+    auto root = db.rootGroup();
+
+    auto first = newEntry(root, "First", "", "");
+    first->setTotp(Totp::createSettings("GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ"));
+    auto second = newEntry(root, "Second", "", "");
+    second->setTotp(Totp::createSettings("gezd gnbv gy3t qojq gezd gnbv gy3t qojq"));
+    auto third = newEntry(root, "Third", "", "");
+    third->setTotp(Totp::createSettings("JBSWY3DPEHPK3PXP"));
+
+    auto passkey1 = newEntry(root, "Passkey", "https://example.com", "");
+    passkey1->attributes()->set(EntryAttributes::KPEX_PASSKEY_CREDENTIAL_ID, "credential");
+    passkey1->attributes()->set(EntryAttributes::KPEX_PASSKEY_RELYING_PARTY, "example.com");
+    auto passkey2 = passkey1->clone(Entry::CloneNewUuid);
+    passkey2->setGroup(root);
+    auto passkey3 = passkey1->clone(Entry::CloneNewUuid);
+    passkey3->attributes()->set(EntryAttributes::KPEX_PASSKEY_RELYING_PARTY, "example.org");
+    passkey3->setGroup(root);
+
+    DuplicateFinder finder(&db);
+    const auto duplicates = finder.duplicates();
+    QCOMPARE(duplicates.size(), 2);
+    for (const auto& set : duplicates) {
+        if (set.match == DuplicateFinder::Match::Totp) {
+            QCOMPARE(set.entries, QList<Entry*>({first, second}));
+            QVERIFY(set.description.isEmpty());
+        } else {
+            QCOMPARE(set.match, DuplicateFinder::Match::Passkey);
+            QCOMPARE(set.entries, QList<Entry*>({passkey1, passkey2}));
+            QCOMPARE(set.description, QString("example.com"));
+        }
+    }
+}
+
+void TestDuplicateFinder::testIndexUpdates()
+{
+    Database db;
+    auto root = db.rootGroup();
+    auto first = newEntry(root, "First", "https://example.com", "alice");
+    auto second = newEntry(root, "Second", "https://example.com", "bob");
+
+    DuplicateFinder finder(&db);
+    QVERIFY(finder.duplicates().isEmpty());
+
+    // Entry changes are picked up with the coalesced modified notification
+    second->setUsername("alice");
+    QTRY_COMPARE(finder.duplicates().size(), 1);
+
+    first->setUrl("https://example.net");
+    QTRY_VERIFY(finder.duplicates().isEmpty());
+
+    // New entries are indexed as well
+    auto third = newEntry(root, "Third", "https://login.example.net", "alice");
+    QTRY_COMPARE(finder.duplicates().size(), 1);
+    QCOMPARE(finder.duplicates().first().entries, QList<Entry*>({first, third}));
+
+    delete third;
+    QTRY_VERIFY(finder.duplicates().isEmpty());
+}
+
+void TestDuplicateFinder::testMerge()
+{
+    Database db;
+    auto root = db.rootGroup();
+    const auto now = Clock::currentDateTimeUtc();
+
+    auto older = newEntry(root, "Older", "https://example.com", "alice");
+    auto historyItem = older->clone(Entry::CloneNoFlags);
+    historyItem->setPassword("oldest password");
+    setModificationTime(historyItem, now.addDays(-20));
+    older->addHistoryItem(historyItem);
+    older->setPassword("old password");
+    // Set last, every change updates the modification time
+    setModificationTime(older, now.addDays(-10));
+
+    auto newer = newEntry(root, "Newer", "https://example.com", "alice");
+    newer->setPassword("new password");
+    setModificationTime(newer, now.addDays(-1));
+    const auto newerUuid = newer->uuid();
+
+    auto kept = DuplicateFinder::merge({older, newer});
+    QCOMPARE(kept, newer);
+    QCOMPARE(kept->uuid(), newerUuid);
+    QCOMPARE(kept->password(), QString("new password"));
+    QCOMPARE(kept->timeInfo().lastModificationTime(), now.addDays(-1));
+
+    // The other entry and its history are preserved as history items of the kept entry
+    const auto history = kept->historyItems();
+    QCOMPARE(history.size(), 2);
+    QCOMPARE(history.at(0)->password(), QString("oldest password"));
+    QCOMPARE(history.at(1)->password(), QString("old password"));
+    QCOMPARE(history.at(1)->title(), QString("Older"));
+    for (auto item : history) {
+        QCOMPARE(item->uuid(), newerUuid);
+    }
+
+    QVERIFY(older->isRecycled());
+    QCOMPARE(DuplicateFinder::merge({kept}), kept);
+}
+
+void TestDuplicateFinder::testMergeRevisions()
+{
+    Database db;
+    db.metadata()->setHistoryMaxItems(1);
+    auto root = db.rootGroup();
+    const auto time = Clock::currentDateTimeUtc().addDays(-5);
+
+    auto first = newEntry(root, "First", "https://example.com", "alice");
+    first->setPassword("first");
+    setModificationTime(first, time);
+
+    // Same modification time, but a different revision, with an identical copy of the first entry in its history
+    auto second = newEntry(root, "Second", "https://example.com", "alice");
+    second->setPassword("second");
+    second->addHistoryItem(first->clone(Entry::CloneNoFlags));
+    setModificationTime(second, time);
+
+    auto third = newEntry(root, "Third", "https://example.com", "alice");
+    setModificationTime(third, time.addDays(1));
+
+    auto kept = DuplicateFinder::merge({first, second, third});
+    QCOMPARE(kept, third);
+
+    // Both revisions are kept, the identical copy only once, and the history limit is not applied
+    const auto history = kept->historyItems();
+    QCOMPARE(history.size(), 2);
+    QStringList passwords;
+    for (auto item : history) {
+        passwords << item->password();
+    }
+    passwords.sort();
+    QCOMPARE(passwords, QStringList({"first", "second"}));
+}
+
+void TestDuplicateFinder::testMergeWithoutRecycleBin()
+{
+    Database db;
+    db.metadata()->setRecycleBinEnabled(false);
+    auto root = db.rootGroup();
+
+    QPointer<Entry> older = newEntry(root, "Older", "https://example.com", "alice");
+    setModificationTime(older, Clock::currentDateTimeUtc().addDays(-1));
+    auto newer = newEntry(root, "Newer", "https://example.com", "alice");
+
+    // Entries are only deleted permanently on request
+    QCOMPARE(DuplicateFinder::merge({older, newer}), static_cast<Entry*>(nullptr));
+    QVERIFY(older);
+    QCOMPARE(root->entries().size(), 2);
+    QVERIFY(newer->historyItems().isEmpty());
+
+    QCOMPARE(DuplicateFinder::merge({older, newer}, true), newer);
+    QVERIFY(!older);
+    QCOMPARE(root->entries().size(), 1);
+    QCOMPARE(newer->historyItems().size(), 1);
+}
+
+void TestDuplicateFinder::benchmarkDuplicateFinder()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    // 100k entries in 100 groups, every 10th entry duplicates a login of another group
+    Database db;
+    db.setEmitModified(false);
+    QList<Group*> groups;
+    for (int i = 0; i < 100; ++i) {
+        auto group = new Group();
+        group->setUuid(QUuid::createUuid());
+        group->setName(QString("Group %1").arg(i));
+        group->setParent(db.rootGroup());
+        groups.append(group);
+    }
+    for (int i = 0; i < 100000; ++i) {
+        const int site = i % 10 == 0 ? i + 1 : i;
+        auto entry = newEntry(groups.at(i % groups.size()),
+                              QString("Entry %1").arg(i),
+                              QString("https://login.site%1.example.com/").arg(site),
+                              QString("user%1").arg(site % 7));
+        if (i % 50 == 0) {
+            entry->setTotp(Totp::createSettings(QString("JBSWY3DPEHPK3PXP%1").arg(i % 100 == 0 ? 0 : i)));
+        }
+    }
+
+    int sets = 0;
+    QBENCHMARK
+    {
+        DuplicateFinder finder(&db);
+        sets = finder.duplicates().size();
+    };
+    QVERIFY(sets > 0);
+}
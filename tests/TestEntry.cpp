@@ -18,12 +18,18 @@
 
 #include <QTest>
 
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define HAVE_MALLINFO2
+#endif
+
 #include "TestEntry.h"
 #include "core/Clock.h"
 #include "core/Group.h"
 #include "core/Metadata.h"
 #include "core/TimeInfo.h"
 #include "crypto/Crypto.h"
+#include "mock/MockClock.h"
 
 QTEST_GUILESS_MAIN(TestEntry)
 
@@ -851,3 +857,100 @@ void TestEntry::testPreviousParentGroup()
     QVERIFY(entry->previousParentGroupUuid() == group1->uuid());
     QVERIFY(entry->previousParentGroup() == group1);
 }
+
+void TestEntry::testCustomData()
+{
+    MockClock::setup(new MockClock(2010, 5, 5, 10, 30, 10));
+
+    Entry entry1;
+    Entry entry2;
+    const QString key = CustomData::BrowserKeyPrefix + "Allowed";
+
+    entry1.customData()->set(key, "value1");
+    entry1.customData()->set("b", "value2");
+    entry1.customData()->set("c", "value3");
+    entry2.customData()->set("c", "value3");
+    entry2.customData()->set(key, "value1");
+    entry2.customData()->set("b", "value2");
+
+    // Item order does not affect equality, the last modified stamp is an item too
+    QCOMPARE(entry1.customData()->size(), 4);
+    QVERIFY(entry1.customData()->contains(CustomData::LastModified));
+    QVERIFY(*entry1.customData() == *entry2.customData());
+
+    // Stored keys are implicit copies of the string passed in, not separate allocations
+    const auto keys1 = entry1.customData()->keys();
+    const auto keys2 = entry2.customData()->keys();
+    QCOMPARE(keys1.at(keys1.indexOf(key)).constData(), keys2.at(keys2.indexOf(key)).constData());
+
+    entry1.customData()->rename("b", "d");
+    QVERIFY(!entry1.customData()->contains("b"));
+    QCOMPARE(entry1.customData()->value("d"), QString("value2"));
+    QVERIFY(*entry1.customData() != *entry2.customData());
+
+    entry1.customData()->remove("c");
+    entry1.customData()->remove("d");
+    entry1.customData()->remove(key);
+    QVERIFY(entry1.customData()->isEmpty());
+
+    entry2.customData()->set("e", "value4");
+    QCOMPARE(entry2.customData()->value("e"), QString("value4"));
+    QCOMPARE(entry2.customData()->value("b"), QString("value2"));
+    QCOMPARE(entry2.customData()->size(), 5);
+
+    MockClock::teardown();
+}
+
+void TestEntry::benchmarkCustomDataMemory()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    const int numEntries = 20000;
+    const QStringList keys = {CustomData::BrowserKeyPrefix + "Allowed", CustomData::BrowserKeyPrefix + "Denied"};
+
+    QBENCHMARK_ONCE
+    {
+#ifdef HAVE_MALLINFO2
+        // Reference: the items stored in one QHash per object, as before the flat storage
+        auto before = mallinfo2().uordblks;
+        QList<QHash<QString, CustomData::CustomDataItem>> hashes;
+        for (int i = 0; i < numEntries; ++i) {
+            QHash<QString, CustomData::CustomDataItem> hash;
+            for (const auto& key : keys) {
+                hash.insert(QString(key), {QString::number(i), Clock::currentDateTimeUtc()});
+            }
+            hash.insert(CustomData::LastModified, {Clock::currentDateTimeUtc().toString(), {}});
+            hashes.append(hash);
+        }
+        const auto hashUsage = (mallinfo2().uordblks - before) / numEntries;
+        hashes.clear();
+
+        before = mallinfo2().uordblks;
+#endif
+        QList<Entry*> entries;
+        for (int i = 0; i < numEntries; ++i) {
+            entries.append(new Entry());
+        }
+#ifdef HAVE_MALLINFO2
+        const auto emptyUsage = (mallinfo2().uordblks - before) / numEntries;
+        before = mallinfo2().uordblks;
+#endif
+        for (int i = 0; i < numEntries; ++i) {
+            for (const auto& key : keys) {
+                entries.at(i)->customData()->set(QString(key), QString::number(i));
+            }
+        }
+#ifdef HAVE_MALLINFO2
+        const auto itemUsage = (mallinfo2().uordblks - before) / numEntries;
+        qInfo("Heap usage per entry without custom data: %zu bytes", static_cast<size_t>(emptyUsage));
+        qInfo("Heap usage of %d custom data keys per entry: %zu bytes as QHash before, %zu bytes now",
+              keys.size(),
+              static_cast<size_t>(hashUsage),
+              static_cast<size_t>(itemUsage));
+#endif
+        qDeleteAll(entries);
+    }
+}
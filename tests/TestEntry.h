@@ -42,6 +42,8 @@ private slots:
     void testIsRecycled();
     void testMoveUpDown();
     void testPreviousParentGroup();
+    void testCustomData();
+    void benchmarkCustomDataMemory();
 };
 
 #endif // KEEPASSX_TESTENTRY_H
@@ -17,12 +17,38 @@
 
 #include "TestEntrySearcher.h"
 #include "core/Group.h"
+#include "core/MultiDatabaseSearcher.h"
 #include "core/Tools.h"
 
+#include <QSignalSpy>
 #include <QTest>
 
 QTEST_GUILESS_MAIN(TestEntrySearcher)
 
+namespace
+{
+    QSharedPointer<Database> createDatabase(const QStringList& titles)
+    {
+        auto db = QSharedPointer<Database>::create();
+        for (const auto& title : titles) {
+            auto entry = new Entry();
+            entry->setUuid(QUuid::createUuid());
+            entry->setTitle(title);
+            entry->setGroup(db->rootGroup());
+        }
+        return db;
+    }
+
+    QStringList resultTitles(const QList<MultiDatabaseSearcher::Result>& results)
+    {
+        QStringList titles;
+        for (const auto& result : results) {
+            titles << QString("%1:%2").arg(result.source).arg(result.entry->title());
+        }
+        return titles;
+    }
+} // namespace
+
 void TestEntrySearcher::init()
 {
     m_rootGroup = new Group();
@@ -394,3 +420,115 @@ void TestEntrySearcher::testUUIDSearch()
     m_searchResult = m_entrySearcher.search("uuid:" + Tools::uuidToHex(uuid1), m_rootGroup);
     QCOMPARE(m_searchResult.count(), 1);
 }
+
+void TestEntrySearcher::testMultiDatabaseSearch()
+{
+    auto db1 = createDatabase({"Mail server", "Mail", "Webmail", "Bank"});
+    auto db2 = createDatabase({"mail", "Other", "Mailing list"});
+    auto db3 = createDatabase({"Nothing"});
+
+    // Ranked by exact title, title prefix and substring, then by database order
+    auto results = MultiDatabaseSearcher::searchAll({db1, db2, db3}, "mail");
+    QCOMPARE(resultTitles(results),
+             QStringList({"0:Mail", "1:mail", "0:Mail server", "1:Mailing list", "0:Webmail"}));
+    QCOMPARE(results.first().database.data(), db1.data());
+    QCOMPARE(results.at(1).database.data(), db2.data());
+
+    results = MultiDatabaseSearcher::searchAll({db1, db2, db3}, "mail", true);
+    QCOMPARE(resultTitles(results), QStringList({"1:mail", "0:Webmail"}));
+
+    // Ranked by the parsed search terms, not by the raw search string
+    results = MultiDatabaseSearcher::searchAll({db3, db1}, "title:n");
+    QCOMPARE(resultTitles(results), QStringList({"0:Nothing", "1:Bank"}));
+    results = MultiDatabaseSearcher::searchAll({db2, db1}, "title:mail");
+    QCOMPARE(resultTitles(results),
+             QStringList({"0:mail", "1:Mail", "0:Mailing list", "1:Mail server", "1:Webmail"}));
+
+    results = MultiDatabaseSearcher::searchAll({db1}, "mail -server");
+    QCOMPARE(resultTitles(results), QStringList({"0:Mail", "0:Webmail"}));
+
+    QVERIFY(MultiDatabaseSearcher::searchAll({db1, db2}, "missing").isEmpty());
+    QVERIFY(MultiDatabaseSearcher::searchAll({}, "mail").isEmpty());
+}
+
+void TestEntrySearcher::testMultiDatabaseSearchAsync()
+{
+    auto db1 = createDatabase({"Mail", "Bank"});
+    auto db2 = createDatabase({"Webmail"});
+
+    MultiDatabaseSearcher searcher;
+    QSignalSpy finishedSpy(&searcher, SIGNAL(searchFinished()));
+
+    searcher.search({db1, db2}, "mail");
+    QVERIFY(searcher.isSearching());
+    QVERIFY(finishedSpy.wait());
+    QVERIFY(!searcher.isSearching());
+    QCOMPARE(searcher.searchString(), QString("mail"));
+    QCOMPARE(resultTitles(searcher.results()), QStringList({"0:Mail", "1:Webmail"}));
+
+    // A new search replaces the one in flight, its results never show up
+    finishedSpy.clear();
+    searcher.search({db1, db2}, "mail");
+    searcher.search({db1, db2}, "bank");
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(resultTitles(searcher.results()), QStringList({"0:Bank"}));
+
+    // Canceled searches never finish
+    finishedSpy.clear();
+    searcher.search({db1, db2}, "mail");
+    searcher.cancel();
+    QVERIFY(!searcher.isSearching());
+    QVERIFY(!finishedSpy.wait(200));
+    QVERIFY(searcher.results().isEmpty());
+
+    // An empty search string clears the results right away
+    searcher.search({db1, db2}, "  ");
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(searcher.results().isEmpty());
+
+    // Results do not keep deleted entries alive
+    searcher.search({db1, db2}, "webmail");
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(searcher.results().size(), 1);
+    delete db2->rootGroup()->entries().first();
+    QVERIFY(searcher.results().first().entry.isNull());
+}
+
+void TestEntrySearcher::benchmarkMultiDatabaseSearch()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    QList<QSharedPointer<Database>> databases;
+    for (int i = 0; i < 5; ++i) {
+        auto db = QSharedPointer<Database>::create();
+        for (int j = 0; j < 20000; ++j) {
+            auto entry = new Entry();
+            entry->setUuid(QUuid::createUuid());
+            entry->setTitle(QString("Entry %1 of database %2").arg(j).arg(i));
+            entry->setUsername(QString("user%1").arg(j % 100));
+            entry->setUrl(QString("https://site%1.example.com").arg(j % 500));
+            entry->setGroup(db->rootGroup());
+        }
+        databases << db;
+    }
+
+    QList<MultiDatabaseSearcher::Result> results;
+    QBENCHMARK_ONCE
+    {
+        results = MultiDatabaseSearcher::searchAll(databases, "url:site42.example user:user42");
+    };
+    QCOMPARE(results.size(), 5 * 20000 / 500);
+
+    MultiDatabaseSearcher searcher;
+    QSignalSpy finishedSpy(&searcher, SIGNAL(searchFinished()));
+    QBENCHMARK_ONCE
+    {
+        searcher.search(databases, "of database");
+        QVERIFY(finishedSpy.wait(60000));
+    };
+    QCOMPARE(searcher.results().size(), 5 * 20000);
+}
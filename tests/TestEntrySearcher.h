@@ -39,6 +39,9 @@ private slots:
     void testGroup();
     void testSkipProtected();
     void testUUIDSearch();
+    void testMultiDatabaseSearch();
+    void testMultiDatabaseSearchAsync();
+    void benchmarkMultiDatabaseSearch();
 
 private:
     Group* m_rootGroup;
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestExpiryIndex.h"
+#include "mock/MockClock.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+#include "core/ExpiryIndex.h"
+#include "core/Group.h"
+#include "crypto/Crypto.h"
+
+QTEST_GUILESS_MAIN(TestExpiryIndex)
+
+namespace
+{
+    MockClock* m_clock = nullptr;
+
+    Entry* newEntry(Group* group, int expiresInSeconds)
+    {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(QString("expires in %1").arg(expiresInSeconds));
+        entry->setExpiryTime(Clock::currentDateTimeUtc().addSecs(expiresInSeconds));
+        entry->setExpires(true);
+        entry->setGroup(group);
+        return entry;
+    }
+} // namespace
+
+void TestExpiryIndex::initTestCase()
+{
+    QVERIFY(Crypto::init());
+}
+
+void TestExpiryIndex::init()
+{
+    Q_ASSERT(m_clock == nullptr);
+    m_clock = new MockClock(2010, 5, 5, 10, 30, 10);
+    MockClock::setup(m_clock);
+}
+
+void TestExpiryIndex::cleanup()
+{
+    MockClock::teardown();
+    m_clock = nullptr;
+}
+
+void TestExpiryIndex::testCachedState()
+{
+    Database db;
+    auto entry = newEntry(db.rootGroup(), 60);
+    QVERIFY(!entry->isExpired());
+    QCOMPARE(db.expiryIndex()->size(), 1);
+
+    entry->setExpiryTime(Clock::currentDateTimeUtc().addSecs(-60));
+    QVERIFY(entry->isExpired());
+
+    entry->setExpires(false);
+    QVERIFY(!entry->isExpired());
+
+    // Entries are expired once the expiry time has passed
+    entry->setExpiryTime(Clock::currentDateTimeUtc());
+    entry->setExpires(true);
+    QVERIFY(!entry->isExpired());
+    m_clock->advanceSecond(1);
+    QVERIFY(entry->isExpired());
+
+    // The state follows the clock when it moves backwards
+    m_clock->advanceSecond(-10);
+    QVERIFY(!entry->isExpired());
+    m_clock->advanceSecond(10);
+    QVERIFY(entry->isExpired());
+
+    auto group = new Group();
+    group->setUuid(QUuid::createUuid());
+    group->setParent(db.rootGroup());
+    QVERIFY(!group->isExpired());
+    group->setExpiryTime(Clock::currentDateTimeUtc().addSecs(-1));
+    group->setExpires(true);
+    QVERIFY(group->isExpired());
+}
+
+void TestExpiryIndex::testExpiredSignals()
+{
+    Database db;
+    auto entry1 = newEntry(db.rootGroup(), 10);
+    auto entry2 = newEntry(db.rootGroup(), 20);
+    auto group = new Group();
+    group->setUuid(QUuid::createUuid());
+    group->setParent(db.rootGroup());
+    group->setExpiryTime(Clock::currentDateTimeUtc().addSecs(15));
+    group->setExpires(true);
+
+    QSignalSpy spyEntryExpired(&db, &Database::entryExpired);
+    QSignalSpy spyGroupExpired(&db, &Database::groupExpired);
+    QSignalSpy spyDataChanged(entry1, &Entry::entryDataChanged);
+
+    // Nothing is due yet
+    db.expiryIndex()->processExpired();
+    QCOMPARE(spyEntryExpired.count(), 0);
+
+    m_clock->advanceSecond(11);
+    db.expiryIndex()->processExpired();
+    QCOMPARE(spyEntryExpired.count(), 1);
+    QCOMPARE(spyEntryExpired.first().first().value<Entry*>(), entry1);
+    QCOMPARE(spyDataChanged.count(), 1);
+    QVERIFY(entry1->isExpired());
+    QVERIFY(!entry2->isExpired());
+    QVERIFY(!group->isExpired());
+
+    m_clock->advanceSecond(10);
+    db.expiryIndex()->processExpired();
+    QCOMPARE(spyEntryExpired.count(), 2);
+    QCOMPARE(spyGroupExpired.count(), 1);
+    QCOMPARE(spyGroupExpired.first().first().value<Group*>(), group);
+    QVERIFY(entry2->isExpired());
+    QVERIFY(group->isExpired());
+    QCOMPARE(db.expiryIndex()->size(), 0);
+
+    // Changed expiry times are not reported with the old time
+    auto entry3 = newEntry(db.rootGroup(), 10);
+    entry3->setExpiryTime(Clock::currentDateTimeUtc().addSecs(100));
+    m_clock->advanceSecond(10);
+    db.expiryIndex()->processExpired();
+    QCOMPARE(spyEntryExpired.count(), 2);
+    QVERIFY(!entry3->isExpired());
+
+    // The timer triggers on its own as well
+    entry3->setExpiryTime(Clock::currentDateTimeUtc().addSecs(1));
+    m_clock->advanceSecond(2);
+    QTRY_COMPARE(spyEntryExpired.count(), 3);
+    QVERIFY(entry3->isExpired());
+}
+
+void TestExpiryIndex::testDetachedEntry()
+{
+    Entry entry;
+    entry.setExpiryTime(Clock::currentDateTimeUtc().addSecs(10));
+    entry.setExpires(true);
+    QVERIFY(!entry.isExpired());
+    QVERIFY(entry.willExpireInDays(1));
+
+    // Entries without a database are checked against the clock
+    m_clock->advanceSecond(11);
+    QVERIFY(entry.isExpired());
+}
+
+void TestExpiryIndex::testMoveBetweenDatabases()
+{
+    Database db1;
+    Database db2;
+    auto entry = newEntry(db1.rootGroup(), 10);
+    QCOMPARE(db1.expiryIndex()->size(), 1);
+
+    entry->setGroup(db2.rootGroup());
+    QCOMPARE(db2.expiryIndex()->size(), 1);
+
+    QSignalSpy spyExpired1(&db1, &Database::entryExpired);
+    QSignalSpy spyExpired2(&db2, &Database::entryExpired);
+    m_clock->advanceSecond(11);
+    db1.expiryIndex()->processExpired();
+    db2.expiryIndex()->processExpired();
+    QCOMPARE(spyExpired1.count(), 0);
+    QCOMPARE(spyExpired2.count(), 1);
+    QVERIFY(entry->isExpired());
+
+    // Moving a whole group schedules its entries in the new database
+    auto group = new Group();
+    group->setUuid(QUuid::createUuid());
+    newEntry(group, 10);
+    group->setParent(db1.rootGroup());
+    m_clock->advanceSecond(11);
+    db1.expiryIndex()->processExpired();
+    QCOMPARE(spyExpired1.count(), 1);
+}
+
+void TestExpiryIndex::testWillExpireInDays()
+{
+    Database db;
+    QList<Entry*> entries;
+    for (int i = 1; i <= 100; ++i) {
+        entries.append(newEntry(db.rootGroup(), i * 3600));
+    }
+
+    const auto now = Clock::currentDateTimeUtc();
+    entries[0]->setExpires(false);
+    entries[1]->setExpiryTime(now.addSecs(60));
+    entries[1]->setExpiryTime(now.addSecs(120));
+
+    QVERIFY(entries[1]->willExpireInDays(1));
+    QVERIFY(!entries[0]->willExpireInDays(1));
+    QVERIFY(!entries[99]->willExpireInDays(4));
+    QVERIFY(entries[99]->willExpireInDays(5));
+    QVERIFY(!entries[1]->willExpireInDays(0));
+}
+
+void TestExpiryIndex::testCompact()
+{
+    Database db;
+    auto entry = newEntry(db.rootGroup(), 3600);
+    for (int i = 0; i < 5000; ++i) {
+        entry->setExpiryTime(Clock::currentDateTimeUtc().addSecs(3600 + i));
+    }
+
+    // Outdated items are dropped once the heap grows and the entry is only reported once
+    QVERIFY(db.expiryIndex()->size() <= 1024);
+    QSignalSpy spyExpired(&db, &Database::entryExpired);
+    m_clock->advanceSecond(3600 + 5000);
+    db.expiryIndex()->processExpired();
+    QCOMPARE(spyExpired.count(), 1);
+}
@@ -472,6 +472,64 @@ void TestGroup::testCopyCustomIcons()
     QCOMPARE(metaTarget->customIcon(group2Icon), icon1);
 }
 
+void TestGroup::testCustomIconUsage()
+{
+    QScopedPointer<Database> db(new Database());
+    auto metadata = db->metadata();
+
+    QUuid icon1 = QUuid::createUuid();
+    QUuid icon2 = QUuid::createUuid();
+    QUuid icon3 = QUuid::createUuid();
+    metadata->addCustomIcon(icon1, QByteArray("icon 1"));
+    metadata->addCustomIcon(icon2, QByteArray("icon 2"));
+    metadata->addCustomIcon(icon3, QByteArray("icon 3"));
+
+    auto group = new Group();
+    group->setIcon(icon1);
+    auto entry = new Entry();
+    entry->setGroup(group);
+    entry->setIcon(icon1);
+
+    // Nothing is registered while the group is not part of the database
+    QCOMPARE(metadata->customIconUseCount(icon1), 0);
+
+    group->setParent(db->rootGroup());
+    QCOMPARE(metadata->customIconUseCount(icon1), 2);
+    QVERIFY(metadata->customIconUsage(icon1).groups.contains(group));
+    QVERIFY(metadata->customIconUsage(icon1).entries.contains(entry));
+
+    // History items are tracked separately and don't count as use
+    entry->beginUpdate();
+    entry->setIcon(icon2);
+    entry->endUpdate();
+    QCOMPARE(metadata->customIconUseCount(icon1), 1);
+    QCOMPARE(metadata->customIconUseCount(icon2), 1);
+    QCOMPARE(metadata->customIconUsage(icon1).historyItems.size(), 1);
+    QCOMPARE(metadata->unusedCustomIcons(), QList<QUuid>() << icon3);
+
+    group->setIcon(Group::DefaultIconNumber);
+    QCOMPARE(metadata->customIconUseCount(icon1), 0);
+    QCOMPARE(metadata->unusedCustomIcons(), QList<QUuid>() << icon1 << icon3);
+
+    // Moving to another database moves the registrations along
+    QScopedPointer<Database> dbTarget(new Database());
+    group->setParent(dbTarget->rootGroup());
+    QCOMPARE(metadata->customIconUseCount(icon2), 0);
+    QVERIFY(metadata->customIconUsage(icon1).historyItems.isEmpty());
+    QCOMPARE(dbTarget->metadata()->customIconUseCount(icon2), 1);
+    QCOMPARE(dbTarget->metadata()->customIconUsage(icon1).historyItems.size(), 1);
+
+    // Deleted items are removed from the index
+    delete entry;
+    QVERIFY(dbTarget->metadata()->customIconUsage(icon1).isEmpty());
+    QVERIFY(dbTarget->metadata()->customIconUsage(icon2).isEmpty());
+
+    metadata->removeCustomIcons(metadata->unusedCustomIcons());
+    QVERIFY(metadata->customIconsOrder().isEmpty());
+    QVERIFY(!metadata->hasCustomIcon(icon1));
+    QVERIFY(!metadata->hasCustomIcon(icon3));
+}
+
 void TestGroup::testFindEntry()
 {
     QScopedPointer<Database> db(new Database());
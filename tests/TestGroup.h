@@ -36,6 +36,7 @@ private slots:
     void testCopyCustomIcon();
     void testClone();
     void testCopyCustomIcons();
+    void testCustomIconUsage();
     void testFindEntry();
     void testFindGroupByPath();
     void testPrint();
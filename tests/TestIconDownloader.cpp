@@ -1,12 +1,127 @@
 #include "TestIconDownloader.h"
 
+#include <QBuffer>
+#include <QFile>
+#include <QImage>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
 #include <QTest>
 
 #include "core/Config.h"
+#include "core/Database.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "crypto/Crypto.h"
+#include "gui/IconDownloadQueue.h"
 #include "gui/IconDownloader.h"
 
 QTEST_GUILESS_MAIN(TestIconDownloader)
 
+namespace
+{
+    // Minimal local HTTP server answering every request with the same PNG icon
+    class FaviconServer
+    {
+    public:
+        explicit FaviconServer(int maxAge)
+            : m_maxAge(maxAge)
+        {
+            QImage image(16, 16, QImage::Format_ARGB32);
+            image.fill(Qt::red);
+            QBuffer buffer(&m_icon);
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "PNG");
+
+            QObject::connect(&m_server, &QTcpServer::newConnection, [this] {
+                while (auto socket = m_server.nextPendingConnection()) {
+                    QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket] { serve(socket); });
+                    QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                }
+            });
+            m_server.listen(QHostAddress::Any);
+        }
+
+        QString url(const QString& host, const QString& path) const
+        {
+            return QString("http://%1:%2%3").arg(host, QString::number(m_server.serverPort()), path);
+        }
+
+        int requests = 0;
+        int notModified = 0;
+
+    private:
+        void serve(QTcpSocket* socket)
+        {
+            auto request = socket->property("request").toByteArray() + socket->readAll();
+            if (!request.contains("\r\n\r\n")) {
+                socket->setProperty("request", request);
+                return;
+            }
+
+            ++requests;
+            QByteArray response;
+            if (request.contains("If-None-Match: \"v1\"")) {
+                ++notModified;
+                response = "HTTP/1.1 304 Not Modified\r\n";
+            } else {
+                response = "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\n";
+                response += "Content-Length: " + QByteArray::number(m_icon.size()) + "\r\n";
+            }
+            response += "ETag: \"v1\"\r\nCache-Control: max-age=" + QByteArray::number(m_maxAge) + "\r\n";
+            response += "Connection: close\r\n\r\n";
+            if (!response.startsWith("HTTP/1.1 304")) {
+                response += m_icon;
+            }
+            socket->write(response);
+            socket->disconnectFromHost();
+        }
+
+        QTcpServer m_server;
+        QByteArray m_icon;
+        int m_maxAge;
+    };
+
+    QSharedPointer<Database> createDatabase(const QStringList& urls)
+    {
+        auto db = QSharedPointer<Database>::create();
+        for (const auto& url : urls) {
+            auto entry = new Entry();
+            entry->setUuid(QUuid::createUuid());
+            entry->setUrl(url);
+            entry->setGroup(db->rootGroup());
+        }
+        return db;
+    }
+
+    bool runQueue(const QSharedPointer<Database>& db)
+    {
+        IconDownloadQueue queue;
+        queue.setDatabase(db);
+        for (auto entry : db->rootGroup()->entries()) {
+            queue.addEntry(entry);
+        }
+        QSignalSpy spyFinished(&queue, &IconDownloadQueue::finished);
+        queue.start();
+        return spyFinished.count() > 0 || spyFinished.wait(10000);
+    }
+} // namespace
+
+void TestIconDownloader::initTestCase()
+{
+    QVERIFY(Crypto::init());
+    Config::createTempFileInstance();
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestIconDownloader::init()
+{
+    config()->set(Config::Security_IconDownloadFallback, false);
+    config()->set(Config::FaviconDiskCache, true);
+    IconDownloader::clearCache();
+}
+
 void TestIconDownloader::testIconDownloader()
 {
     QFETCH(QString, url);
@@ -81,3 +196,126 @@ void TestIconDownloader::testIconDownloader_data()
         << "https://test.com/rel-path/"
         << QStringList{"https://test.com/rel-path/favicon.ico", "https://test.com/favicon.ico"};
 }
+
+void TestIconDownloader::testDomainKey()
+{
+    QCOMPARE(IconDownloader::domainKey("https://login.keepassxc.org/path?query"), QString("keepassxc.org"));
+    QCOMPARE(IconDownloader::domainKey("keepassxc.org"), QString("keepassxc.org"));
+    QCOMPARE(IconDownloader::domainKey("https://de.Login.KeePassXC.co.uk"), QString("keepassxc.co.uk"));
+    QCOMPARE(IconDownloader::domainKey("https://keepassxc.org:8080"), QString("keepassxc.org:8080"));
+    QCOMPARE(IconDownloader::domainKey("https://134.130.155.184/test"), QString("134.130.155.184"));
+    QCOMPARE(IconDownloader::domainKey("https:///register"), QString());
+    QCOMPARE(IconDownloader::domainKey(""), QString());
+}
+
+void TestIconDownloader::testDownloadQueue()
+{
+    FaviconServer server(3600);
+    QStringList urls;
+    for (int i = 0; i < 100; ++i) {
+        urls << server.url(i % 2 ? "127.0.0.1" : "localhost", QString("/page%1").arg(i));
+    }
+    auto db = createDatabase(urls);
+
+    IconDownloadQueue queue;
+    queue.setDatabase(db);
+    for (auto entry : db->rootGroup()->entries()) {
+        queue.addEntry(entry);
+    }
+    QCOMPARE(queue.count(), 2);
+
+    QSignalSpy spyDomain(&queue, &IconDownloadQueue::domainFinished);
+    QSignalSpy spyFinished(&queue, &IconDownloadQueue::finished);
+    queue.start();
+    QVERIFY(spyFinished.wait(10000));
+    QCOMPARE(spyDomain.count(), 2);
+    QCOMPARE(queue.finishedCount(), 2);
+    QVERIFY(!queue.isActive());
+
+    // One request per domain, and the identical icons are only added once
+    QCOMPARE(server.requests, 2);
+    QCOMPARE(db->metadata()->customIconsOrder().size(), 1);
+    const auto iconUuid = db->metadata()->customIconsOrder().first();
+    for (auto entry : db->rootGroup()->entries()) {
+        QCOMPARE(entry->iconUuid(), iconUuid);
+    }
+
+    // A fresh cached icon does not need any request
+    auto db2 = createDatabase(urls);
+    QVERIFY(runQueue(db2));
+    QCOMPARE(server.requests, 2);
+    QCOMPARE(db2->metadata()->customIconsOrder().size(), 1);
+    QVERIFY(!db2->rootGroup()->entries().first()->iconUuid().isNull());
+}
+
+void TestIconDownloader::testCacheRevalidation()
+{
+    FaviconServer server(0);
+    auto db = createDatabase({server.url("localhost", "/"), server.url("127.0.0.1", "/")});
+    QVERIFY(runQueue(db));
+    QCOMPARE(server.requests, 2);
+    QCOMPARE(server.notModified, 0);
+
+    // Expired icons are revalidated with their ETag instead of downloaded again
+    auto db2 = createDatabase({server.url("localhost", "/"), server.url("127.0.0.1", "/")});
+    QVERIFY(runQueue(db2));
+    QCOMPARE(server.requests, 4);
+    QCOMPARE(server.notModified, 2);
+    for (auto entry : db2->rootGroup()->entries()) {
+        QVERIFY(!entry->iconUuid().isNull());
+    }
+
+    // The cache does not reveal where the icons came from
+    QFile file(IconDownloader::cachePath(IconDownloader::domainKey(server.url("localhost", "/"))));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const auto cached = file.readAll();
+    QVERIFY(!cached.contains("localhost"));
+}
+
+void TestIconDownloader::testCacheDisabled()
+{
+    config()->set(Config::FaviconDiskCache, false);
+
+    FaviconServer server(3600);
+    auto db = createDatabase({server.url("localhost", "/")});
+    QVERIFY(runQueue(db));
+    QCOMPARE(server.requests, 1);
+    QVERIFY(!QFile::exists(IconDownloader::cachePath(IconDownloader::domainKey(server.url("localhost", "/")))));
+
+    // Without the disk cache every run downloads the icon again
+    auto db2 = createDatabase({server.url("localhost", "/")});
+    QVERIFY(runQueue(db2));
+    QCOMPARE(server.requests, 2);
+}
+
+void TestIconDownloader::benchmarkDownloadQueue()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    // 2000 entries spread over 20 domains (two host names on ten ports)
+    QList<QSharedPointer<FaviconServer>> servers;
+    for (int i = 0; i < 10; ++i) {
+        servers.append(QSharedPointer<FaviconServer>::create(3600));
+    }
+    QStringList urls;
+    for (int i = 0; i < 2000; ++i) {
+        const auto& server = servers.at(i % servers.size());
+        urls << server->url((i / servers.size()) % 2 ? "127.0.0.1" : "localhost", QString("/entry%1").arg(i));
+    }
+    auto db = createDatabase(urls);
+
+    QBENCHMARK_ONCE
+    {
+        QVERIFY(runQueue(db));
+    };
+
+    int requests = 0;
+    for (const auto& server : servers) {
+        requests += server->requests;
+    }
+    QCOMPARE(requests, 20);
+}
@@ -27,8 +27,15 @@ class TestIconDownloader : public QObject
     Q_OBJECT
 
 private slots:
+    void initTestCase();
+    void init();
     void testIconDownloader();
     void testIconDownloader_data();
+    void testDomainKey();
+    void testDownloadQueue();
+    void testCacheRevalidation();
+    void testCacheDisabled();
+    void benchmarkDownloadQueue();
 };
 
 #endif // KEEPASSXC_TESTICONDOWNLOADER_HPP
@@ -19,6 +19,7 @@
 
 #include "config-keepassx-tests.h"
 #include "core/Metadata.h"
+#include "crypto/Random.h"
 #include "format/KdbxXmlReader.h"
 #include "format/KdbxXmlWriter.h"
 #include "format/KeePass2.h"
@@ -28,6 +29,7 @@
 #include "keys/PasswordKey.h"
 #include "mock/MockChallengeResponseKey.h"
 #include "mock/MockClock.h"
+#include "streams/qtiocompressor.h"
 #include <QTest>
 
 int main(int argc, char* argv[])
@@ -605,4 +607,95 @@ void TestKdbx4Format::testCustomData()
     auto* newEntry = newDb->rootGroup()->children()[0]->entries()[0];
     QCOMPARE(newEntry->customData()->value(customDataKey1), customData1);
     QCOMPARE(newEntry->customData()->value(customDataKey2), customData2);
+
+    // The reader shares one string for each key between all items it reads
+    const auto groupKeys = newGroup->customData()->keys();
+    const auto entryKeys = newEntry->customData()->keys();
+    QCOMPARE(groupKeys.at(groupKeys.indexOf(customDataKey1)).constData(),
+             entryKeys.at(entryKeys.indexOf(customDataKey1)).constData());
+    QCOMPARE(groupKeys.at(groupKeys.indexOf(customDataKey2)).constData(),
+             entryKeys.at(entryKeys.indexOf(customDataKey2)).constData());
+}
+
+void TestKdbx4Format::testIncompressibleAttachments()
+{
+    const auto text = QByteArray("Lorem ipsum dolor sit amet, consectetur adipiscing elit. ").repeated(20000);
+    const auto random = randomGen()->randomArray(1024 * 1024);
+
+    // Switching the level mid-stream keeps a standard gzip stream
+    QBuffer compressed;
+    QtIOCompressor compressor(&compressed);
+    compressor.setStreamFormat(QtIOCompressor::GzipFormat);
+    QVERIFY(compressor.open(QIODevice::WriteOnly));
+    QCOMPARE(compressor.compressionLevel(), 6);
+    QCOMPARE(compressor.write(text), text.size());
+    QVERIFY(compressor.setCompressionLevel(0));
+    QCOMPARE(compressor.compressionLevel(), 0);
+    QCOMPARE(compressor.write(random), random.size());
+    QVERIFY(compressor.setCompressionLevel(0));
+    QVERIFY(compressor.setCompressionLevel(6));
+    QCOMPARE(compressor.write(text), text.size());
+    compressor.close();
+    QVERIFY(compressed.size() < random.size() + text.size() / 10);
+
+    QtIOCompressor decompressor(&compressed);
+    decompressor.setStreamFormat(QtIOCompressor::GzipFormat);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QCOMPARE(decompressor.readAll(), text + random + text);
+
+    // Database attachments round-trip whether they are stored or compressed
+    QScopedPointer<Database> db(new Database());
+    db->changeKdf(fastKdf(KeePass2::uuidToKdf(KeePass2::KDF_ARGON2ID)));
+    db->setKey(QSharedPointer<CompositeKey>::create());
+    auto entry = new Entry();
+    entry->setUuid(QUuid::createUuid());
+    entry->attachments()->set("text.txt", text);
+    entry->attachments()->set("archive.zip", random);
+    entry->attachments()->set("small.bin", random.left(1024));
+    entry->setGroup(db->rootGroup());
+
+    QBuffer buffer;
+    buffer.open(QBuffer::ReadWrite);
+    KeePass2Writer writer;
+    QVERIFY(writer.writeDatabase(&buffer, db.data()));
+    QVERIFY(buffer.size() < random.size() + text.size() / 10);
+
+    buffer.seek(0);
+    KeePass2Reader reader;
+    auto db2 = QSharedPointer<Database>::create();
+    reader.readDatabase(&buffer, QSharedPointer<CompositeKey>::create(), db2.data());
+    QVERIFY(!reader.hasError());
+    auto attachments = db2->rootGroup()->findEntryByUuid(entry->uuid())->attachments();
+    QCOMPARE(attachments->value("text.txt"), text);
+    QCOMPARE(attachments->value("archive.zip"), random);
+    QCOMPARE(attachments->value("small.bin"), random.left(1024));
+}
+
+void TestKdbx4Format::benchmarkSaveMixedAttachments()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    // Mix of already compressed attachments and compressible documents
+    QScopedPointer<Database> db(new Database());
+    db->changeKdf(fastKdf(KeePass2::uuidToKdf(KeePass2::KDF_ARGON2ID)));
+    db->setKey(QSharedPointer<CompositeKey>::create());
+    const auto text = QByteArray("Lorem ipsum dolor sit amet, consectetur adipiscing elit. ").repeated(10000);
+    for (int i = 0; i < 50; ++i) {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->attachments()->set("archive.zip", randomGen()->randomArray(2 * 1024 * 1024));
+        entry->attachments()->set("notes.txt", text + QByteArray::number(i));
+        entry->setGroup(db->rootGroup());
+    }
+
+    QBENCHMARK
+    {
+        QBuffer buffer;
+        buffer.open(QBuffer::WriteOnly);
+        KeePass2Writer writer;
+        QVERIFY(writer.writeDatabase(&buffer, db.data()));
+    }
 }
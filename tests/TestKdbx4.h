@@ -66,6 +66,8 @@ private slots:
     void testUpgradeMasterKeyIntegrity_data();
     void testAttachmentIndexStability();
     void testCustomData();
+    void testIncompressibleAttachments();
+    void benchmarkSaveMixedAttachments();
 };
 
 #endif // KEEPASSXC_TEST_KDBX4_H
@@ -21,9 +21,15 @@
 #include <QTest>
 
 #include "config-keepassx-tests.h"
+#include "core/Endian.h"
 #include "core/Group.h"
 #include "core/Metadata.h"
 #include "crypto/Crypto.h"
+#include "crypto/CryptoHash.h"
+#include "crypto/Random.h"
+#include "crypto/SymmetricCipher.h"
+#include "crypto/kdf/AesKdf.h"
+#include "format/KeePass1.h"
 #include "format/KeePass1Reader.h"
 #include "format/KeePass2Reader.h"
 #include "format/KeePass2Writer.h"
@@ -236,6 +242,86 @@ void TestKeePass1Reader::testCP1252Password()
     QCOMPARE(db->rootGroup()->children().at(0)->name(), name);
 }
 
+void TestKeePass1Reader::testParallelCbcDecrypt()
+{
+    const QList<SymmetricCipher::Mode> modes = {SymmetricCipher::Aes256_CBC, SymmetricCipher::Twofish_CBC};
+    // Large enough to be split into several segments, not a multiple of the block size before padding
+    const QByteArray plaintext = randomGen()->randomArray(1024 * 1024 + 37);
+
+    for (auto mode : modes) {
+        const QByteArray key = randomGen()->randomArray(SymmetricCipher::keySize(mode));
+        const QByteArray iv = randomGen()->randomArray(SymmetricCipher::ivSize(mode));
+
+        SymmetricCipher cipher;
+        QVERIFY(cipher.init(mode, SymmetricCipher::Encrypt, key, iv));
+        QByteArray ciphertext = plaintext;
+        QVERIFY(cipher.finish(ciphertext));
+        QCOMPARE(ciphertext.size() % SymmetricCipher::blockSize(mode), 0);
+
+        for (int threads : {1, 2, 3, 8}) {
+            QByteArray data = ciphertext;
+            QString error;
+            QVERIFY2(SymmetricCipher::decryptCbcParallel(mode, key, iv, data, &error, threads), qPrintable(error));
+            QCOMPARE(data, plaintext);
+        }
+
+        // The ciphertext must be a whole number of blocks
+        QByteArray truncated = ciphertext.left(ciphertext.size() - 1);
+        QString error;
+        QVERIFY(!SymmetricCipher::decryptCbcParallel(mode, key, iv, truncated, &error));
+        QVERIFY(!error.isEmpty());
+    }
+
+    QByteArray data(32, '\0');
+    QVERIFY(!SymmetricCipher::decryptCbcParallel(
+        SymmetricCipher::ChaCha20, QByteArray(32, '\0'), QByteArray(12, '\0'), data));
+}
+
+void TestKeePass1Reader::testGeneratedDatabase()
+{
+    QBuffer buffer;
+    buffer.setData(generateDatabase(3, 4, "masterpw"));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    KeePass1Reader reader;
+    auto db = reader.readDatabase(&buffer, "masterpw", nullptr);
+    QVERIFY(db);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(db->rootGroup()->children().size(), 3);
+
+    auto group = db->rootGroup()->children().at(1);
+    QCOMPARE(group->name(), QString("Group 1"));
+    QCOMPARE(group->entries().size(), 4);
+    QCOMPARE(group->entries().at(2)->title(), QString("Entry 1-2"));
+    QCOMPARE(group->entries().at(2)->username(), QString("user12"));
+    QCOMPARE(group->entries().at(2)->password(), QString("password-1-2"));
+    QCOMPARE(group->entries().at(2)->url(), QString("https://example.com/1/2"));
+
+    buffer.seek(0);
+    QVERIFY(!reader.readDatabase(&buffer, "wrongpw", nullptr));
+    QVERIFY(reader.hasError());
+}
+
+void TestKeePass1Reader::benchmarkReadLargeDatabase()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    const QByteArray data = generateDatabase(100, 500, "masterpw");
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        KeePass1Reader reader;
+        auto db = reader.readDatabase(&buffer, "masterpw", nullptr);
+        QVERIFY(db);
+    }
+}
+
 void TestKeePass1Reader::cleanupTestCase()
 {
 }
@@ -274,3 +360,71 @@ void TestKeePass1Reader::reopenDatabase(QSharedPointer<Database> db,
     QVERIFY(reader.readDatabase(&buffer, key, newDb.data()));
     QVERIFY(!reader.hasError());
 }
+
+/**
+ * Build an AES encrypted KeePass 1 database in memory with the given number
+ * of top level groups, each holding entriesPerGroup entries.
+ */
+QByteArray TestKeePass1Reader::generateDatabase(int numGroups, int entriesPerGroup, const QString& password)
+{
+    auto appendField = [](QByteArray& out, quint16 type, const QByteArray& data) {
+        out.append(Endian::sizedIntToBytes<quint16>(type, KeePass1::BYTEORDER));
+        out.append(Endian::sizedIntToBytes<quint32>(static_cast<quint32>(data.size()), KeePass1::BYTEORDER));
+        out.append(data);
+    };
+    auto stringField = [](const QString& str) { return str.toUtf8().append('\0'); };
+
+    QByteArray content;
+    for (int g = 0; g < numGroups; ++g) {
+        appendField(content, 0x0001, Endian::sizedIntToBytes<quint32>(g + 1, KeePass1::BYTEORDER));
+        appendField(content, 0x0002, stringField(QString("Group %1").arg(g)));
+        appendField(content, 0x0008, Endian::sizedIntToBytes<quint16>(0, KeePass1::BYTEORDER));
+        appendField(content, 0xFFFF, {});
+    }
+    for (int g = 0; g < numGroups; ++g) {
+        for (int e = 0; e < entriesPerGroup; ++e) {
+            appendField(content, 0x0001, randomGen()->randomArray(16));
+            appendField(content, 0x0002, Endian::sizedIntToBytes<quint32>(g + 1, KeePass1::BYTEORDER));
+            appendField(content, 0x0004, stringField(QString("Entry %1-%2").arg(g).arg(e)));
+            appendField(content, 0x0005, stringField(QString("https://example.com/%1/%2").arg(g).arg(e)));
+            appendField(content, 0x0006, stringField(QString("user%1%2").arg(g).arg(e)));
+            appendField(content, 0x0007, stringField(QString("password-%1-%2").arg(g).arg(e)));
+            appendField(content, 0x0008, stringField(QString("Notes for entry %1 in group %2").arg(e).arg(g)));
+            appendField(content, 0xFFFF, {});
+        }
+    }
+
+    const QByteArray masterSeed = randomGen()->randomArray(16);
+    const QByteArray iv = randomGen()->randomArray(16);
+    const QByteArray transformSeed = randomGen()->randomArray(32);
+    const int rounds = 10;
+
+    AesKdf kdf(true);
+    kdf.setSeed(transformSeed);
+    kdf.setRounds(rounds);
+    QByteArray transformedKey;
+    kdf.transform(CryptoHash::hash(password.toLatin1(), CryptoHash::Sha256), transformedKey);
+    const QByteArray finalKey = CryptoHash::hash(masterSeed + transformedKey, CryptoHash::Sha256);
+
+    QByteArray encrypted = content;
+    SymmetricCipher cipher;
+    if (!cipher.init(SymmetricCipher::Aes256_CBC, SymmetricCipher::Encrypt, finalKey, iv)
+        || !cipher.finish(encrypted)) {
+        return {};
+    }
+
+    QByteArray out;
+    out.append(Endian::sizedIntToBytes<quint32>(KeePass1::SIGNATURE_1, KeePass1::BYTEORDER));
+    out.append(Endian::sizedIntToBytes<quint32>(KeePass1::SIGNATURE_2, KeePass1::BYTEORDER));
+    out.append(Endian::sizedIntToBytes<quint32>(KeePass1::Rijndael, KeePass1::BYTEORDER));
+    out.append(Endian::sizedIntToBytes<quint32>(KeePass1::FILE_VERSION, KeePass1::BYTEORDER));
+    out.append(masterSeed);
+    out.append(iv);
+    out.append(Endian::sizedIntToBytes<quint32>(numGroups, KeePass1::BYTEORDER));
+    out.append(Endian::sizedIntToBytes<quint32>(numGroups * entriesPerGroup, KeePass1::BYTEORDER));
+    out.append(CryptoHash::hash(content, CryptoHash::Sha256));
+    out.append(transformSeed);
+    out.append(Endian::sizedIntToBytes<quint32>(rounds, KeePass1::BYTEORDER));
+    out.append(encrypted);
+    return out;
+}
@@ -40,11 +40,15 @@ private slots:
     void testCompositeKey();
     void testTwofish();
     void testCP1252Password();
+    void testParallelCbcDecrypt();
+    void testGeneratedDatabase();
+    void benchmarkReadLargeDatabase();
     void cleanupTestCase();
 
 private:
     static QDateTime genDT(int year, int month, int day, int hour, int min);
     static void reopenDatabase(QSharedPointer<Database> db, const QString& password, const QString& keyfileName);
+    static QByteArray generateDatabase(int numGroups, int entriesPerGroup, const QString& password);
 
     QSharedPointer<Database> m_db;
 };
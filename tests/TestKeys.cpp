@@ -28,6 +28,7 @@
 #include "crypto/Crypto.h"
 #include "crypto/CryptoHash.h"
 #include "crypto/kdf/AesKdf.h"
+#include "crypto/kdf/Argon2Kdf.h"
 #include "format/KeePass2Reader.h"
 #include "format/KeePass2Writer.h"
 #include "keys/CompositeKey.h"
@@ -246,6 +247,37 @@ void TestKeys::benchmarkTransformKey()
     };
 }
 
+void TestKeys::testArgon2Transform()
+{
+    // Reference vectors of the Argon2 test suite (version 0x13, t=2, m=64 MiB, p=1)
+    Argon2Kdf kdf(Argon2Kdf::Type::Argon2id);
+    QVERIFY(kdf.setVersion(0x13));
+    QVERIFY(kdf.setSeed("somesalt"));
+    QVERIFY(kdf.setRounds(2));
+    QVERIFY(kdf.setMemory(1 << 16));
+    QVERIFY(kdf.setParallelism(1));
+
+    QByteArray result;
+    QVERIFY(kdf.transform("password", result));
+    QCOMPARE(result.toHex(), QByteArray("09316115d5cf24ed5a15a31a3ba326e5cf32edc24702987c02b6566f61913cf7"));
+
+    Argon2Kdf kdfD(Argon2Kdf::Type::Argon2d);
+    QVERIFY(kdfD.setVersion(0x13));
+    QVERIFY(kdfD.setSeed("somesalt"));
+    QVERIFY(kdfD.setRounds(2));
+    QVERIFY(kdfD.setMemory(1 << 16));
+    QVERIFY(kdfD.setParallelism(1));
+    QVERIFY(kdfD.transform("password", result));
+    QCOMPARE(result.toHex(), QByteArray("955e5d5b163a1b60bba35fc36d0496474fba4f6b59ad53628666f07fb2f93eaf"));
+
+    // Repeated transforms give the same result
+    QByteArray repeated;
+    QVERIFY(kdfD.transform("password", repeated));
+    QCOMPARE(repeated, result);
+    QVERIFY(kdfD.transform("other", repeated));
+    QVERIFY(repeated != result);
+}
+
 void TestKeys::testCompositeKeyComponents()
 {
     auto passwordKeyEnc = QSharedPointer<PasswordKey>::create("password");
@@ -36,6 +36,7 @@ private slots:
     void testFileKeyError();
     void testCompositeKeyComponents();
     void benchmarkTransformKey();
+    void testArgon2Transform();
 };
 
 #endif // KEEPASSX_TESTKEYS_H
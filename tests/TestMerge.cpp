@@ -1452,6 +1452,51 @@ void TestMerge::testMergeModified()
     QTRY_VERIFY(!modifiedSignalSpy.empty());
 }
 
+void TestMerge::benchmarkMergeLargeDatabases()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    QScopedPointer<Database> dbDestination(new Database());
+    for (int i = 0; i < 20; ++i) {
+        auto group = new Group();
+        group->setUuid(QUuid::createUuid());
+        group->setName(QString("group%1").arg(i));
+        group->setParent(dbDestination->rootGroup());
+        for (int j = 0; j < 1000; ++j) {
+            auto entry = new Entry();
+            entry->setUuid(QUuid::createUuid());
+            entry->setTitle(QString("entry%1").arg(j));
+            entry->setPassword(QString("password%1").arg(j));
+            entry->setTags("tag1;tag2");
+            entry->setGroup(group);
+        }
+    }
+
+    QScopedPointer<Database> dbSource(
+        createTestDatabaseStructureClone(dbDestination.data(), Entry::CloneNoFlags, Group::CloneIncludeEntries));
+    m_clock->advanceSecond(1);
+    for (auto entry : dbSource->rootGroup()->entriesRecursive()) {
+        entry->setNotes("changed");
+    }
+    QCOMPARE(dbSource->rootGroup()->entriesRecursive().size(), 20000);
+
+    // All changes of the merge are reported in a single notification
+    dbDestination->markAsClean();
+    QSignalSpy spyModified(dbDestination.data(), SIGNAL(modified()));
+    QStringList changes;
+    QBENCHMARK_ONCE
+    {
+        Merger merger(dbSource.data(), dbDestination.data());
+        changes = merger.merge();
+    }
+    QVERIFY(changes.size() >= 20000);
+    QTRY_COMPARE(spyModified.count(), 1);
+}
+
 Database* TestMerge::createTestDatabase()
 {
     auto db = new Database();
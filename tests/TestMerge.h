@@ -56,6 +56,7 @@ private slots:
     void testDeletedGroup();
     void testDeletedRevertedEntry();
     void testDeletedRevertedGroup();
+    void benchmarkMergeLargeDatabases();
 
 private:
     Database* createTestDatabase();
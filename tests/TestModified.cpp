@@ -21,6 +21,7 @@
 #include <QSignalSpy>
 #include <QTest>
 
+#include "core/Global.h"
 #include "core/Group.h"
 #include "core/Metadata.h"
 #include "crypto/Crypto.h"
@@ -34,6 +35,7 @@ namespace
 
 void TestModified::initTestCase()
 {
+    qRegisterMetaType<QList<QPointer<QObject>>>();
     QVERIFY(Crypto::init());
 }
 
@@ -720,3 +722,145 @@ void TestModified::testBlockModifiedSignal()
     QCOMPARE(spyEntryAttachmentModified.count(), 0);
     QCOMPARE(spyEntryAutoTypeAssociationsModified.count(), 0);
 }
+
+void TestModified::testModifiedSignalEnabledCache()
+{
+    QScopedPointer<Database> db(new Database());
+    auto* group = new Group();
+    group->setParent(db->rootGroup());
+    auto* entry = new Entry();
+    entry->setGroup(group);
+
+    QVERIFY(entry->modifiedSignalEnabled());
+    QVERIFY(entry->attributes()->modifiedSignalEnabled());
+
+    // Disabling an ancestor disables all children
+    db->rootGroup()->setEmitModified(false);
+    QVERIFY(!group->modifiedSignalEnabled());
+    QVERIFY(!entry->modifiedSignalEnabled());
+    QVERIFY(!entry->attributes()->modifiedSignalEnabled());
+    db->rootGroup()->setEmitModified(true);
+    QVERIFY(entry->modifiedSignalEnabled());
+    QVERIFY(entry->attributes()->modifiedSignalEnabled());
+
+    // Reparenting picks up the state of the new parents
+    QScopedPointer<Database> db2(new Database());
+    db2->setEmitModified(false);
+    entry->setGroup(db2->rootGroup());
+    QVERIFY(!entry->modifiedSignalEnabled());
+    QVERIFY(!entry->customData()->modifiedSignalEnabled());
+    entry->setGroup(group);
+    QVERIFY(entry->modifiedSignalEnabled());
+    QVERIFY(entry->customData()->modifiedSignalEnabled());
+
+    group->setParent(db2->rootGroup());
+    QVERIFY(!entry->modifiedSignalEnabled());
+    db2->setEmitModified(true);
+    QVERIFY(entry->modifiedSignalEnabled());
+
+    // Objects outside of a database only depend on their own parents
+    QScopedPointer<Group> detached(new Group());
+    entry->setGroup(detached.data());
+    QVERIFY(entry->modifiedSignalEnabled());
+    detached->setEmitModified(false);
+    QVERIFY(!entry->modifiedSignalEnabled());
+}
+
+void TestModified::testObjectsModified()
+{
+    QScopedPointer<Database> db(new Database());
+    auto* entry1 = db->rootGroup()->addEntryWithPath("/entry1");
+    auto* entry2 = db->rootGroup()->addEntryWithPath("/entry2");
+    entry1->setTags("tag1");
+    QTRY_COMPARE(db->tagList(), QStringList() << "tag1");
+
+    QSignalSpy spyModified(db.data(), SIGNAL(modified()));
+    QSignalSpy spyObjects(db.data(), SIGNAL(objectsModified(QList<QPointer<QObject>>, bool)));
+    QSignalSpy spyTags(db.data(), SIGNAL(tagListUpdated()));
+
+    // Changes are coalesced into a single notification
+    entry1->setTitle("first");
+    entry1->setUsername("user");
+    entry2->setTitle("second");
+    QTRY_COMPARE(spyModified.count(), 1);
+    QCOMPARE(spyObjects.count(), 1);
+    auto objects = spyObjects.first().first().value<QList<QPointer<QObject>>>();
+    QCOMPARE(objects.size(), 2);
+    QVERIFY(objects.contains(entry1));
+    QVERIFY(objects.contains(entry2));
+    QVERIFY(!spyObjects.first().at(1).toBool());
+
+    // The tag list is only announced if it changed
+    QCOMPARE(spyTags.count(), 0);
+    entry2->setTags("tag2");
+    QTRY_COMPARE(spyModified.count(), 2);
+    QCOMPARE(spyTags.count(), 1);
+    QCOMPARE(db->tagList(), QStringList() << "tag1"
+                                          << "tag2");
+
+    // Changes that are not tied to an entry or group report no object
+    db->metadata()->setName("renamed");
+    db->markAsModified();
+    QTRY_COMPARE(spyModified.count(), 3);
+    QVERIFY(spyObjects.last().first().value<QList<QPointer<QObject>>>().isEmpty());
+    QVERIFY(!spyObjects.last().at(1).toBool());
+
+    // Objects changed before the database was saved are not reported afterwards
+    entry1->setTitle("saved");
+    db->markAsClean();
+    entry2->setTitle("unsaved");
+    QTRY_COMPARE(spyModified.count(), 4);
+    objects = spyObjects.last().first().value<QList<QPointer<QObject>>>();
+    QCOMPARE(objects.size(), 1);
+    QVERIFY(objects.contains(entry2));
+
+    // Too many changed objects are reported as an overflow instead
+    QList<Entry*> bulk;
+    for (int i = 0; i < 1001; ++i) {
+        auto* entry = new Entry();
+        entry->setGroup(db->rootGroup());
+        bulk.append(entry);
+    }
+    QTRY_COMPARE(spyModified.count(), 5);
+    for (auto* entry : bulk) {
+        entry->setTitle("bulk");
+    }
+    QTRY_COMPARE(spyModified.count(), 6);
+    QVERIFY(spyObjects.last().first().value<QList<QPointer<QObject>>>().isEmpty());
+    QVERIFY(spyObjects.last().at(1).toBool());
+}
+
+void TestModified::benchmarkBulkMove()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    QScopedPointer<Database> db(new Database());
+    auto* source = new Group();
+    source->setParent(db->rootGroup());
+    auto* target = new Group();
+    target->setParent(db->rootGroup());
+    QList<Entry*> entries;
+    for (int i = 0; i < 1000; ++i) {
+        auto* entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(QString("entry%1").arg(i));
+        entry->setTags(QString("tag%1").arg(i % 10));
+        entry->setGroup(source);
+        entries.append(entry);
+    }
+    db->markAsClean();
+
+    QSignalSpy spyModified(db.data(), SIGNAL(modified()));
+    QBENCHMARK_ONCE
+    {
+        for (auto* entry : asConst(entries)) {
+            entry->setGroup(target);
+        }
+    }
+    QCOMPARE(target->entries().size(), 1000);
+    QTRY_COMPARE(spyModified.count(), 1);
+}
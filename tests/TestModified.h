@@ -35,6 +35,9 @@ private slots:
     void testHistoryMaxSize();
     void testCustomData();
     void testBlockModifiedSignal();
+    void testModifiedSignalEnabledCache();
+    void testObjectsModified();
+    void benchmarkBulkMove();
 };
 
 #endif // KEEPASSX_TESTMODIFIED_H
@@ -18,16 +18,23 @@
 #include "TestPassphraseGenerator.h"
 #include "config-keepassx-tests.h"
 #include "core/PassphraseGenerator.h"
+#include "core/PassphraseWordList.h"
+#include "core/Resources.h"
 #include "crypto/Crypto.h"
 
+#include <QFile>
 #include <QRegularExpression>
+#include <QStandardPaths>
 #include <QTest>
+#include <cmath>
 
 QTEST_GUILESS_MAIN(TestPassphraseGenerator)
 
 void TestPassphraseGenerator::initTestCase()
 {
     QVERIFY(Crypto::init());
+    // Keep compiled wordlists out of the user's cache directory
+    QStandardPaths::setTestModeEnabled(true);
 }
 
 void TestPassphraseGenerator::testWordCase()
@@ -68,3 +75,82 @@ void TestPassphraseGenerator::testUniqueEntriesInWordlist()
     // so this fails
     QVERIFY(!generator.isValid());
 }
+
+void TestPassphraseGenerator::testSharedCompiledWordlist()
+{
+    QString path = QString(KEEPASSX_TEST_DATA_DIR).append("/wordlists/bad_wordlist_with_duplicate_entries.wordlist");
+    QFile::remove(PassphraseWordList::cachePath(path));
+    PassphraseWordList::clearCache();
+
+    auto wordList = PassphraseWordList::fromFile(path);
+    QCOMPARE(wordList->size(), 3);
+    QVERIFY(!wordList->isMapped());
+    QCOMPARE(wordList->at(0), QString("abacus"));
+    QCOMPARE(wordList->at(2), QString("abdominal"));
+    QVERIFY(wordList->at(3).isNull());
+    QCOMPARE(wordList->entropyPerWord(), std::log2(3));
+
+    // Same instance is shared within the process
+    QCOMPARE(PassphraseWordList::fromFile(path).data(), wordList.data());
+
+    // A fresh lookup maps the compiled form instead of parsing the text again
+    PassphraseWordList::clearCache();
+    auto mapped = PassphraseWordList::fromFile(path);
+    QVERIFY(mapped.data() != wordList.data());
+    QVERIFY(mapped->isMapped());
+    QCOMPARE(mapped->size(), 3);
+    for (int i = 0; i < mapped->size(); ++i) {
+        QCOMPARE(mapped->at(i), wordList->at(i));
+    }
+
+    // A corrupted compiled form is rejected and rebuilt from the source file
+    {
+        QFile compiled(PassphraseWordList::cachePath(path));
+        QVERIFY(compiled.open(QIODevice::ReadWrite));
+        const quint32 badOffset = 0xfffffff0;
+        QVERIFY(compiled.seek(32 + sizeof(quint32)));
+        QCOMPARE(compiled.write(reinterpret_cast<const char*>(&badOffset), sizeof(badOffset)),
+                 qint64(sizeof(badOffset)));
+    }
+    PassphraseWordList::clearCache();
+    auto rebuilt = PassphraseWordList::fromFile(path);
+    QVERIFY(!rebuilt->isMapped());
+    QCOMPARE(rebuilt->size(), 3);
+    QCOMPARE(rebuilt->at(1), wordList->at(1));
+    PassphraseWordList::clearCache();
+    QVERIFY(PassphraseWordList::fromFile(path)->isMapped());
+
+    auto words = PassphraseWordList::fromWords({"one", "two", "", "one", "thr\u00e9e"});
+    QCOMPARE(words->size(), 3);
+    QCOMPARE(words->at(2), QString("thr\u00e9e"));
+
+    PassphraseGenerator generator;
+    generator.m_minimum_wordlist_length = 3;
+    generator.setWordList(path);
+    QVERIFY(generator.isValid());
+    QCOMPARE(generator.estimateEntropy(2), 2 * std::log2(3));
+
+    auto empty = PassphraseWordList::fromFile(path + ".missing");
+    QVERIFY(empty->isEmpty());
+    QCOMPARE(empty->entropyPerWord(), 0.0);
+}
+
+void TestPassphraseGenerator::benchmarkLoadWordlist()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    const auto path = resources()->wordlistPath(PassphraseGenerator::DefaultWordList);
+    PassphraseWordList::clearCache();
+    QVERIFY(PassphraseWordList::fromFile(path)->size() > 0);
+
+    QBENCHMARK
+    {
+        PassphraseWordList::clearCache();
+        PassphraseGenerator generator;
+        QVERIFY(generator.isValid());
+    };
+}
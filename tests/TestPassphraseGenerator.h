@@ -28,6 +28,8 @@ private slots:
     void initTestCase();
     void testWordCase();
     void testUniqueEntriesInWordlist();
+    void testSharedCompiledWordlist();
+    void benchmarkLoadWordlist();
 };
 
 #endif // KEEPASSXC_TESTPASSPHRASEGENERATOR_H
@@ -17,14 +17,25 @@
 
 #include "TestPasswordHealth.h"
 
+#include "core/Database.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+#include "core/PasswordDictionary.h"
 #include "core/PasswordHealth.h"
+#include "core/PasswordStrengthEstimator.h"
+#include "crypto/Random.h"
 
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryFile>
 #include <QTest>
 
 QTEST_GUILESS_MAIN(TestPasswordHealth)
 
 void TestPasswordHealth::initTestCase()
 {
+    QStandardPaths::setTestModeEnabled(true);
 }
 
 void TestPasswordHealth::testNoDb()
@@ -64,3 +75,188 @@ void TestPasswordHealth::testNoDb()
     QVERIFY(excellent.scoreReason().isEmpty());
     QVERIFY(excellent.scoreDetails().isEmpty());
 }
+
+void TestPasswordHealth::testLongPasswords()
+{
+    const auto randomPassword = [](int length) {
+        return QString::fromLatin1(randomGen()->randomArray(length).toBase64().left(length));
+    };
+
+    // Long passwords are scored in windows, the entropy keeps growing with the length
+    const auto pwd = randomPassword(1024);
+    const auto shortEntropy = PasswordHealth::estimateEntropy(pwd.left(256));
+    const auto longEntropy = PasswordHealth::estimateEntropy(pwd);
+    QVERIFY(shortEntropy > 0);
+    QVERIFY(longEntropy > shortEntropy * 3);
+
+    // Repeated content is only counted once (the pattern length divides the window size)
+    const auto repeated = QString("Yohb2ChR").repeated(400);
+    QVERIFY(PasswordHealth::estimateEntropy(repeated) < PasswordHealth::estimateEntropy(repeated.left(128)) + 16);
+
+    // Plain estimations, such as the ones of the health check, are not cached
+    PasswordHealth::clearEntropyCache();
+    double entropy = 0;
+    PasswordHealth health(pwd);
+    QCOMPARE(health.entropy(), longEntropy);
+    QVERIFY(!PasswordHealth::cachedEntropy(pwd, &entropy));
+
+    PasswordHealth::cacheEntropy(pwd, longEntropy);
+    QVERIFY(PasswordHealth::cachedEntropy(pwd, &entropy));
+    QCOMPARE(entropy, longEntropy);
+    PasswordHealth::clearEntropyCache();
+    QVERIFY(!PasswordHealth::cachedEntropy(pwd, &entropy));
+}
+
+void TestPasswordHealth::testStrengthEstimator()
+{
+    PasswordHealth::clearEntropyCache();
+
+    PasswordStrengthEstimator estimator;
+    estimator.setDebounceInterval(10);
+    QSignalSpy spy(&estimator, &PasswordStrengthEstimator::estimated);
+
+    // Only the latest request is reported
+    estimator.estimate("secre");
+    estimator.estimate("Yohb2ChR4");
+    QVERIFY(estimator.isBusy());
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().first().toDouble(), PasswordHealth("Yohb2ChR4").entropy());
+    QTRY_VERIFY(!estimator.isBusy());
+
+    // Cached results are reported right away
+    estimator.estimate("Yohb2ChR4");
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(!estimator.isBusy());
+
+    // Canceled requests are never reported nor cached
+    spy.clear();
+    estimator.estimate("MIhIN9UKrgtPL2hp");
+    estimator.cancel();
+    QVERIFY(!spy.wait(100));
+    double entropy;
+    QVERIFY(!PasswordHealth::cachedEntropy("MIhIN9UKrgtPL2hp", &entropy));
+
+    // A cleared cache estimates again
+    PasswordHealth::clearEntropyCache();
+    estimator.estimate("Yohb2ChR4");
+    QVERIFY(estimator.isBusy());
+    QVERIFY(spy.wait());
+}
+
+void TestPasswordHealth::testPasswordDictionary()
+{
+    // Short words and duplicates are dropped, case is ignored
+    auto dictionary = PasswordDictionary::fromWords({"Acme", "ac", "rocket", "acme"});
+    QCOMPARE(dictionary->size(), 2);
+    QVERIFY(!dictionary->isMapped());
+
+    QCOMPARE(dictionary->matches("acme"), QStringList({"acme"}));
+    QCOMPARE(dictionary->matches("R0ck3t@cm3"), QStringList({"acme", "rocket"}));
+    QCOMPARE(dictionary->matches("launch-ROCKET-2024"), QStringList({"rocket"}));
+    QVERIFY(dictionary->matches("password").isEmpty());
+    QVERIFY(dictionary->matches("ac").isEmpty());
+
+    // Dictionary words weaken a password beyond what zxcvbn knows by itself
+    const QString password("R0ck3t@cm3");
+    QVERIFY(PasswordHealth::estimateEntropy(password, dictionary->matches(password))
+            < PasswordHealth::estimateEntropy(password));
+}
+
+void TestPasswordHealth::testCompiledPasswordDictionary()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write("# Organization words\nAcme\n\nrocket\nacme\n");
+    file.close();
+
+    QFile::remove(PasswordDictionary::cachePath(QFileInfo(file.fileName()).canonicalFilePath()));
+    PasswordDictionary::clearCache();
+
+    auto dictionary = PasswordDictionary::fromFile(file.fileName());
+    QCOMPARE(dictionary->size(), 2);
+    QVERIFY(!dictionary->isMapped());
+    QCOMPARE(PasswordDictionary::fromFile(file.fileName()).data(), dictionary.data());
+
+    // A fresh lookup maps the compiled form instead of parsing the text again
+    PasswordDictionary::clearCache();
+    auto mapped = PasswordDictionary::fromFile(file.fileName());
+    QVERIFY(mapped->isMapped());
+    QCOMPARE(mapped->size(), 2);
+    QCOMPARE(mapped->matches("R0ck3t@cm3"), dictionary->matches("R0ck3t@cm3"));
+
+    // A corrupted compiled form is rejected and rebuilt from the source file
+    {
+        QFile compiled(PasswordDictionary::cachePath(QFileInfo(file.fileName()).canonicalFilePath()));
+        QVERIFY(compiled.open(QIODevice::ReadWrite));
+        const quint32 badOffset = 0xfffffff0;
+        QVERIFY(compiled.seek(32 + sizeof(quint32)));
+        QCOMPARE(compiled.write(reinterpret_cast<const char*>(&badOffset), sizeof(badOffset)),
+                 qint64(sizeof(badOffset)));
+    }
+    PasswordDictionary::clearCache();
+    auto rebuilt = PasswordDictionary::fromFile(file.fileName());
+    QVERIFY(!rebuilt->isMapped());
+    QCOMPARE(rebuilt->size(), 2);
+    QCOMPARE(rebuilt->matches("R0ck3t@cm3"), dictionary->matches("R0ck3t@cm3"));
+    PasswordDictionary::clearCache();
+
+    QVERIFY(PasswordDictionary::fromFile("/nonexistent/dictionary.txt")->isEmpty());
+}
+
+void TestPasswordHealth::testContextWords()
+{
+    QSharedPointer<Database> db(new Database());
+    auto entry = new Entry();
+    entry->setGroup(db->rootGroup());
+    entry->setTitle("Acme Portal");
+    entry->setUsername("j.doe");
+    entry->setUrl("https://www.acme-corp.example/login");
+    entry->setPassword("AcmePortal2024");
+
+    QCOMPARE(PasswordDictionary::contextWords(entry),
+             QStringList({"acme", "corp", "doe", "example", "j.doe", "portal"}));
+    QVERIFY(PasswordDictionary::contextWords(nullptr).isEmpty());
+
+    auto other = new Entry();
+    other->setGroup(db->rootGroup());
+    other->setTitle("Mail");
+    other->setPassword("Zorblax!2024");
+    db->metadata()->setPasswordDictionary({"zorblax", " ", "zorblax"});
+    QCOMPARE(db->metadata()->passwordDictionary(), QStringList({"zorblax"}));
+
+    HealthChecker checker(db);
+    QVERIFY(checker.evaluate(entry)->entropy() < PasswordHealth(entry->password()).entropy());
+    QVERIFY(checker.evaluate(other)->entropy() < PasswordHealth(other->password()).entropy());
+
+    db->metadata()->setPasswordDictionary({});
+    QVERIFY(db->metadata()->passwordDictionary().isEmpty());
+}
+
+void TestPasswordHealth::benchmarkEstimateEntropy_data()
+{
+    QTest::addColumn<int>("length");
+    QTest::newRow("8") << 8;
+    QTest::newRow("64") << 64;
+    QTest::newRow("256") << 256;
+    QTest::newRow("1024") << 1024;
+    QTest::newRow("4096") << 4096;
+}
+
+void TestPasswordHealth::benchmarkEstimateEntropy()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    QFETCH(int, length);
+    const auto pwd = QString::fromLatin1(randomGen()->randomArray(length).toBase64().left(length));
+
+    QBENCHMARK
+    {
+        PasswordHealth::clearEntropyCache();
+        PasswordHealth::estimateEntropy(pwd);
+    };
+}
@@ -27,6 +27,13 @@ class TestPasswordHealth : public QObject
 private slots:
     void initTestCase();
     void testNoDb();
+    void testLongPasswords();
+    void testStrengthEstimator();
+    void testPasswordDictionary();
+    void testCompiledPasswordDictionary();
+    void testContextWords();
+    void benchmarkEstimateEntropy_data();
+    void benchmarkEstimateEntropy();
 };
 
 #endif // KEEPASSX_TESTPASSWORDHEALTH_H
@@ -20,9 +20,11 @@
 
 #include <QBuffer>
 #include <QTest>
+#include <QThreadPool>
 #include <QVector>
 
 #include "crypto/Crypto.h"
+#include "crypto/Random.h"
 #include "format/KeePass2.h"
 #include "streams/SymmetricCipherStream.h"
 
@@ -455,3 +457,122 @@ void TestSymmetricCipher::testStreamReset()
     writer.close();
     QCOMPARE(buffer.buffer().size(), 16);
 }
+
+namespace
+{
+    QByteArray encryptWithStream(SymmetricCipher::Mode mode,
+                                 const QByteArray& key,
+                                 const QByteArray& iv,
+                                 const QByteArray& plainText)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        SymmetricCipherStream stream(&buffer);
+        if (!stream.init(mode, SymmetricCipher::Encrypt, key, iv) || !stream.open(QIODevice::WriteOnly)) {
+            return {};
+        }
+        stream.write(plainText);
+        stream.close();
+        return buffer.data();
+    }
+} // namespace
+
+void TestSymmetricCipher::testParallelStreamDecryption_data()
+{
+    QTest::addColumn<SymmetricCipher::Mode>("mode");
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("AES256 small") << SymmetricCipher::Aes256_CBC << 100;
+    QTest::newRow("AES256 several chunks") << SymmetricCipher::Aes256_CBC << 9 * 1024 * 1024 + 5;
+    QTest::newRow("AES256 block aligned") << SymmetricCipher::Aes256_CBC << 8 * 1024 * 1024;
+    QTest::newRow("Twofish several chunks") << SymmetricCipher::Twofish_CBC << 9 * 1024 * 1024 + 21;
+}
+
+void TestSymmetricCipher::testParallelStreamDecryption()
+{
+    QFETCH(SymmetricCipher::Mode, mode);
+    QFETCH(int, size);
+
+    const auto key = randomGen()->randomArray(SymmetricCipher::keySize(mode));
+    const auto iv = randomGen()->randomArray(SymmetricCipher::ivSize(mode));
+    const auto plainText = randomGen()->randomArray(size);
+    auto cipherText = encryptWithStream(mode, key, iv, plainText);
+    QCOMPARE(cipherText.size(), (size / 16 + 1) * 16);
+
+    // Read with odd sizes so reads straddle chunk and segment boundaries
+    QBuffer buffer(&cipherText);
+    buffer.open(QIODevice::ReadOnly);
+    SymmetricCipherStream stream(&buffer);
+    QVERIFY(stream.init(mode, SymmetricCipher::Decrypt, key, iv));
+    QVERIFY(stream.open(QIODevice::ReadOnly));
+    QByteArray decrypted;
+    QByteArray part;
+    while (!(part = stream.read(777777)).isEmpty()) {
+        decrypted.append(part);
+    }
+    QCOMPARE(decrypted.size(), plainText.size());
+    QVERIFY(decrypted == plainText);
+    stream.close();
+
+    // Padding is only validated at the end of the stream, flipping a byte of
+    // the second to last ciphertext block flips the padding length byte
+    const int block = SymmetricCipher::blockSize(mode);
+    cipherText[cipherText.size() - block - 1] = static_cast<char>(cipherText.at(cipherText.size() - block - 1) ^ 0x55);
+    buffer.seek(0);
+    SymmetricCipherStream corrupted(&buffer);
+    QVERIFY(corrupted.init(mode, SymmetricCipher::Decrypt, key, iv));
+    QVERIFY(corrupted.open(QIODevice::ReadOnly));
+    if (size > 1024 * 1024) {
+        QCOMPARE(corrupted.read(1024 * 1024), plainText.left(1024 * 1024));
+    }
+    char data[65536];
+    qint64 readResult;
+    while ((readResult = corrupted.read(data, sizeof(data))) > 0) {
+    }
+    QCOMPARE(readResult, qint64(-1));
+    QVERIFY(!corrupted.errorString().isEmpty());
+}
+
+void TestSymmetricCipher::benchmarkStreamDecryption_data()
+{
+    QTest::addColumn<SymmetricCipher::Mode>("mode");
+    QTest::addColumn<int>("threads");
+
+    for (int threads : {1, 4, 8}) {
+        QTest::addRow("AES256 %d threads", threads) << SymmetricCipher::Aes256_CBC << threads;
+        QTest::addRow("Twofish %d threads", threads) << SymmetricCipher::Twofish_CBC << threads;
+    }
+}
+
+void TestSymmetricCipher::benchmarkStreamDecryption()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    QFETCH(SymmetricCipher::Mode, mode);
+    QFETCH(int, threads);
+
+    // Payload of a 500 MB vault
+    const auto key = randomGen()->randomArray(SymmetricCipher::keySize(mode));
+    const auto iv = randomGen()->randomArray(SymmetricCipher::ivSize(mode));
+    auto cipherText = encryptWithStream(mode, key, iv, QByteArray(500 * 1024 * 1024, 'x'));
+
+    const auto maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+    QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+    QBENCHMARK_ONCE
+    {
+        QBuffer buffer(&cipherText);
+        buffer.open(QIODevice::ReadOnly);
+        SymmetricCipherStream stream(&buffer);
+        QVERIFY(stream.init(mode, SymmetricCipher::Decrypt, key, iv));
+        QVERIFY(stream.open(QIODevice::ReadOnly));
+        char data[65536];
+        while (stream.read(data, sizeof(data)) > 0) {
+        }
+    }
+
+    QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+}
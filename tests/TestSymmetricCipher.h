@@ -39,6 +39,10 @@ private slots:
     void testChaCha20();
     void testPadding();
     void testStreamReset();
+    void testParallelStreamDecryption_data();
+    void testParallelStreamDecryption();
+    void benchmarkStreamDecryption_data();
+    void benchmarkStreamDecryption();
 };
 
 #endif // KEEPASSX_TESTSYMMETRICCIPHER_H
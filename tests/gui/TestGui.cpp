@@ -32,6 +32,7 @@
 #include <QSpinBox>
 #include <QTableWidget>
 #include <QTest>
+#include <QTextEdit>
 #include <QToolBar>
 
 #include "config-keepassx-tests.h"
@@ -62,6 +63,7 @@
 #include "gui/group/GroupModel.h"
 #include "gui/group/GroupView.h"
 #include "gui/remote/RemoteHandler.h"
+#include "gui/reports/ReportsWidgetHealthcheck.h"
 #include "gui/tag/TagsEdit.h"
 #include "gui/wizard/NewDatabaseWizard.h"
 #include "keys/FileKey.h"
@@ -967,7 +969,7 @@ void TestGui::testPasswordEntryEntropy()
         auto expectedPasswordLength = QString("Characters: %1").arg(QString::number(password.length()));
 
         generatedPassword->setText(password);
-        QCOMPARE(entropyLabel->text(), expectedEntropy);
+        QTRY_COMPARE(entropyLabel->text(), expectedEntropy);
         QCOMPARE(strengthLabel->text(), expectedStrengthLabel);
         QCOMPARE(passwordLengthLabel->text(), expectedPasswordLength);
 
@@ -1468,6 +1470,273 @@ void TestGui::testEntryPlaceholders()
     QTRY_COMPARE(clipboard->text(), QString("test.john"));
 }
 
+void TestGui::testEntryPreviewLazyTabs()
+{
+    auto* entryView = m_dbWidget->findChild<EntryView*>("entryView");
+    auto* previewWidget = m_dbWidget->findChild<EntryPreviewWidget*>("previewWidget");
+    auto* entryTabWidget = previewWidget->findChild<QTabWidget*>("entryTabWidget");
+    auto* entryAdvancedTab = previewWidget->findChild<QWidget*>("entryAdvancedTab");
+    auto* attributesTable = previewWidget->findChild<QTableWidget*>("entryAttributesTable");
+    auto* usernameLabel = previewWidget->findChild<QLineEdit*>("entryUsernameLabel");
+    QVERIFY(entryView && previewWidget && entryTabWidget && attributesTable && usernameLabel);
+
+    auto* entry = new Entry();
+    entry->setUuid(QUuid::createUuid());
+    entry->setTitle("lazy");
+    entry->setUsername("{TITLE}-user");
+    entry->attributes()->set("custom", "value");
+    entry->setGroup(m_db->rootGroup());
+
+    entryTabWidget->setCurrentIndex(0);
+    entryView->setCurrentEntry(entry);
+    QTRY_COMPARE(usernameLabel->text(), QString("lazy-user"));
+
+    // The advanced tab is enabled but only rendered once it is shown
+    QVERIFY(entryAdvancedTab->isEnabled());
+    QCOMPARE(attributesTable->rowCount(), 0);
+    entryTabWidget->setCurrentWidget(entryAdvancedTab);
+    QCOMPARE(attributesTable->rowCount(), 1);
+    QCOMPARE(attributesTable->item(0, 2)->text(), QString("value"));
+    entryTabWidget->setCurrentIndex(0);
+}
+
+void TestGui::testEntryPreviewPlaceholders()
+{
+    auto* entryView = m_dbWidget->findChild<EntryView*>("entryView");
+    auto* previewWidget = m_dbWidget->findChild<EntryPreviewWidget*>("previewWidget");
+    auto* entryTabWidget = previewWidget->findChild<QTabWidget*>("entryTabWidget");
+    auto* titleLabel = previewWidget->findChild<QLabel*>("entryTitleLabel");
+    auto* usernameLabel = previewWidget->findChild<QLineEdit*>("entryUsernameLabel");
+    auto* urlLabel = previewWidget->findChild<QLabel*>("entryUrlLabel");
+    auto* notesEdit = previewWidget->findChild<QTextEdit*>("entryNotesTextEdit");
+    QVERIFY(entryView && previewWidget && entryTabWidget && titleLabel && usernameLabel && urlLabel && notesEdit);
+
+    auto* plain = new Entry();
+    plain->setUuid(QUuid::createUuid());
+    plain->setTitle("alpha");
+    plain->setUsername("alpha-user");
+    plain->setUrl("https://alpha.example.com");
+    plain->setNotes("alpha notes");
+    plain->setGroup(m_db->rootGroup());
+
+    auto* placeholders = new Entry();
+    placeholders->setUuid(QUuid::createUuid());
+    placeholders->setTitle("beta");
+    placeholders->setUsername("{TITLE}-user");
+    placeholders->setUrl("https://{TITLE}.example.com");
+    placeholders->setNotes("{USERNAME} notes");
+    placeholders->setGroup(m_db->rootGroup());
+
+    entryTabWidget->setCurrentIndex(0);
+    entryView->setCurrentEntry(plain);
+    QCOMPARE(usernameLabel->text(), QString("alpha-user"));
+
+    // The resolved fields are shown right away, nothing of the previous entry is left over
+    entryView->setCurrentEntry(placeholders);
+    QVERIFY(titleLabel->property("rawText").toString().endsWith("beta"));
+    QCOMPARE(usernameLabel->text(), QString("beta-user"));
+    QCOMPARE(urlLabel->property("url").toString(), QString("https://beta.example.com"));
+    QVERIFY(!notesEdit->toPlainText().contains("alpha"));
+}
+
+void TestGui::benchmarkEntryPreviewScroll()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    m_db->rootGroup()->setEmitModified(false);
+    for (int i = 0; i < 10000; ++i) {
+        auto* entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(QString("Entry %1").arg(i));
+        entry->setUsername(i % 2 ? "{TITLE}" : "user");
+        entry->setPassword("password");
+        entry->setNotes(QString("Notes for entry %1").arg(i));
+        entry->attributes()->set("attribute", "{USERNAME}");
+        entry->setGroup(m_db->rootGroup());
+    }
+    m_db->rootGroup()->setEmitModified(true);
+
+    auto* entryView = m_dbWidget->findChild<EntryView*>("entryView");
+    entryView->setFocus();
+    const int rows = entryView->model()->rowCount();
+    QVERIFY(rows >= 10000);
+
+    QBENCHMARK_ONCE
+    {
+        entryView->setCurrentIndex(entryView->model()->index(0, 0));
+        for (int i = 1; i < rows; ++i) {
+            QTest::keyClick(entryView, Qt::Key_Down);
+        }
+        QApplication::processEvents();
+    };
+    QCOMPARE(entryView->currentIndex().row(), rows - 1);
+}
+
+void TestGui::testReportsHealthcheckFilter()
+{
+    auto db = QSharedPointer<Database>::create();
+    for (int i = 0; i < 3; ++i) {
+        auto* entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(QString("Weak %1").arg(i));
+        entry->setPassword("password");
+        entry->setGroup(db->rootGroup());
+        if (i == 0) {
+            entry->expireNow();
+        }
+    }
+
+    ReportsWidgetHealthcheck healthcheck;
+    healthcheck.loadSettings(db);
+    healthcheck.calculateHealth();
+
+    auto* tableView = healthcheck.findChild<QTableView*>("healthcheckTableView");
+    auto* showExpired = healthcheck.findChild<QCheckBox*>("showExpired");
+    QVERIFY(tableView && showExpired);
+
+    // Expired entries are hidden by the filter, not removed from the report
+    showExpired->setChecked(false);
+    QCOMPARE(tableView->model()->rowCount(), 2);
+    showExpired->setChecked(true);
+    QCOMPARE(tableView->model()->rowCount(), 3);
+    QCOMPARE(tableView->model()->columnCount(), 5);
+    QVERIFY(tableView->model()->index(0, 1).data().toString().startsWith("Weak "));
+}
+
+void TestGui::benchmarkReportsHealthcheck()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    auto db = QSharedPointer<Database>::create();
+    for (int i = 0; i < 5000; ++i) {
+        auto* entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(QString("Entry %1").arg(i));
+        entry->setPassword(QString("pass%1").arg(i % 100));
+        entry->setGroup(db->rootGroup());
+        if (i % 10 == 0) {
+            entry->expireNow();
+        }
+    }
+
+    ReportsWidgetHealthcheck healthcheck;
+    healthcheck.resize(800, 600);
+    healthcheck.show();
+    auto* tableView = healthcheck.findChild<QTableView*>("healthcheckTableView");
+    auto* showExpired = healthcheck.findChild<QCheckBox*>("showExpired");
+    QVERIFY(tableView && showExpired);
+
+    QBENCHMARK_ONCE
+    {
+        healthcheck.loadSettings(db);
+        healthcheck.calculateHealth();
+        QApplication::processEvents();
+    };
+    QVERIFY(tableView->model()->rowCount() > 0);
+
+    const int rows = tableView->model()->rowCount();
+    QBENCHMARK_ONCE
+    {
+        showExpired->toggle();
+        QApplication::processEvents();
+    };
+    QVERIFY(tableView->model()->rowCount() != rows);
+}
+
+namespace
+{
+    Entry* createEntryWithHistory(Group* group, int historyCount, int attachmentSize)
+    {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle("History Entry");
+        entry->setPassword("current");
+        entry->attachments()->set("data.bin", QByteArray(attachmentSize, 'x'));
+        entry->setGroup(group);
+
+        const auto lastModified = entry->timeInfo().lastModificationTime();
+        for (int i = 0; i < historyCount; ++i) {
+            auto item = entry->clone(Entry::CloneNoFlags);
+            item->setPassword(QString("pass%1").arg(i));
+            // Change the attachment every 10 revisions, so the comparison has to read all bytes
+            item->attachments()->set("data.bin", QByteArray(attachmentSize, static_cast<char>('a' + (i / 10) % 26)));
+            auto timeInfo = item->timeInfo();
+            timeInfo.setLastModificationTime(lastModified.addSecs(i - historyCount));
+            item->setTimeInfo(timeInfo);
+            entry->addHistoryItem(item);
+        }
+        return entry;
+    }
+} // namespace
+
+void TestGui::testEditEntryLazyHistory()
+{
+    auto db = QSharedPointer<Database>::create();
+    auto entry = createEntryWithHistory(db->rootGroup(), 20, 16);
+
+    EditEntryWidget editEntryWidget;
+    editEntryWidget.loadEntry(entry, false, false, "Root", db);
+    auto historyView = editEntryWidget.findChild<QTreeView*>("historyView");
+    QVERIFY(historyView);
+
+    // The history is only loaded once its page is shown
+    QCOMPARE(historyView->model()->rowCount(), 0);
+    QVERIFY(editEntryWidget.switchToPage(EditEntryWidget::Page::History));
+    QCOMPARE(historyView->model()->rowCount(), 21);
+
+    // Differences are calculated in the background when requested
+    auto model = historyView->model();
+    QVERIFY(model->index(0, 2).data().toString().isEmpty());
+    QTRY_COMPARE(model->index(0, 2).data().toString(), QString("Password, Attachments"));
+    QTRY_COMPARE(model->index(1, 2).data().toString(), QString("Password"));
+    QTRY_COMPARE(model->index(9, 2).data().toString(), QString("Password"));
+    QTRY_COMPARE(model->index(10, 2).data().toString(), QString("Password, Attachments"));
+    QVERIFY(model->index(20, 2).data().toString().isEmpty());
+
+    // Reloading the entry resets the history until it is shown again
+    QVERIFY(editEntryWidget.switchToPage(EditEntryWidget::Page::Main));
+    editEntryWidget.loadEntry(entry, false, false, "Root", db);
+    QCOMPARE(historyView->model()->rowCount(), 0);
+    QVERIFY(editEntryWidget.switchToPage(EditEntryWidget::Page::History));
+    QCOMPARE(historyView->model()->rowCount(), 21);
+}
+
+void TestGui::benchmarkEditEntryHistory()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    auto db = QSharedPointer<Database>::create();
+    auto entry = createEntryWithHistory(db->rootGroup(), 500, 256 * 1024);
+
+    EditEntryWidget editEntryWidget;
+    editEntryWidget.resize(800, 600);
+    editEntryWidget.show();
+    auto historyView = editEntryWidget.findChild<QTreeView*>("historyView");
+    QVERIFY(historyView);
+
+    QBENCHMARK_ONCE
+    {
+        editEntryWidget.loadEntry(entry, false, false, "Root", db);
+        QApplication::processEvents();
+        editEntryWidget.switchToPage(EditEntryWidget::Page::History);
+        QApplication::processEvents();
+        QTRY_VERIFY(!historyView->model()->index(0, 2).data().toString().isEmpty());
+    };
+    QCOMPARE(historyView->model()->rowCount(), 501);
+}
+
 void TestGui::testDragAndDropEntry()
 {
     auto entryView = m_dbWidget->findChild<EntryView*>("entryView");
@@ -1874,10 +2143,16 @@ void TestGui::testDatabaseLocking()
 {
     QString origDbName = m_tabWidget->tabText(0);
 
+    // Entropies cached by the password editors do not survive locking
+    double entropy;
+    PasswordHealth::cacheEntropy("Yohb2ChR4", 42);
+    QVERIFY(PasswordHealth::cachedEntropy("Yohb2ChR4", &entropy));
+
     MessageBox::setNextAnswer(MessageBox::Cancel);
     triggerAction("actionLockAllDatabases");
 
     QCOMPARE(m_tabWidget->tabText(0), origDbName + " [Locked]");
+    QVERIFY(!PasswordHealth::cachedEntropy("Yohb2ChR4", &entropy));
 
     auto* actionDatabaseMerge = m_mainWindow->findChild<QAction*>("actionDatabaseMerge", Qt::FindChildrenRecursively);
     QCOMPARE(actionDatabaseMerge->isEnabled(), false);
@@ -56,6 +56,13 @@ private slots:
     void testDeleteEntry();
     void testCloneEntry();
     void testEntryPlaceholders();
+    void testEntryPreviewLazyTabs();
+    void testEntryPreviewPlaceholders();
+    void benchmarkEntryPreviewScroll();
+    void testReportsHealthcheckFilter();
+    void benchmarkReportsHealthcheck();
+    void testEditEntryLazyHistory();
+    void benchmarkEditEntryHistory();
     void testDragAndDropEntry();
     void testDragAndDropGroup();
     void testSaveAs();
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2025 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestGuiAutoTypeX11.h"
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QLineEdit>
+#include <QTest>
+
+#include "autotype/AutoTypePlatformPlugin.h"
+#include "core/Resources.h"
+#include "crypto/Crypto.h"
+
+/**
+ * Exercises the X11 Auto-Type plugin against a real (usually Xvfb) display.
+ * Run with e.g. `xvfb-run ./testguiautotypex11`.
+ */
+void TestGuiAutoTypeX11::initTestCase()
+{
+    if (QGuiApplication::platformName() != "xcb") {
+        QSKIP("An X11 display is required, run under Xvfb.");
+    }
+    QVERIFY(Crypto::init());
+
+    m_loader.setFileName(resources()->pluginPath("keepassxc-autotype-xcb"));
+    m_platform = qobject_cast<AutoTypePlatformInterface*>(m_loader.instance());
+    if (!m_platform) {
+        QSKIP(qPrintable(QString("X11 Auto-Type plugin not found: %1").arg(m_loader.errorString())));
+    }
+    if (!m_platform->isAvailable()) {
+        QSKIP("The X server lacks the XTEST or XInput extension.");
+    }
+}
+
+void TestGuiAutoTypeX11::testTypeSequence_data()
+{
+    QTest::addColumn<QString>("text");
+
+    const QString ascii =
+        QStringLiteral("The quick brown fox jumps over the lazy dog 0123456789 !@#$%^&*()_+-=[]{};':,./<>?");
+    QTest::newRow("ascii") << ascii;
+    QTest::newRow("long ascii") << ascii.repeated(10);
+    // More distinct characters missing from the layout than spare keycodes are reserved
+    QTest::newRow("remapped") << QString::fromUtf8("ÆØÅßΩΣΠΔΦΨЖЯЮ€ æøå ΩΣΠ Ж");
+    QTest::newRow("mixed") << (ascii + QString::fromUtf8(" ÆØÅ ΩΣΠ ")).repeated(4);
+}
+
+void TestGuiAutoTypeX11::testTypeSequence()
+{
+    QFETCH(QString, text);
+
+    QLineEdit edit;
+    edit.show();
+    edit.activateWindow();
+    QVERIFY(QTest::qWaitForWindowActive(&edit));
+    edit.setFocus();
+
+    QList<QSharedPointer<AutoTypeAction>> actions;
+    actions << QSharedPointer<AutoTypeBegin>::create();
+    for (const auto& ch : text) {
+        actions << QSharedPointer<AutoTypeKey>::create(ch);
+    }
+
+    QScopedPointer<AutoTypeExecutor> executor(m_platform->createExecutor());
+    executor->execDelayMs = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Type in chunks like AutoType does, so the events of each chunk are batched
+    executor->prepareSequence(actions);
+    for (int i = 0; i < actions.size(); ++i) {
+        if (i % 32 == 0) {
+            executor->endChunk();
+            executor->beginChunk();
+        }
+        auto result = actions.at(i)->exec(executor.data());
+        QVERIFY2(result.isOk(), qPrintable(result.errorString()));
+    }
+    executor->endChunk();
+    executor->finishSequence();
+
+    QTRY_COMPARE(edit.text(), text);
+
+    const auto elapsed = qMax<qint64>(1, timer.elapsed());
+    qInfo("Typed %d characters in %lld ms (%.0f characters per second)",
+          text.size(),
+          elapsed,
+          text.size() * 1000.0 / elapsed);
+}
+
+QTEST_MAIN(TestGuiAutoTypeX11)
@@ -27,6 +27,7 @@
 #include "config-keepassx-tests.h"
 
 #include "core/Global.h"
+#include "core/Merger.h"
 #include "core/Tools.h"
 #include "crypto/Crypto.h"
 #include "gui/Application.h"
@@ -1559,6 +1560,62 @@ void TestGuiFdoSecrets::testItemRejectSetReferenceFields()
     }
 }
 
+void TestGuiFdoSecrets::testItemSignalsCoalesced()
+{
+    const int count = 5000;
+
+    auto bulk = new Group();
+    bulk->setUuid(QUuid::createUuid());
+    bulk->setName("Bulk");
+    bulk->setParent(m_db->rootGroup());
+    for (int i = 0; i < count; ++i) {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(QStringLiteral("Bulk %1").arg(i));
+        entry->setGroup(bulk);
+    }
+
+    // a newer copy of every bulk entry
+    QScopedPointer<Database> source(new Database());
+    delete source->setRootGroup(m_db->rootGroup()->clone(Entry::CloneNoFlags, Group::CloneIncludeEntries));
+    auto sourceBulk = source->rootGroup()->findGroupByUuid(bulk->uuid());
+    VERIFY(sourceBulk);
+    for (auto entry : sourceBulk->entries()) {
+        entry->setPassword(QStringLiteral("changed"));
+        auto timeInfo = entry->timeInfo();
+        timeInfo.setLastModificationTime(timeInfo.lastModificationTime().addSecs(3600));
+        entry->setTimeInfo(timeInfo);
+    }
+
+    auto service = enableService();
+    VERIFY(service);
+    auto coll = getDefaultCollection(service);
+    VERIFY(coll);
+
+    int modifiedCount = 0;
+    for (auto entry : bulk->entries()) {
+        connect(entry, &Entry::modified, this, [&modifiedCount]() { ++modifiedCount; });
+    }
+
+    QSignalSpy spyItemChanged(coll.data(), SIGNAL(ItemChanged(QDBusObjectPath)));
+    VERIFY(spyItemChanged.isValid());
+
+    Merger merger(source.data(), m_db.data());
+    VERIFY(!merger.merge().isEmpty());
+    VERIFY(modifiedCount >= count);
+
+    QTRY_VERIFY_WITH_TIMEOUT(spyItemChanged.size() >= count, 30000);
+    processEvents();
+
+    QSet<QString> changedPaths;
+    for (const auto& args : spyItemChanged) {
+        changedPaths.insert(args.at(0).value<QDBusObjectPath>().path());
+    }
+    COMPARE(changedPaths.size(), count);
+    // repeated modifications of one entry are announced once, except when a burst is split by an early flush
+    VERIFY(spyItemChanged.size() <= count + count / 100);
+}
+
 void TestGuiFdoSecrets::testAlias()
 {
     auto service = enableService();
@@ -93,6 +93,7 @@ private slots:
     void testItemDelete();
     void testItemLockState();
     void testItemRejectSetReferenceFields();
+    void testItemSignalsCoalesced();
 
     void testAlias();
     void testDefaultAliasAlwaysPresent();
@@ -18,6 +18,8 @@
 #include "TestGuiPixmaps.h"
 #include "core/Metadata.h"
 
+#include <QStandardItemModel>
+#include <QTableView>
 #include <QTest>
 
 #include "core/Group.h"
@@ -81,4 +83,68 @@ void TestGuiPixmaps::testGroupIcons()
     QVERIFY(Icons::groupIconPixmap(group).toImage() == Icons::customIconPixmap(db.data(), iconUuid).toImage());
 }
 
+void TestGuiPixmaps::testRecoloredIcons()
+{
+    // Icons with an override color are cached like all other icons
+    auto red = icons()->icon("password-copy", true, QColor(Qt::red));
+    QCOMPARE(icons()->icon("password-copy", true, QColor(Qt::red)).cacheKey(), red.cacheKey());
+    auto blue = icons()->icon("password-copy", true, QColor(Qt::blue));
+    QVERIFY(blue.cacheKey() != red.cacheKey());
+
+    // Repeated renders are served from the pixmap cache
+    auto image = red.pixmap(QSize(32, 32)).toImage().convertToFormat(QImage::Format_ARGB32);
+    QCOMPARE(red.pixmap(QSize(32, 32)).toImage().convertToFormat(QImage::Format_ARGB32), image);
+
+    int opaquePixels = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            const auto pixel = image.pixel(x, y);
+            if (qAlpha(pixel) == 255) {
+                QCOMPARE(pixel, qRgb(255, 0, 0));
+                ++opaquePixels;
+            }
+        }
+    }
+    QVERIFY(opaquePixels > 0);
+
+    // The color is part of the cache key, the blue icon must not reuse the red pixmap
+    auto blueImage = blue.pixmap(QSize(32, 32)).toImage().convertToFormat(QImage::Format_ARGB32);
+    QVERIFY(blueImage != image);
+}
+
+void TestGuiPixmaps::benchmarkIconScroll()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    // Similar to the health report: recolored quality icons on every row
+    const QStringList names = {"lock-open-alert", "lock-open", "lock", "lock-question"};
+    const QList<QColor> colors = {Qt::red, QColor(255, 128, 0), Qt::yellow, Qt::green};
+    QStandardItemModel model(10000, 2);
+    for (int row = 0; row < model.rowCount(); ++row) {
+        auto item = new QStandardItem(icons()->icon(names.at(row % names.size()), true, colors.at(row % colors.size())),
+                                      QString("Entry %1").arg(row));
+        model.setItem(row, 0, item);
+        model.setItem(row, 1, new QStandardItem(icons()->icon("entry-edit"), QString("Row %1").arg(row)));
+    }
+
+    QTableView view;
+    view.setModel(&model);
+    view.resize(800, 600);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const int pageRows = qMax(1, view.viewport()->height() / qMax(1, view.rowHeight(0)));
+    QBENCHMARK
+    {
+        for (int row = 0; row < model.rowCount(); row += pageRows) {
+            view.scrollTo(model.index(row, 0), QAbstractItemView::PositionAtTop);
+            view.viewport()->repaint();
+        }
+    };
+}
+
 QTEST_MAIN(TestGuiPixmaps)
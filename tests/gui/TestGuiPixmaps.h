@@ -29,6 +29,8 @@ private slots:
     void testDatabaseIcons();
     void testEntryIcons();
     void testGroupIcons();
+    void testRecoloredIcons();
+    void benchmarkIconScroll();
 };
 
 #endif // KEEPASSX_TESTGUIPIXMAPS_H